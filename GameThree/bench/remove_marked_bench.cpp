@@ -0,0 +1,135 @@
+/**
+ * @file remove_marked_bench.cpp
+ * @brief Scene 移除标记对象的基准测试：逐个 erase（旧实现）与一次性原地压缩（Scene::removeMarkedGameObjects）对比。
+ *
+ * 独立的源文件，不属于 GameThree 项目，不依赖引擎和第三方库。两种实现逐行对应 Scene::update 的新旧代码，
+ * 游戏对象用只带删除标记和一点数据的结构体代替（回收即销毁，两种实现的销毁开销相同）。
+ *
+ * 构建与运行（参数均可省略：对象数 10000，每帧删除比例 0.1，帧数 200）：
+ *   g++ -std=c++20 -O2 GameThree/bench/remove_marked_bench.cpp -o remove_marked_bench && ./remove_marked_bench
+ *   cl /std:c++20 /O2 /EHsc GameThree\bench\remove_marked_bench.cpp && remove_marked_bench.exe 10000 0.1 200
+ *
+ * 每帧先重建对象容器并随机标记（固定随机种子，不计时），再分别计时两种实现的一次更新循环，
+ * 并检查两者剩余对象的顺序一致。
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// @brief 游戏对象的替身：删除标记 + 更新时修改的数据
+    struct BenchObject {
+        int id = 0;
+        bool need_remove = false;
+        float position[2] = {};
+        void update(float delta_time) { position[0] += delta_time; position[1] += delta_time; }
+    };
+
+    using Objects = std::vector<std::unique_ptr<BenchObject>>;
+
+    void retire(std::unique_ptr<BenchObject>&& object) { object.reset(); }
+
+    /// @brief 旧实现：更新循环中逐个 erase 标记删除的对象（每次 erase 搬移其后的所有元素）
+    void updateEraseInLoop(Objects& objects, float delta_time) {
+        for (auto it = objects.begin(); it != objects.end();) {
+            if (*it && !(*it)->need_remove) {
+                (*it)->update(delta_time);
+                ++it;
+            }
+            else {
+                retire(std::move(*it));
+                it = objects.erase(it);
+            }
+        }
+    }
+
+    /// @brief 新实现：更新开始时一次原地压缩（保持顺序），再更新剩余对象
+    void updateCompact(Objects& objects, float delta_time) {
+        auto write = objects.begin();
+        for (auto read = objects.begin(); read != objects.end(); ++read) {
+            if (*read && !(*read)->need_remove) {
+                if (write != read) *write = std::move(*read);
+                ++write;
+            }
+            else {
+                retire(std::move(*read));
+            }
+        }
+        objects.erase(write, objects.end());
+
+        for (auto& object : objects) {
+            if (object && !object->need_remove) object->update(delta_time);
+        }
+    }
+
+    /// @brief 创建 count 个对象，按 marked 标记删除
+    Objects makeObjects(const std::vector<bool>& marked) {
+        Objects objects;
+        objects.reserve(marked.size());
+        for (std::size_t i = 0; i < marked.size(); ++i) {
+            auto object = std::make_unique<BenchObject>();
+            object->id = static_cast<int>(i);
+            object->need_remove = marked[i];
+            objects.push_back(std::move(object));
+        }
+        return objects;
+    }
+
+    std::vector<int> survivorIds(const Objects& objects) {
+        std::vector<int> ids;
+        ids.reserve(objects.size());
+        for (const auto& object : objects) ids.push_back(object->id);
+        return ids;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t object_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const double remove_ratio = argc > 2 ? std::strtod(argv[2], nullptr) : 0.1;
+    const int frames = argc > 3 ? std::atoi(argv[3]) : 200;
+    if (object_count == 0 || remove_ratio < 0.0 || remove_ratio > 1.0 || frames <= 0) {
+        std::fprintf(stderr, "用法: remove_marked_bench [对象数] [删除比例 0~1] [帧数]\n");
+        return 1;
+    }
+
+    std::mt19937 rng(12345);
+    const auto remove_count = static_cast<std::size_t>(static_cast<double>(object_count) * remove_ratio);
+    std::vector<std::size_t> order(object_count);
+    std::iota(order.begin(), order.end(), std::size_t{ 0 });
+
+    using clock = std::chrono::steady_clock;
+    std::chrono::duration<double, std::milli> erase_total{}, compact_total{};
+    for (int frame = 0; frame < frames; ++frame) {
+        // 每帧随机选择 remove_count 个对象标记删除（分散在容器各处）
+        std::shuffle(order.begin(), order.end(), rng);
+        std::vector<bool> marked(object_count, false);
+        for (std::size_t i = 0; i < remove_count; ++i) marked[order[i]] = true;
+
+        auto erase_objects = makeObjects(marked);
+        auto start = clock::now();
+        updateEraseInLoop(erase_objects, 0.016f);
+        erase_total += clock::now() - start;
+
+        auto compact_objects = makeObjects(marked);
+        start = clock::now();
+        updateCompact(compact_objects, 0.016f);
+        compact_total += clock::now() - start;
+
+        if (survivorIds(erase_objects) != survivorIds(compact_objects)) {
+            std::fprintf(stderr, "第 %d 帧：两种实现剩余对象的顺序不一致\n", frame);
+            return 1;
+        }
+    }
+
+    std::printf("对象数 %zu，每帧删除 %zu 个，共 %d 帧\n", object_count, remove_count, frames);
+    std::printf("逐个 erase：%.3f ms/帧\n", erase_total.count() / frames);
+    std::printf("原地压缩：  %.3f ms/帧\n", compact_total.count() / frames);
+    return 0;
+}
@@ -6,6 +6,10 @@
 
 namespace engine::component {
 
+    AnimationComponent::AnimationComponent(const engine::render::AnimationSet* animation_set)
+        : animation_set_(animation_set) {
+    }
+
     AnimationComponent::~AnimationComponent() = default;
 
     void AnimationComponent::init() {
@@ -13,28 +17,27 @@ namespace engine::component {
             spdlog::error("AnimationComponent 没有所有者 GameObject！");
             return;
         }
-        sprite_component_ = owner_->getComponent<SpriteComponent>();
-        if (!sprite_component_) {
+        if (!owner_->hasComponent<SpriteComponent>()) {
             spdlog::error("GameObject '{}' 的 AnimationComponent 需要 SpriteComponent，但未找到。", owner_->getName());
             return;
         }
     }
 
-    void AnimationComponent::update(float delta_time, engine::core::Context&) {
-        // 如果没有正在播放的动画，或者没有当前动画，或者没有精灵组件，或者当前动画没有帧，则直接返回
-        if (!is_playing_ || !current_animation_ || !sprite_component_ || current_animation_->isEmpty()) {
-            spdlog::trace("AnimationComponent 更新时没有正在播放的动画或精灵组件为空。");
+    void AnimationComponent::advance(float delta_time, SpriteComponent& sprite) {
+        // 如果没有正在播放的动画，或者没有当前动画，或者当前动画没有帧，则直接返回
+        if (!is_playing_ || !current_animation_ || current_animation_->isEmpty()) {
             return;
         }
 
         // 推进计时器
         animation_timer_ += delta_time;
 
-        // 根据时间获取当前帧
-        const auto& current_frame = current_animation_->getFrame(animation_timer_);
-
-        // 更新精灵组件的源矩形 (使用 SpriteComponent 的新方法)
-        sprite_component_->setSourceRect(current_frame.source_rect);
+        // 根据时间获取当前帧下标，只有切换到新的帧时才更新精灵组件的源矩形
+        auto frame_index = current_animation_->getFrameIndex(animation_timer_);
+        if (frame_index != current_frame_index_) {
+            current_frame_index_ = frame_index;
+            sprite.setSourceRect(current_animation_->getFrames()[frame_index].source_rect);
+        }
 
         // 检查非循环动画是否已结束
         if (!current_animation_->isLooping() && animation_timer_ >= current_animation_->getTotalDuration()) {
@@ -46,16 +49,21 @@ namespace engine::component {
         }
     }
 
-    void AnimationComponent::addAnimation(std::unique_ptr<engine::render::Animation> animation) {
-        if (!animation) return;
-        std::string name = animation->getName();    // 获取名称
-        animations_[name] = std::move(animation);
-        spdlog::debug("已将动画 '{}' 添加到 GameObject '{}'", name, owner_ ? owner_->getName() : "未知");
+    void AnimationComponent::setAnimationSet(const engine::render::AnimationSet* animation_set) {
+        animation_set_ = animation_set;
+        current_animation_ = nullptr;
+        animation_timer_ = 0.0f;
+        current_frame_index_ = 0;
+        is_playing_ = false;
     }
 
     void AnimationComponent::playAnimation(const std::string& name) {
-        auto it = animations_.find(name);
-        if (it == animations_.end() || !it->second) {
+        if (!animation_set_) {
+            spdlog::warn("GameObject '{}' 的 AnimationComponent 没有动画集，无法播放动画 '{}'", owner_ ? owner_->getName() : "未知", name);
+            return;
+        }
+        auto it = animation_set_->find(name);
+        if (it == animation_set_->end() || !it->second) {
             spdlog::warn("未找到 GameObject '{}' 的动画 '{}'", name, owner_ ? owner_->getName() : "未知");
             return;
         }
@@ -67,12 +75,14 @@ namespace engine::component {
 
         current_animation_ = it->second.get();
         animation_timer_ = 0.0f;
+        current_frame_index_ = 0;
         is_playing_ = true;
 
         // 立即将精灵更新到第一帧
-        if (sprite_component_ && !current_animation_->isEmpty()) {
+        auto* sprite = owner_ ? owner_->getComponent<SpriteComponent>() : nullptr;
+        if (sprite && !current_animation_->isEmpty()) {
             const auto& first_frame = current_animation_->getFrame(0.0f);
-            sprite_component_->setSourceRect(first_frame.source_rect);
+            sprite->setSourceRect(first_frame.source_rect);
             spdlog::debug("GameObject '{}' 播放动画 '{}'", owner_ ? owner_->getName() : "未知", name);
         }
     }
@@ -1,12 +1,8 @@
 #pragma once
 #include "./component.h"
+#include "../render/animation_library.h"
+#include <cstddef>
 #include <string>
-#include <unordered_map>
-#include <memory>
-
-namespace engine::render {
-    class Animation;
-}
 namespace engine::component {
     class SpriteComponent;
 }
@@ -16,32 +12,44 @@ namespace engine::component {
     /**
      * @brief GameObject的动画组件。
      *
-     * 持有一组Animation对象并控制其播放，
-     * 根据当前帧更新关联的SpriteComponent。
+     * 引用共享动画库中的动画集（不可变，同类对象共用），自身只保存播放状态，
+     * 根据当前帧更新同一对象的SpriteComponent（每次使用时查找，紧密存储的组件会被搬移）。
      */
-    class AnimationComponent : public Component {
+    class AnimationComponent final : public Component {
         friend class engine::object::GameObject;
+    public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::ANIMATION;   ///< @brief 固定的组件类型ID（见 component_type）
+        static constexpr bool PACKED = true;    ///< @brief 按值紧密存储在原型中（见 Component::PACKED）
+
     private:
-        /// @brief 动画名称到Animation对象的映射。
-        std::unordered_map<std::string, std::unique_ptr<engine::render::Animation>> animations_;
-        SpriteComponent* sprite_component_ = nullptr;               ///< @brief 指向必需的SpriteComponent的指针
-        engine::render::Animation* current_animation_ = nullptr;    ///< @brief 指向当前播放动画的原始指针
+        const engine::render::AnimationSet* animation_set_ = nullptr;   ///< @brief 共享的动画集（由 AnimationLibrary 持有，只读）
+        const engine::render::Animation* current_animation_ = nullptr;  ///< @brief 当前播放的动画片段
 
         float animation_timer_ = 0.0f;          ///< @brief 动画播放中的计时器
+        std::size_t current_frame_index_ = 0;   ///< @brief 当前显示的帧下标
         bool is_playing_ = false;               ///< @brief 当前是否有动画正在播放
-        bool is_one_shot_removal_ = false;      ///< @brief 是否在动画结束后删除整个GameObject
+        bool is_one_shot_removal_ = false;      ///< @brief 是否在动画结束后删除整个GameObject（池对象则由场景放回对象池）
 
     public:
-        AnimationComponent() = default;
+        explicit AnimationComponent(const engine::render::AnimationSet* animation_set = nullptr);
         ~AnimationComponent() override;
 
-        // 删除复制/移动操作
+        // 删除复制/赋值操作
         AnimationComponent(const AnimationComponent&) = delete;
         AnimationComponent& operator=(const AnimationComponent&) = delete;
-        AnimationComponent(AnimationComponent&&) = delete;
+        AnimationComponent(AnimationComponent&&) noexcept = default;  ///< @brief 紧密存储在原型数组中，需要移动构造（所有者不变）
         AnimationComponent& operator=(AnimationComponent&&) = delete;
 
-        void addAnimation(std::unique_ptr<engine::render::Animation> animation);    ///< @brief 向 animations_ map容器中添加一个动画。
+        void setAnimationSet(const engine::render::AnimationSet* animation_set);   ///< @brief 设置共享动画集（停止当前播放）
+
+        /**
+         * @brief 推进动画播放（由场景每帧对所有动画组件批量调用一次，见 Scene::update）。
+         * @details 只有帧下标改变时才更新 SpriteComponent 的源矩形。
+         * @param delta_time 帧间隔（秒）
+         * @param sprite 同一对象的精灵组件（由场景从原型中按行取出）
+         */
+        void advance(float delta_time, SpriteComponent& sprite);
+
         void playAnimation(const std::string& name);    ///< @brief 播放指定名称的动画。
         void stopAnimation() { is_playing_ = false; }   ///< @brief 停止当前动画播放。
         void resumeAnimation() { is_playing_ = true; }   ///< @brief 恢复当前动画播放。
@@ -49,6 +57,8 @@ namespace engine::component {
         // --- Getters and Setters ---
         std::string getCurrentAnimationName() const;
         bool isPlaying() const { return is_playing_; }
+        std::size_t getCurrentFrameIndex() const { return current_frame_index_; }
+        const engine::render::AnimationSet* getAnimationSet() const { return animation_set_; }
         bool isAnimationFinished() const;
         bool isOneShotRemoval() const { return is_one_shot_removal_; }
         void setOneShotRemoval(bool is_one_shot_removal) { is_one_shot_removal_ = is_one_shot_removal; }
@@ -56,7 +66,7 @@ namespace engine::component {
     protected:
         // 核心循环方法
         void init() override;
-        void update(float, engine::core::Context&) override;
+        void update(float, engine::core::Context&) override {}    ///< @brief 不在这里推进，由场景批量调用 advance()
     };
 
 } // namespace engine::component
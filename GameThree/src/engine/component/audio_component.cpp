@@ -21,8 +21,7 @@ namespace engine::component {
             spdlog::error("AudioComponent 没有所有者 GameObject！");
             return;
         }
-        transform_ = owner_->getComponent<TransformComponent>();
-        if (!transform_) {
+        if (!owner_->hasComponent<TransformComponent>()) {
             spdlog::warn("AudioComponent 所在的 GameObject 上没有 TransformComponent！，无法进行空间定位");
         }
     }
@@ -32,11 +31,12 @@ namespace engine::component {
         // 如果 sound_id 是音效 ID，则在查找在map中查找对应的路径； 没找到的话则把 sound_id 当作路径直接使用
         auto sound_path = sound_id_to_path_.find(sound_id) != sound_id_to_path_.end() ? sound_id_to_path_[sound_id] : sound_id;
 
-        if (use_spatial && transform_) {    // 使用空间定位
+        const auto* transform = owner_ ? owner_->getComponent<TransformComponent>() : nullptr;
+        if (use_spatial && transform) {    // 使用空间定位
             // TODO: (SDL_Mixer 不支持空间定位，未来更换音频库时可以方便地实现)
                     // 这里给一个简单的功能：150像素范围内播放，否则不播放
             auto camera_center = camera_->getPosition() + camera_->getViewportSize() / 2.0f; // 相机中心
-            auto object_pos = transform_->getPosition();
+            auto object_pos = transform->getPosition();
             float distance = glm::length(camera_center - object_pos);
             if (distance > 150.0f) {
                 spdlog::debug("AudioComponent::playSound: 音效 '{}' 超出范围，不播放。", sound_id);
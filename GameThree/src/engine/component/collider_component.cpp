@@ -26,27 +26,31 @@ namespace engine::component {
             spdlog::error("ColliderComponent 没有所有者 GameObject！");
             return;
         }
-        transform_ = owner_->getComponent<TransformComponent>();
-        if (!transform_) {
+        if (!getTransform()) {
             spdlog::error("ColliderComponent 需要一个在同一个 GameObject 上的 TransformComponent！");
             return;
         }
 
-        // 在获取 transform_ 之后计算初始偏移量
+        // 确认有 TransformComponent 之后计算初始偏移量
         updateOffset();
     }
 
     // 实现 setAlignment 方法
     void ColliderComponent::setAlignment(engine::utils::Alignment anchor) {
         alignment_ = anchor;
-        // 重新计算偏移量，确保 transform_ 和 collider_ 有效
-        if (transform_ && collider_) {
+        // 重新计算偏移量，确保 TransformComponent 和 collider_ 有效
+        if (getTransform() && collider_) {
             updateOffset();
         }
     }
 
+    TransformComponent* ColliderComponent::getTransform() const {
+        return owner_ ? owner_->getComponent<TransformComponent>() : nullptr;
+    }
+
     void ColliderComponent::updateOffset() {
-        if (!collider_) return;
+        const auto* transform = getTransform();
+        if (!collider_ || !transform) return;
 
         // 获取碰撞盒的最小包围盒尺寸
         auto collider_size = collider_->getAABBSize();
@@ -56,7 +60,7 @@ namespace engine::component {
             offset_ = { 0.0f, 0.0f };
             return;
         }
-        auto scale = transform_->getScale();
+        auto scale = transform->getScale();
 
         // 根据 alignment_anchor_ 计算 AABB 左上角相对于 Transform 中心的偏移量
         switch (alignment_) {
@@ -93,14 +97,15 @@ namespace engine::component {
     }
 
     engine::utils::Rect ColliderComponent::getWorldAABB() const {
-        if (!transform_ || !collider_) {
+        const auto* transform = getTransform();
+        if (!transform || !collider_) {
             return { glm::vec2(0.0f, 0.0f), glm::vec2(0.0f, 0.0f) };
         }
         // 计算最小包围盒的左上角坐标（position）
-        const glm::vec2 top_left_pos = transform_->getPosition() + offset_;
+        const glm::vec2 top_left_pos = transform->getPosition() + offset_;
         // 计算最小包围盒的尺寸（size）
         const glm::vec2 base_size = collider_->getAABBSize();
-        const glm::vec2 scale = transform_->getScale();
+        const glm::vec2 scale = transform->getScale();
         glm::vec2 scaled_size = base_size * scale;
         // 返回最小包围盒的 Rect
         return { top_left_pos, scaled_size };
@@ -19,9 +19,11 @@ namespace engine::component {
      */
     class ColliderComponent final : public Component {
         friend class engine::object::GameObject;
-    private:
-        TransformComponent* transform_ = nullptr;               ///< @brief 缓存的 TransformComponent 指针 (非拥有)
+    public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::COLLIDER;   ///< @brief 固定的组件类型ID（见 component_type）
+        static constexpr bool PACKED = true;    ///< @brief 按值紧密存储在原型中（见 Component::PACKED）
 
+    private:
         std::unique_ptr<engine::physics::Collider> collider_;   ///< @brief 拥有的碰撞器对象。
         glm::vec2 offset_ = { 0.0f, 0.0f };                       ///< @brief 碰撞器(最小包围盒的)左上角相对于变换原点的偏移量。
         engine::utils::Alignment alignment_ = engine::utils::Alignment::NONE;   ///< @brief 对齐方式。
@@ -51,7 +53,7 @@ namespace engine::component {
         void updateOffset();
 
         // --- Getters ---
-        TransformComponent* getTransform() const { return transform_; }               ///< @brief 获取缓存的TransformComponent
+        TransformComponent* getTransform() const;                                           ///< @brief 获取同一对象的TransformComponent（不缓存指针）
         const engine::physics::Collider* getCollider() const { return collider_.get(); }    ///< @brief 获取 Collider 对象。
         const glm::vec2& getOffset() const { return offset_; }                              ///< @brief 获取当前计算出的偏移量。
         engine::utils::Alignment getAlignment() const { return alignment_; }                ///< @brief 获取设置的对齐锚点。
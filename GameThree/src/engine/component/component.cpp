@@ -0,0 +1,48 @@
+#include "component.h"
+#include "../object/object_arena.h"
+#include <array>
+#include <mutex>
+#include <spdlog/spdlog.h>
+
+namespace engine::component {
+
+    namespace detail {
+        bool registerComponentType(ComponentTypeId type_id, const std::type_info& type)
+        {
+            static std::mutex mutex;
+            static std::array<const std::type_info*, MAX_COMPONENT_TYPES> registered{};
+            std::lock_guard lock(mutex);
+            auto& entry = registered[type_id];
+            if (!entry) {
+                entry = &type;
+                return true;
+            }
+            if (*entry != type) {
+                spdlog::error("组件类型ID {} 被 {} 和 {} 重复使用，两者会占用同一个组件槽位。", type_id, entry->name(), type.name());
+                return false;
+            }
+            return true;
+        }
+    }
+
+    void* Component::operator new(std::size_t size)
+    {
+        return engine::object::ObjectArena::allocateBlock(size, engine::object::ObjectArena::current());
+    }
+
+    void* Component::operator new(std::size_t size, engine::object::ObjectArena* arena)
+    {
+        return engine::object::ObjectArena::allocateBlock(size, arena);
+    }
+
+    void Component::operator delete(void* ptr) noexcept
+    {
+        engine::object::ObjectArena::deallocateBlock(ptr);
+    }
+
+    void Component::operator delete(void* ptr, engine::object::ObjectArena*) noexcept
+    {
+        engine::object::ObjectArena::deallocateBlock(ptr);
+    }
+
+} // namespace engine::component
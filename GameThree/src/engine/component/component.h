@@ -1,7 +1,13 @@
 #pragma once
+#include <cstddef>
+#include <new>
+#include <cstdint>
+#include <typeinfo>
+
 // 前置声明
 namespace engine::object {
     class GameObject;
+    class ObjectArena;
 }
 
 namespace engine::core {
@@ -10,6 +16,47 @@ namespace engine::core {
 
 namespace engine::component {
 
+    /// @brief 组件类型ID，用作 GameObject 组件槽位数组的下标
+    using ComponentTypeId = std::size_t;
+    /// @brief 组件类型数量上限（GameObject 用一个 32 位掩码记录已有组件）
+    inline constexpr ComponentTypeId MAX_COMPONENT_TYPES = 32;
+
+    /**
+     * @brief 组件的固定类型ID。
+     *
+     * 类型ID决定组件在 GameObject 中的槽位，也决定同一对象内各组件的更新和渲染顺序（ID 小的先执行），
+     * 因此这里按依赖顺序固定编号，与组件首次使用的先后无关，每次运行都相同。
+     * 游戏层组件从 FIRST_GAME 开始编号（见各游戏组件的 TYPE_ID）。
+     */
+    namespace component_type {
+        inline constexpr ComponentTypeId TRANSFORM = 0;     ///< @brief TransformComponent
+        inline constexpr ComponentTypeId PARALLAX = 1;      ///< @brief ParallaxComponent
+        inline constexpr ComponentTypeId TILE_LAYER = 2;    ///< @brief TileLayerComponent
+        inline constexpr ComponentTypeId SPRITE = 3;        ///< @brief SpriteComponent
+        inline constexpr ComponentTypeId ANIMATION = 4;     ///< @brief AnimationComponent
+        inline constexpr ComponentTypeId COLLIDER = 5;      ///< @brief ColliderComponent
+        inline constexpr ComponentTypeId PHYSICS = 6;       ///< @brief PhysicsComponent
+        inline constexpr ComponentTypeId HEALTH = 7;        ///< @brief HealthComponent
+        inline constexpr ComponentTypeId AUDIO = 8;         ///< @brief AudioComponent
+        inline constexpr ComponentTypeId FIRST_GAME = 16;   ///< @brief 游戏层组件的起始ID
+    }
+
+    namespace detail {
+        /// @brief 登记组件类型ID（每个类型首次添加时调用一次），两个类型使用同一ID时报告错误
+        bool registerComponentType(ComponentTypeId type_id, const std::type_info& type);
+    }
+
+    /**
+     * @brief 获取组件类型 T 的类型ID（即 T::TYPE_ID，编译期常量）。
+     * @tparam T 组件类型（须声明 static constexpr ComponentTypeId TYPE_ID）
+     * @return ComponentTypeId 组件类型ID
+     */
+    template <typename T>
+    constexpr ComponentTypeId getComponentTypeId() {
+        static_assert(T::TYPE_ID < MAX_COMPONENT_TYPES, "组件类型ID超过上限 MAX_COMPONENT_TYPES");
+        return T::TYPE_ID;
+    }
+
     /**
      * @brief 组件的抽象基类。
      *
@@ -23,19 +70,34 @@ namespace engine::component {
         engine::object::GameObject* owner_ = nullptr;   ///< @brief 指向拥有此组件的 GameObject
 
     public:
+        /**
+         * @brief 是否按值紧密存储在原型中（见 engine::object::ArchetypeRegistry）。
+         * @details 每帧被批量遍历的组件（变换、精灵、动画、碰撞器、物理）声明 PACKED = true，
+         *          对象登记到场景后，这些组件按值存放在所属原型的数组中，对象改变组件组合或离开场景时会被搬移。
+         *          因此不要跨帧（或跨组件增删）保存紧密存储组件的指针，需要时通过 GameObject::getComponent 获取。
+         */
+        static constexpr bool PACKED = false;
+
         Component() = default;
         virtual ~Component() = default;         ///< @brief 虚析构函数确保正确清理派生类
 
-        // 禁止拷贝和移动，组件通常不应被拷贝或移动（更改owner_就相当于移动）
+        // 禁止拷贝和赋值（更改owner_就相当于移动）
         Component(const Component&) = delete;
         Component& operator=(const Component&) = delete;
-        Component(Component&&) = delete;
         Component& operator=(Component&&) = delete;
 
+        // 组件内存从场景内存池分配（见 engine::object::ObjectArena），GameObject::addComponent 使用带内存池参数的版本
+        static void* operator new(std::size_t size);
+        static void* operator new(std::size_t size, engine::object::ObjectArena* arena);
+        static void operator delete(void* ptr) noexcept;
+        static void operator delete(void* ptr, engine::object::ObjectArena* arena) noexcept;   ///< @brief 构造抛出异常时使用
+
         void setOwner(engine::object::GameObject* owner) { owner_ = owner; }    ///< @brief 设置拥有此组件的 GameObject
         engine::object::GameObject* getOwner() const { return owner_; }         ///< @brief 获取拥有此组件的 GameObject
 
     protected:
+        Component(Component&&) noexcept = default;  ///< @brief 只供紧密存储的组件在原型数组中搬移（所有者不变）
+
         // 关键循环函数，全部设为保护，只有 GameObject 需要（可以）调用
         virtual void init() {}                      ///< @brief 保留两段初始化的机制，GameObject 添加组件时自动调用，不需要外部调用
         virtual void handleInput(engine::core::Context&) {}                 ///< @brief 处理输入
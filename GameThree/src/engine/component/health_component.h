@@ -8,6 +8,9 @@ namespace engine::component {
      */
     class HealthComponent final : public engine::component::Component {
         friend class engine::object::GameObject;
+    public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::HEALTH;   ///< @brief 固定的组件类型ID（见 component_type）
+
     private:
         int max_health_ = 1;                    ///< @brief 最大生命值
         int current_health_ = 1;                ///< @brief 当前生命值
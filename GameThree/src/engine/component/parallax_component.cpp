@@ -22,19 +22,19 @@ namespace engine::component {
             spdlog::error("ParallaxComponent 初始化时，GameObject 为空。");
             return;
         }
-        transform_ = owner_->getComponent<TransformComponent>();
-        if (!transform_) {
+        if (!owner_->hasComponent<TransformComponent>()) {
             spdlog::error("ParallaxComponent 初始化时，GameObject 上没有找到 TransformComponent 组件。");
             return;
         }
     }
 
     void ParallaxComponent::render(engine::core::Context& context) {
-        if (is_hidden_ || !transform_) {
+        const auto* transform = owner_ ? owner_->getComponent<TransformComponent>() : nullptr;
+        if (is_hidden_ || !transform) {
             return;
         }
         // 直接调用视差滚动绘制函数
-        context.getRenderer().drawParallax(context.getCamera(), sprite_, transform_->getPosition(), scroll_factor_, repeat_, transform_->getScale());
+        context.getRenderer().drawParallax(context.getCamera(), sprite_, transform->getPosition(), scroll_factor_, repeat_, transform->getScale());
     }
 
 } // namespace engine::component 
\ No newline at end of file
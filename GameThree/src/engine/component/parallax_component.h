@@ -14,9 +14,10 @@ namespace engine::component {
      */
     class ParallaxComponent final : public Component {
         friend class engine::object::GameObject;
-    private:
-        TransformComponent* transform_ = nullptr;   ///< @brief 缓存变换组件
+    public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::PARALLAX;   ///< @brief 固定的组件类型ID（见 component_type）
 
+    private:
         engine::render::Sprite sprite_;             ///< @brief 精灵对象
         glm::vec2 scroll_factor_;                   ///< @brief 滚动速度因子 (0=静止, 1=随相机移动, <1=比相机慢)
         glm::bvec2 repeat_;                         ///< @brief 是否沿着X和Y轴周期性重复
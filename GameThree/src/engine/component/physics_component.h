@@ -2,27 +2,23 @@
 #include "component.h"
 #include "glm/vec2.hpp"
 
-namespace engine::physics {
-    class PhysicsEngine;
-}
-
 namespace engine::component {
     class TransformComponent;
 
     /**
      * @brief 管理GameObject的物理属性
      *
-     * 存储速度、质量、力和重力设置。与PhysicsEngine交互。
+     * 存储速度、质量、力和重力设置。PhysicsEngine 每帧遍历场景原型中的物理组件进行模拟。
      */
     class PhysicsComponent final : public Component {
         friend class engine::object::GameObject;
     public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::PHYSICS;   ///< @brief 固定的组件类型ID（见 component_type）
+        static constexpr bool PACKED = true;    ///< @brief 按值紧密存储在原型中（见 Component::PACKED）
+
         glm::vec2 velocity_ = { 0.0f, 0.0f };             ///< @brief 物体的速度，设为公共成员变量，方便PhysicsEngine访问更新
 
     private:
-        engine::physics::PhysicsEngine* physics_engine_ = nullptr;  ///< @brief 指向PhysicsEngine的指针
-        TransformComponent* transform_ = nullptr;                   ///< @brief TransformComponent的缓存指针
-
         glm::vec2 force_ = { 0.0f, 0.0f };                            ///< @brief 当前帧受到的力
         float mass_ = 1.0f;                             ///< @brief 物体质量（默认1.0）
         bool use_gravity_ = true;                       ///< @brief 物体是否受重力影响
@@ -40,17 +36,16 @@ namespace engine::component {
         /**
          * @brief 构造函数
          *
-         * @param physics_engine 指向PhysicsEngine的指针，不能为nullptr
          * @param use_gravity 物体是否受重力影响，默认true
          * @param mass 物体质量，默认1.0
          */
-        PhysicsComponent(engine::physics::PhysicsEngine* physics_engine, bool use_gravity = true, float mass = 1.0f);
+        explicit PhysicsComponent(bool use_gravity = true, float mass = 1.0f);
         ~PhysicsComponent() override = default;
 
-        // 删除复制/移动操作
+        // 删除复制/赋值操作
         PhysicsComponent(const PhysicsComponent&) = delete;
         PhysicsComponent& operator=(const PhysicsComponent&) = delete;
-        PhysicsComponent(PhysicsComponent&&) = delete;
+        PhysicsComponent(PhysicsComponent&&) noexcept = default;  ///< @brief 紧密存储在原型数组中，需要移动构造（所有者不变）
         PhysicsComponent& operator=(PhysicsComponent&&) = delete;
 
         // PhysicsEngine使用的物理方法
@@ -67,7 +62,7 @@ namespace engine::component {
         void setUseGravity(bool use_gravity) { use_gravity_ = use_gravity; }        ///< @brief 设置组件是否受重力影响
         void setVelocity(const glm::vec2& velocity) { velocity_ = velocity; }       ///< @brief 设置速度
         const glm::vec2& getVelocity() const { return velocity_; }                  ///< @brief 获取当前速度
-        TransformComponent* getTransform() const { return transform_; }             ///< @brief 获取TransformComponent指针
+        TransformComponent* getTransform() const;                                   ///< @brief 获取同一对象的TransformComponent（不缓存指针）
 
         // --- 碰撞状态访问与修改 (供 PhysicsEngine 使用) ---
         /** @brief 重置所有碰撞标志 (在物理更新开始时调用) */
@@ -98,7 +93,6 @@ namespace engine::component {
         // 核心循环方法
         void init() override;
         void update(float, engine::core::Context&) override {}
-        void clean() override;
     };
 
 } // namespace engine::component
\ No newline at end of file
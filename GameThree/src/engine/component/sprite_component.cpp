@@ -43,8 +43,7 @@ namespace engine::component {
             spdlog::error("SpriteComponent 在初始化前未设置所有者。");
             return;
         }
-        transform_ = owner_->getComponent<TransformComponent>();
-        if (!transform_) {
+        if (!getTransform()) {
             spdlog::warn(
                 "GameObject '{}' 上的 SpriteComponent 需要一个 TransformComponent，但未找到。",
                 owner_->getName()
@@ -64,12 +63,13 @@ namespace engine::component {
     }
 
     void SpriteComponent::updateOffset() {
-        // 如果尺寸无效，偏移为0
-        if (sprite_size_.x <= 0 || sprite_size_.y <= 0) {
+        // 如果尺寸无效（或没有变换组件），偏移为0
+        const auto* transform = getTransform();
+        if (sprite_size_.x <= 0 || sprite_size_.y <= 0 || !transform) {
             offset_ = { 0.0f, 0.0f };
             return;
         }
-        auto scale = transform_->getScale();
+        auto scale = transform->getScale();
         // 计算精灵左上角相对于 TransformComponent::position_ 的偏移
         switch (alignment_) {
         case engine::utils::Alignment::TOP_LEFT:      offset_ = glm::vec2{ 0.0f, 0.0f } *scale; break;
@@ -87,14 +87,15 @@ namespace engine::component {
     }
 
     void SpriteComponent::render(engine::core::Context& context) {
-        if (is_hidden_ || !transform_ || !resource_manager_) {
+        const auto* transform = getTransform();
+        if (is_hidden_ || !transform || !resource_manager_) {
             return;
         }
 
         // 获取变换信息（考虑偏移量）
-        const glm::vec2& pos = transform_->getPosition() + offset_;
-        const glm::vec2& scale = transform_->getScale();
-        float rotation_degrees = transform_->getRotation();
+        const glm::vec2& pos = transform->getPosition() + offset_;
+        const glm::vec2& scale = transform->getScale();
+        float rotation_degrees = transform->getRotation();
 
         // 执行绘制
         context.getRenderer().drawSprite(context.getCamera(), sprite_, pos, scale, rotation_degrees);
@@ -114,6 +115,10 @@ namespace engine::component {
         updateOffset();
     }
 
+    TransformComponent* SpriteComponent::getTransform() const {
+        return owner_ ? owner_->getComponent<TransformComponent>() : nullptr;
+    }
+
     void SpriteComponent::updateSpriteSize() {
         if (!resource_manager_) {
             spdlog::error("ResourceManager 为空！无法获取纹理尺寸。");
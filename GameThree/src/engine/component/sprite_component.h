@@ -25,9 +25,12 @@ namespace engine::component {
      */
     class SpriteComponent final : public engine::component::Component {
         friend class engine::object::GameObject;            // 友元不能继承，必须每个子类单独添加
+    public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::SPRITE;   ///< @brief 固定的组件类型ID（见 component_type）
+        static constexpr bool PACKED = true;    ///< @brief 按值紧密存储在原型中（见 Component::PACKED）
+
     private:
         engine::resource::ResourceManager* resource_manager_ = nullptr;         ///< @brief 保存资源管理器指针，用于获取纹理大小
-        TransformComponent* transform_ = nullptr;                               ///< @brief 缓存 TransformComponent 指针（非必须）
 
         engine::render::Sprite sprite_;                                         ///< @brief 精灵对象
         engine::utils::Alignment alignment_ = engine::utils::Alignment::NONE;   ///< @brief 对齐方式
@@ -66,10 +69,10 @@ namespace engine::component {
 
         ~SpriteComponent() override = default;
 
-        // 禁止拷贝和移动
+        // 禁止拷贝和赋值
         SpriteComponent(const SpriteComponent&) = delete;
         SpriteComponent& operator=(const SpriteComponent&) = delete;
-        SpriteComponent(SpriteComponent&&) = delete;
+        SpriteComponent(SpriteComponent&&) noexcept = default;  ///< @brief 紧密存储在原型数组中，需要移动构造（所有者不变）
         SpriteComponent& operator=(SpriteComponent&&) = delete;
 
         void updateOffset();           ///< @brief 更新偏移量(根据当前的 alignment_ 和 sprite_size_ 计算 offset_)。
@@ -92,6 +95,7 @@ namespace engine::component {
 
     private:
         void updateSpriteSize();        ///< @brief 辅助函数，根据 sprite_ 的 source_rect_ 更新 sprite_size_
+        TransformComponent* getTransform() const;   ///< @brief 获取同一对象的 TransformComponent（紧密存储的组件会被搬移，不缓存指针）
 
         // Component 虚函数覆盖
         void init() override;                                                   ///< @brief 初始化函数需要覆盖
@@ -5,20 +5,124 @@
 #include "../render/camera.h"
 #include "../physics/physics_engine.h"
 #include <spdlog/spdlog.h>
+#include <glm/common.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace engine::component {
 
-    TileLayerComponent::TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, std::vector<TileInfo>&& tiles)
+    // --- TileChunkMap ---
+
+    std::uint32_t TileChunkMap::addPaletteEntry(TileInfo tile)
+    {
+        palette_.push_back(std::move(tile));
+        return static_cast<std::uint32_t>(palette_.size() - 1);
+    }
+
+    void TileChunkMap::setTile(glm::ivec2 pos, std::uint32_t palette_index)
+    {
+        if (palette_index >= palette_.size() || palette_[palette_index].type == TileType::EMPTY) {
+            palette_index = 0;
+        }
+        const auto key = packKey(toChunkCoord(pos));
+        auto it = chunks_.find(key);
+        if (it == chunks_.end()) {
+            if (palette_index == 0) return;     // 空瓦片不需要分配块
+            it = chunks_.emplace(key, std::make_unique<Chunk>()).first;
+        }
+        auto& chunk = *it->second;
+        auto& slot = chunk.tiles[(pos.y & (CHUNK_SIZE - 1)) * CHUNK_SIZE + (pos.x & (CHUNK_SIZE - 1))];
+        if ((slot == 0) != (palette_index == 0)) {
+            chunk.tile_count += palette_index != 0 ? 1 : -1;
+        }
+        slot = palette_index;
+        if (chunk.tile_count == 0) {
+            chunks_.erase(it);
+            return;
+        }
+        if (palette_index != 0) {   // 只扩大包围盒（清空瓦片时不收缩，包围盒只用于确定地图尺寸和裁剪范围）
+            if (max_tile_.x < min_tile_.x) {
+                min_tile_ = max_tile_ = pos;
+            }
+            else {
+                min_tile_ = glm::min(min_tile_, pos);
+                max_tile_ = glm::max(max_tile_, pos);
+            }
+        }
+    }
+
+    const TileInfo* TileChunkMap::getTile(glm::ivec2 pos) const
+    {
+        const auto chunk_coord = toChunkCoord(pos);
+        const auto* chunk = findChunk(chunk_coord);
+        if (!chunk) {
+            if (unloaded_tile_ && !unloaded_chunks_.empty() && isChunkUnloaded(chunk_coord)) return &*unloaded_tile_;
+            return nullptr;
+        }
+        auto index = chunk->tiles[(pos.y & (CHUNK_SIZE - 1)) * CHUNK_SIZE + (pos.x & (CHUNK_SIZE - 1))];
+        return index != 0 ? &palette_[index] : nullptr;
+    }
+
+    const TileChunkMap::Chunk* TileChunkMap::findChunk(glm::ivec2 chunk_coord) const
+    {
+        auto it = chunks_.find(packKey(chunk_coord));
+        return it != chunks_.end() ? it->second.get() : nullptr;
+    }
+
+    void TileChunkMap::setChunk(glm::ivec2 chunk_coord, const std::uint32_t* indices)
+    {
+        const auto key = packKey(chunk_coord);
+        unloaded_chunks_.erase(key);
+        auto chunk = std::make_unique<Chunk>();
+        for (int i = 0; i < CHUNK_AREA; ++i) {
+            auto index = indices[i];
+            if (index == 0 || index >= palette_.size() || palette_[index].type == TileType::EMPTY) continue;
+            chunk->tiles[i] = index;
+            ++chunk->tile_count;
+        }
+        if (chunk->tile_count == 0) {       // 载入后发现是空块，不占内存
+            chunks_.erase(key);
+            return;
+        }
+        chunks_[key] = std::move(chunk);
+    }
+
+    void TileChunkMap::unloadChunk(glm::ivec2 chunk_coord)
+    {
+        const auto key = packKey(chunk_coord);
+        chunks_.erase(key);
+        // 包围盒扩展到整个块（地图尺寸和相机边界需要包含未载入的区域；载入时不必再扩展）
+        const glm::ivec2 origin = chunk_coord * CHUNK_SIZE;
+        if (unloaded_chunks_.insert(key).second) {
+            if (max_tile_.x < min_tile_.x) {
+                min_tile_ = origin;
+                max_tile_ = origin + (CHUNK_SIZE - 1);
+            }
+            else {
+                min_tile_ = glm::min(min_tile_, origin);
+                max_tile_ = glm::max(max_tile_, origin + (CHUNK_SIZE - 1));
+            }
+        }
+    }
+
+    // --- TileLayerComponent ---
+
+    TileLayerComponent::TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, TileChunkMap&& tiles)
         : tile_size_(tile_size),
         map_size_(map_size),
         tiles_(std::move(tiles))
     {
-        if (tiles_.size() != static_cast<size_t>(map_size_.x * map_size_.y)) {
-            spdlog::error("TileLayerComponent: 地图尺寸与提供的瓦片向量大小不匹配。瓦片数据将被清除。");
-            tiles_.clear();
-            map_size_ = { 0, 0 };
+        // 无限地图没有固定尺寸，使用从原点到瓦片包围盒右下角的范围
+        if (!tiles_.isEmpty()) {
+            map_size_ = glm::max(map_size_, tiles_.getMaxTile() + 1);
+        }
+        // 高于瓦片的图片（如树木）向上绘制，渲染裁剪时需要多检查下方的行
+        for (const auto& tile_info : tiles_.getPalette()) {
+            if (auto rect = tile_info.sprite.getSourceRect(); rect) {
+                max_overhang_ = std::max(max_overhang_, rect->h - static_cast<float>(tile_size_.y));
+            }
         }
-        spdlog::trace("TileLayerComponent 构造完成");
+        spdlog::trace("TileLayerComponent 构造完成（{} 个瓦片块）", tiles_.getChunkCount());
     }
 
     void TileLayerComponent::init() {
@@ -29,51 +133,90 @@ namespace engine::component {
     }
 
     void TileLayerComponent::render(engine::core::Context& context) {
-        if (tile_size_.x <= 0 || tile_size_.y <= 0) {
+        if (tile_size_.x <= 0 || tile_size_.y <= 0 || tiles_.isEmpty()) {
             return; // 防止除以零或无效尺寸
         }
-        // 遍历所有瓦片
-        for (int y = 0; y < map_size_.y; ++y) {
-            for (int x = 0; x < map_size_.x; ++x) {
-                size_t index = static_cast<size_t>(y) * map_size_.x + x;
-                // 检查索引有效性以及瓦片是否需要渲染
-                if (index < tiles_.size() && tiles_[index].type != TileType::EMPTY) {
-                    const auto& tile_info = tiles_[index];
-                    // 计算该瓦片在世界中的左上角位置 (drawSprite 预期接收左上角坐标)
-                    glm::vec2 tile_left_top_pos = {
-                        offset_.x + static_cast<float>(x) * tile_size_.x,
-                        offset_.y + static_cast<float>(y) * tile_size_.y
-                    };
-                    // 但如果图片的大小与瓦片的大小不一致，需要调整 y 坐标 (瓦片层的对齐点是左下角)
-                    if (static_cast<int>(tile_info.sprite.getSourceRect()->h) != tile_size_.y) {
-                        tile_left_top_pos.y -= (tile_info.sprite.getSourceRect()->h - static_cast<float>(tile_size_.y));
+        const auto& camera = context.getCamera();
+        const auto& palette = tiles_.getPalette();
+
+        // 1. 计算与视口相交的瓦片范围（下方多出 max_overhang_，因为高瓦片向上绘制），并限制在瓦片包围盒内
+        auto view_min = camera.getPosition() - offset_;
+        auto view_max = view_min + camera.getViewportSize() + glm::vec2(0.0f, max_overhang_);
+        glm::ivec2 start = {
+            static_cast<int>(std::floor(view_min.x / tile_size_.x)),
+            static_cast<int>(std::floor(view_min.y / tile_size_.y))
+        };
+        glm::ivec2 end = {
+            static_cast<int>(std::floor(view_max.x / tile_size_.x)),
+            static_cast<int>(std::floor(view_max.y / tile_size_.y))
+        };
+        start = glm::max(start, tiles_.getMinTile());
+        end = glm::min(end, tiles_.getMaxTile());
+        if (start.x > end.x || start.y > end.y) return;
+
+        // 2. 逐行绘制（与整行遍历的绘制顺序一致，下方的高瓦片覆盖上方），每个块行只查找一次块
+        const auto chunk_start = TileChunkMap::toChunkCoord(start);
+        const auto chunk_end = TileChunkMap::toChunkCoord(end);
+        std::vector<const TileChunkMap::Chunk*> row_chunks(static_cast<std::size_t>(chunk_end.x - chunk_start.x + 1));
+        for (int chunk_y = chunk_start.y; chunk_y <= chunk_end.y; ++chunk_y) {
+            bool any_chunk = false;
+            for (int chunk_x = chunk_start.x; chunk_x <= chunk_end.x; ++chunk_x) {
+                row_chunks[chunk_x - chunk_start.x] = tiles_.findChunk({ chunk_x, chunk_y });
+                any_chunk |= row_chunks[chunk_x - chunk_start.x] != nullptr;
+            }
+            if (!any_chunk) continue;   // 整个块行都是空的
+
+            const int y_begin = std::max(start.y, chunk_y * TileChunkMap::CHUNK_SIZE);
+            const int y_end = std::min(end.y, chunk_y * TileChunkMap::CHUNK_SIZE + TileChunkMap::CHUNK_SIZE - 1);
+            for (int y = y_begin; y <= y_end; ++y) {
+                for (int chunk_x = chunk_start.x; chunk_x <= chunk_end.x; ++chunk_x) {
+                    const auto* chunk = row_chunks[chunk_x - chunk_start.x];
+                    if (!chunk) continue;
+                    const auto* row = chunk->tiles.data() + (y & (TileChunkMap::CHUNK_SIZE - 1)) * TileChunkMap::CHUNK_SIZE;
+                    const int x_begin = std::max(start.x, chunk_x * TileChunkMap::CHUNK_SIZE);
+                    const int x_end = std::min(end.x, chunk_x * TileChunkMap::CHUNK_SIZE + TileChunkMap::CHUNK_SIZE - 1);
+                    for (int x = x_begin; x <= x_end; ++x) {
+                        auto index = row[x & (TileChunkMap::CHUNK_SIZE - 1)];
+                        if (index == 0) continue;
+                        const auto& tile_info = palette[index];
+                        // 计算该瓦片在世界中的左上角位置 (drawSprite 预期接收左上角坐标)
+                        glm::vec2 tile_left_top_pos = {
+                            offset_.x + static_cast<float>(x) * tile_size_.x,
+                            offset_.y + static_cast<float>(y) * tile_size_.y
+                        };
+                        // 但如果图片的大小与瓦片的大小不一致，需要调整 y 坐标 (瓦片层的对齐点是左下角)
+                        if (static_cast<int>(tile_info.sprite.getSourceRect()->h) != tile_size_.y) {
+                            tile_left_top_pos.y -= (tile_info.sprite.getSourceRect()->h - static_cast<float>(tile_size_.y));
+                        }
+                        // 执行绘制
+                        context.getRenderer().drawSprite(camera, tile_info.sprite, tile_left_top_pos);
                     }
-                    // 执行绘制
-                    context.getRenderer().drawSprite(context.getCamera(), tile_info.sprite, tile_left_top_pos);
                 }
             }
         }
     }
 
-    void TileLayerComponent::clean()
+    void TileLayerComponent::loadChunk(glm::ivec2 chunk_coord, const std::uint32_t* indices)
     {
+        tiles_.setChunk(chunk_coord, indices);
         if (physics_engine_) {
-            physics_engine_->unregisterCollisionLayer(this);
+            physics_engine_->refreshTileTraitChunk(chunk_coord);
         }
     }
 
-    const TileInfo* TileLayerComponent::getTileInfoAt(glm::ivec2 pos) const {
-        if (pos.x < 0 || pos.x >= map_size_.x || pos.y < 0 || pos.y >= map_size_.y) {
-            spdlog::warn("TileLayerComponent: 瓦片坐标越界: ({}, {})", pos.x, pos.y);
-            return nullptr;
+    void TileLayerComponent::unloadChunk(glm::ivec2 chunk_coord)
+    {
+        tiles_.unloadChunk(chunk_coord);
+        if (physics_engine_) {
+            physics_engine_->refreshTileTraitChunk(chunk_coord);
         }
-        size_t index = static_cast<size_t>(pos.y * map_size_.x + pos.x);
-        // 瓦片索引不能越界
-        if (index < tiles_.size()) {
-            return &tiles_[index];
+    }
+
+    void TileLayerComponent::clean()
+    {
+        if (physics_engine_) {
+            physics_engine_->unregisterCollisionLayer(this);
         }
-        spdlog::warn("TileLayerComponent: 瓦片索引越界: {}", index);
-        return nullptr;
     }
 
     TileType TileLayerComponent::getTileTypeAt(glm::ivec2 pos) const {
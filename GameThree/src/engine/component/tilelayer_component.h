@@ -1,7 +1,13 @@
 #pragma once
 #include "../render/sprite.h"
 #include "component.h"
+#include <array>
 #include <vector>
+#include <memory>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <glm/vec2.hpp>
 
 namespace engine::render {
@@ -36,27 +42,186 @@ namespace engine::component {
         // 未来补充其它类型
     };
 
+    /// @brief 瓦片特性位掩码（多个特性按位或组合，打包存储在物理引擎的瓦片特性网格中）
+    using TileTraitMask = std::uint8_t;
+
+    /**
+     * @brief 瓦片特性位。每一位对应一种需要物理引擎关心的瓦片特性。
+     */
+    namespace tile_trait {
+        inline constexpr TileTraitMask NONE = 0;            ///< @brief 无特性
+        inline constexpr TileTraitMask SOLID = 1 << 0;      ///< @brief 静止可碰撞
+        inline constexpr TileTraitMask UNISOLID = 1 << 1;   ///< @brief 单向可碰撞
+        inline constexpr TileTraitMask SLOPE = 1 << 2;      ///< @brief 斜坡
+        inline constexpr TileTraitMask HAZARD = 1 << 3;     ///< @brief 危险（触发器）
+        inline constexpr TileTraitMask LADDER = 1 << 4;     ///< @brief 梯子
+    }
+
+    /**
+     * @brief 根据瓦片类型获取对应的特性位掩码。
+     * @param type 瓦片类型
+     * @return TileTraitMask 特性位掩码
+     */
+    constexpr TileTraitMask getTileTraits(TileType type) {
+        switch (type) {
+        case TileType::SOLID:       return tile_trait::SOLID;
+        case TileType::UNISOLID:    return tile_trait::UNISOLID;
+        case TileType::SLOPE_0_1:
+        case TileType::SLOPE_1_0:
+        case TileType::SLOPE_0_2:
+        case TileType::SLOPE_2_1:
+        case TileType::SLOPE_1_2:
+        case TileType::SLOPE_2_0:   return tile_trait::SLOPE;
+        case TileType::HAZARD:      return tile_trait::HAZARD;
+        case TileType::LADDER:      return tile_trait::LADDER;
+        default:                    return tile_trait::NONE;
+        }
+    }
+
+    /**
+     * @brief 瓦片高度表：每个像素列一个字节，记录该列地面距瓦片底部的高度（像素）。
+     *
+     * 加载关卡时由 Tiled 中瓦片的碰撞多边形（或旧版 slope 属性）光栅化得到，
+     * 同一图块集瓦片的所有实例共享同一份高度表。斜坡查询因此只是一次查表。
+     */
+    using TileHeightProfile = std::vector<std::uint8_t>;
+
     /**
      * @brief 包含单个瓦片的渲染和逻辑信息。
      */
     struct TileInfo {
         render::Sprite sprite;      ///< @brief 瓦片的视觉表示
         TileType type;              ///< @brief 瓦片的逻辑类型
-        TileInfo(render::Sprite s = render::Sprite(), TileType t = TileType::EMPTY) : sprite(std::move(s)), type(t) {}
+        std::shared_ptr<const TileHeightProfile> height_profile;    ///< @brief 高度表（非斜坡瓦片为空）
+        TileInfo(render::Sprite s = render::Sprite(), TileType t = TileType::EMPTY,
+            std::shared_ptr<const TileHeightProfile> profile = nullptr)
+            : sprite(std::move(s)), type(t), height_profile(std::move(profile)) {}
+    };
+
+    /**
+     * @brief 获取瓦片的特性位掩码。带有高度表的瓦片无论类型如何都视为斜坡。
+     * @param tile 瓦片信息
+     * @return TileTraitMask 特性位掩码
+     */
+    inline TileTraitMask getTileTraits(const TileInfo& tile) {
+        auto traits = getTileTraits(tile.type);
+        if (tile.height_profile) traits |= tile_trait::SLOPE;
+        return traits;
+    }
+
+    /**
+     * @brief 分块稀疏存储的瓦片数据。
+     *
+     * 瓦片按 CHUNK_SIZE x CHUNK_SIZE 分块，块按块坐标存放在哈希表中，没有瓦片的块不占内存；
+     * 块中每个瓦片只存一个调色板下标（下标0为空瓦片），相同瓦片共用调色板中的 TileInfo。
+     * 瓦片坐标可以为负（Tiled 无限地图的块可以位于原点左上方）。
+     * 流式加载的关卡中，尚未载入（或已被回收）的块记为未载入，查询时按配置视为空瓦片或实心瓦片。
+     */
+    class TileChunkMap final {
+    public:
+        static constexpr int CHUNK_SIZE = 32;                       ///< @brief 块边长（瓦片数，2的幂）
+        static constexpr int CHUNK_SHIFT = 5;                       ///< @brief log2(CHUNK_SIZE)
+        static constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;  ///< @brief 每块的瓦片数
+
+        /// @brief 瓦片块
+        struct Chunk {
+            std::array<std::uint32_t, CHUNK_AREA> tiles{};  ///< @brief 调色板下标（行主序, index = y * CHUNK_SIZE + x）
+            int tile_count = 0;                             ///< @brief 非空瓦片数量（为0时块被释放）
+        };
+
+    private:
+        std::vector<TileInfo> palette_ = { TileInfo() };                        ///< @brief 调色板（下标0为空瓦片）
+        std::unordered_map<std::uint64_t, std::unique_ptr<Chunk>> chunks_;      ///< @brief 块坐标键 -> 块
+        std::unordered_set<std::uint64_t> unloaded_chunks_;                     ///< @brief 未载入的块（流式加载）
+        std::optional<TileInfo> unloaded_tile_;                                 ///< @brief 未载入块中的瓦片（空表示视为空瓦片）
+        glm::ivec2 min_tile_ = { 0, 0 };        ///< @brief 非空瓦片包围盒的左上角（闭区间，没有瓦片时无效）
+        glm::ivec2 max_tile_ = { -1, -1 };      ///< @brief 非空瓦片包围盒的右下角（闭区间）
+
+    public:
+        /**
+         * @brief 添加调色板项。
+         * @param tile 瓦片信息
+         * @return std::uint32_t 调色板下标
+         */
+        std::uint32_t addPaletteEntry(TileInfo tile);
+
+        /**
+         * @brief 设置瓦片（按需分配块，块中瓦片全部清空时释放块）。
+         * @param pos 瓦片坐标
+         * @param palette_index 调色板下标（0表示清空，越界按0处理）
+         */
+        void setTile(glm::ivec2 pos, std::uint32_t palette_index);
+
+        /**
+         * @brief 获取瓦片信息。
+         * @param pos 瓦片坐标
+         * @return const TileInfo* 瓦片信息，空瓦片（包括不存在的块）返回 nullptr
+         */
+        const TileInfo* getTile(glm::ivec2 pos) const;
+
+        /// @brief 根据块坐标查找块，不存在时返回 nullptr
+        const Chunk* findChunk(glm::ivec2 chunk_coord) const;
+
+        /**
+         * @brief 整块设置瓦片（流式载入块时调用），该块不再视为未载入。
+         * @param chunk_coord 块坐标
+         * @param indices 调色板下标数组（CHUNK_AREA 个，行主序）
+         */
+        void setChunk(glm::ivec2 chunk_coord, const std::uint32_t* indices);
+
+        /// @brief 将块标记为未载入并释放其瓦片（流式加载登记块或回收块时调用），包围盒扩展到整个块
+        void unloadChunk(glm::ivec2 chunk_coord);
+
+        /// @brief 块是否未载入
+        bool isChunkUnloaded(glm::ivec2 chunk_coord) const { return unloaded_chunks_.contains(packKey(chunk_coord)); }
+
+        /// @brief 设置未载入块中的瓦片（std::nullopt 表示视为空瓦片）
+        void setUnloadedTile(std::optional<TileInfo> tile) { unloaded_tile_ = std::move(tile); }
+
+        /// @brief 遍历所有块：func(glm::ivec2 chunk_coord, const Chunk& chunk)（顺序不确定）
+        template<typename Func>
+        void forEachChunk(Func&& func) const {
+            for (const auto& [key, chunk] : chunks_) {
+                func(unpackKey(key), *chunk);
+            }
+        }
+
+        const std::vector<TileInfo>& getPalette() const { return palette_; }   ///< @brief 获取调色板
+        std::size_t getChunkCount() const { return chunks_.size(); }           ///< @brief 获取块数量
+        bool isEmpty() const { return chunks_.empty() && unloaded_chunks_.empty(); }   ///< @brief 是否没有任何瓦片（也没有未载入的块）
+        glm::ivec2 getMinTile() const { return min_tile_; }     ///< @brief 非空瓦片包围盒左上角（isEmpty() 时无效）
+        glm::ivec2 getMaxTile() const { return max_tile_; }     ///< @brief 非空瓦片包围盒右下角（闭区间）
+
+        /// @brief 瓦片坐标 -> 块坐标（向下取整，负坐标同样适用）
+        static glm::ivec2 toChunkCoord(glm::ivec2 tile_pos) {
+            return { tile_pos.x >> CHUNK_SHIFT, tile_pos.y >> CHUNK_SHIFT };
+        }
+        /// @brief 块坐标 -> 哈希表键
+        static std::uint64_t packKey(glm::ivec2 chunk_coord) {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunk_coord.x)) << 32) | static_cast<std::uint32_t>(chunk_coord.y);
+        }
+        /// @brief 哈希表键 -> 块坐标
+        static glm::ivec2 unpackKey(std::uint64_t key) {
+            return { static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32)), static_cast<std::int32_t>(static_cast<std::uint32_t>(key)) };
+        }
     };
 
     /**
      * @brief 管理和渲染瓦片地图层。
      *
-     * 存储瓦片地图的布局、每个瓦片的精灵信息和类型。
-     * 负责在渲染阶段绘制可见的瓦片。
+     * 瓦片以 TileChunkMap 分块稀疏存储，大面积空白的地图只在有瓦片的地方占用内存。
+     * 渲染时只遍历与相机视口相交的块。
      */
     class TileLayerComponent final : public Component {
         friend class engine::object::GameObject;
+    public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::TILE_LAYER;   ///< @brief 固定的组件类型ID（见 component_type）
+
     private:
         glm::ivec2 tile_size_;              ///< @brief 单个瓦片尺寸（像素）
-        glm::ivec2 map_size_;               ///< @brief 地图尺寸（瓦片数）
-        std::vector<TileInfo> tiles_;       ///< @brief 存储所有瓦片信息 (按"行主序"存储, index = y * map_width_ + x)
+        glm::ivec2 map_size_;               ///< @brief 地图尺寸（瓦片数，从原点到非空瓦片包围盒的右下角）
+        TileChunkMap tiles_;                ///< @brief 分块存储的瓦片
+        float max_overhang_ = 0.0f;         ///< @brief 瓦片图片高出瓦片的最大高度（像素，渲染裁剪时需要向下多看这么多）
         glm::vec2 offset_ = { 0.0f, 0.0f };   ///< @brief 瓦片层在世界中的偏移量 (瓦片层通常不需要缩放及旋转，因此不引入Transform组件)
         // offset_ 最好也保持默认的0，以免增加不必要的复杂性
         bool is_hidden_ = false;            ///< @brief 是否隐藏（不渲染）
@@ -68,22 +233,22 @@ namespace engine::component {
         /**
          * @brief 构造函数
          * @param tile_size 单个瓦片尺寸（像素）
-         * @param map_size 地图尺寸（瓦片数）
-         * @param tiles 初始化瓦片数据的容器 (会被移动)
+         * @param map_size 地图尺寸（瓦片数，有限地图的宽高；无限地图传入0时由瓦片包围盒计算）
+         * @param tiles 分块存储的瓦片 (会被移动)
          */
-        TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, std::vector<TileInfo>&& tiles);
+        TileLayerComponent(glm::ivec2 tile_size, glm::ivec2 map_size, TileChunkMap&& tiles);
 
         /**
          * @brief 根据瓦片坐标获取瓦片信息
-         * @param pos 瓦片坐标 (0 <= x < map_size_.x, 0 <= y < map_size_.y)
-         * @return const TileInfo* 指向瓦片信息的指针，如果坐标无效则返回 nullptr
+         * @param pos 瓦片坐标（可以在地图范围之外）
+         * @return const TileInfo* 指向瓦片信息的指针，空瓦片或没有瓦片的位置返回 nullptr
          */
-        const TileInfo* getTileInfoAt(glm::ivec2 pos) const;
+        const TileInfo* getTileInfoAt(glm::ivec2 pos) const { return tiles_.getTile(pos); }
 
         /**
          * @brief 根据瓦片坐标获取瓦片类型
-         * @param pos 瓦片坐标 (0 <= x < map_size_.x, 0 <= y < map_size_.y)
-         * @return TileType 瓦片类型，如果坐标无效则返回 TileType::EMPTY
+         * @param pos 瓦片坐标（可以在地图范围之外）
+         * @return TileType 瓦片类型，空瓦片或没有瓦片的位置返回 TileType::EMPTY
          */
         TileType getTileTypeAt(glm::ivec2 pos) const;
 
@@ -94,13 +259,22 @@ namespace engine::component {
          */
         TileType getTileTypeAtWorldPos(const glm::vec2& world_pos) const;
 
+        /**
+         * @brief 载入一个流式加载的块，并通知物理引擎刷新该块的瓦片特性。
+         * @param chunk_coord 块坐标
+         * @param indices 调色板下标数组（CHUNK_AREA 个，行主序）
+         */
+        void loadChunk(glm::ivec2 chunk_coord, const std::uint32_t* indices);
+        /// @brief 回收一个块（之后按未载入处理），并通知物理引擎刷新该块的瓦片特性
+        void unloadChunk(glm::ivec2 chunk_coord);
+
         // getters and setters
         glm::ivec2 getTileSize() const { return tile_size_; }               ///< @brief 获取单个瓦片尺寸
         glm::ivec2 getMapSize() const { return map_size_; }                 ///< @brief 获取地图尺寸
         glm::vec2 getWorldSize() const {                                    ///< @brief 获取地图世界尺寸
             return glm::vec2(map_size_.x * tile_size_.x, map_size_.y * tile_size_.y);
         }
-        const std::vector<TileInfo>& getTiles() const { return tiles_; }    ///< @brief 获取瓦片容器
+        const TileChunkMap& getTiles() const { return tiles_; }             ///< @brief 获取分块瓦片容器
         const glm::vec2& getOffset() const { return offset_; }              ///< @brief 获取瓦片层的偏移量
         bool isHidden() const { return is_hidden_; }                        ///< @brief 获取是否隐藏（不渲染）
 
@@ -11,6 +11,9 @@ namespace engine::component {
     class TransformComponent final : public Component {
         friend class engine::object::GameObject;        // 友元不能继承，必须每个子类单独添加
     public:
+        static constexpr ComponentTypeId TYPE_ID = component_type::TRANSFORM;   ///< @brief 固定的组件类型ID（见 component_type）
+        static constexpr bool PACKED = true;    ///< @brief 按值紧密存储在原型中（见 Component::PACKED）
+
         glm::vec2 position_ = { 0.0f, 0.0f };     ///< @brief 位置
         glm::vec2 scale_ = { 1.0f, 1.0f };        ///< @brief 缩放
         float rotation_ = 0.0f;                 ///< @brief 角度制，单位：度
@@ -25,10 +28,10 @@ namespace engine::component {
             : position_(position), scale_(scale), rotation_(rotation) {
         }
 
-        // 禁止拷贝和移动
+        // 禁止拷贝和赋值
         TransformComponent(const TransformComponent&) = delete;
         TransformComponent& operator=(const TransformComponent&) = delete;
-        TransformComponent(TransformComponent&&) = delete;
+        TransformComponent(TransformComponent&&) noexcept = default;  ///< @brief 紧密存储在原型数组中，需要移动构造（所有者不变）
         TransformComponent& operator=(TransformComponent&&) = delete;
 
         // Getters and setters 
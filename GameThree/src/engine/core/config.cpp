@@ -72,6 +72,23 @@ namespace engine::core {
                 spdlog::warn("目标 FPS 不能为负数。设置为 0（无限制）。");
                 target_fps_ = 0;
             }
+            activity_margin_ = perf_config.value("activity_margin", activity_margin_);
+            spawn_margin_ = perf_config.value("spawn_margin", spawn_margin_);
+            despawn_margin_ = perf_config.value("despawn_margin", despawn_margin_);
+            level_stream_chunk_budget_ = perf_config.value("level_stream_chunk_budget", level_stream_chunk_budget_);
+            if (level_stream_chunk_budget_ < 0) {
+                spdlog::warn("流式加载的块预算不能为负数。设置为 0（禁用流式加载）。");
+                level_stream_chunk_budget_ = 0;
+            }
+            level_stream_margin_ = perf_config.value("level_stream_margin", level_stream_margin_);
+            level_stream_lookahead_ = perf_config.value("level_stream_lookahead", level_stream_lookahead_);
+            level_stream_unloaded_solid_ = perf_config.value("level_stream_unloaded_solid", level_stream_unloaded_solid_);
+            texture_upload_budget_ms_ = perf_config.value("texture_upload_budget_ms", texture_upload_budget_ms_);
+            if (texture_upload_budget_ms_ < 0.0f) {
+                spdlog::warn("纹理上传预算不能为负数。设置为 0（每帧只上传一张）。");
+                texture_upload_budget_ms_ = 0.0f;
+            }
+            report_late_resource_loads_ = perf_config.value("report_late_resource_loads", report_late_resource_loads_);
         }
         if (j.contains("audio")) {
             const auto& audio_config = j["audio"];
@@ -110,7 +127,16 @@ namespace engine::core {
                 {"vsync", vsync_enabled_}
             }},
             {"performance", {
-                {"target_fps", target_fps_}
+                {"target_fps", target_fps_},
+                {"activity_margin", activity_margin_},
+                {"spawn_margin", spawn_margin_},
+                {"despawn_margin", despawn_margin_},
+                {"level_stream_chunk_budget", level_stream_chunk_budget_},
+                {"level_stream_margin", level_stream_margin_},
+                {"level_stream_lookahead", level_stream_lookahead_},
+                {"level_stream_unloaded_solid", level_stream_unloaded_solid_},
+                {"texture_upload_budget_ms", texture_upload_budget_ms_},
+                {"report_late_resource_loads", report_late_resource_loads_}
             }},
             {"audio", {
                 {"music_volume", music_volume_},
@@ -26,6 +26,15 @@ namespace engine::core {
 
         // 性能设置
         int target_fps_ = 144;                  ///< @brief 目标 FPS 设置，0 表示不限制
+        float activity_margin_ = 320.0f;        ///< @brief 活动区域在视口四周扩展的距离（像素），区域外的对象休眠；负数表示禁用休眠
+        float spawn_margin_ = 160.0f;           ///< @brief 关卡对象在相机进入此距离（像素）时生成
+        float despawn_margin_ = 480.0f;         ///< @brief 关卡对象在相机远离此距离（像素）时回收；负数表示不回收
+        int level_stream_chunk_budget_ = 4096;  ///< @brief 常驻瓦片块数量上限，烘焙关卡的块总数超过时流式加载；0 表示禁用流式加载
+        float level_stream_margin_ = 512.0f;    ///< @brief 流式加载的预取范围：视口向四周扩展的距离（像素）
+        float level_stream_lookahead_ = 0.5f;   ///< @brief 流式加载的前瞻时间（秒），预取范围沿相机速度方向扩展
+        bool level_stream_unloaded_solid_ = false;  ///< @brief 尚未载入的瓦片块视为实心（true）或空（false）
+        float texture_upload_budget_ms_ = 2.0f; ///< @brief 每帧上传后台解码纹理的时间预算（毫秒），每帧至少上传一张
+        bool report_late_resource_loads_ = false;   ///< @brief 诊断模式：报告场景激活后才加载的资源（卡顿来源）
 
         // 音频设置
         float music_volume_ = 0.5f;
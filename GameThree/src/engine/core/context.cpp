@@ -17,7 +17,8 @@ namespace engine::core {
         engine::resource::ResourceManager& resource_manager,
         engine::physics::PhysicsEngine& physics_engine,
         engine::audio::AudioPlayer& audio_player,
-        engine::core::GameState& game_state)
+        engine::core::GameState& game_state,
+        engine::object::HandleTable& handle_table)
         : input_manager_(input_manager),
         renderer_(renderer),
         camera_(camera),
@@ -25,7 +26,8 @@ namespace engine::core {
         resource_manager_(resource_manager),
         physics_engine_(physics_engine),
         audio_player_(audio_player),
-        game_state_(game_state)
+        game_state_(game_state),
+        handle_table_(handle_table)
     {
         spdlog::trace("上下文已创建并初始化。");
     }
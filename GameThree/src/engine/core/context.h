@@ -22,6 +22,10 @@ namespace engine::audio {
     class AudioPlayer;
 }
 
+namespace engine::object {
+    class HandleTable;
+}
+
 namespace engine::core {
     class GameState;
 
@@ -41,6 +45,7 @@ namespace engine::core {
         engine::physics::PhysicsEngine& physics_engine_;        ///< @brief 物理引擎
         engine::audio::AudioPlayer& audio_player_;              ///< @brief 音频播放器
         engine::core::GameState& game_state_;                   ///< @brief 游戏状态
+        engine::object::HandleTable& handle_table_;             ///< @brief 游戏对象句柄表
     public:
         /**
          * @brief 构造函数。
@@ -49,6 +54,7 @@ namespace engine::core {
          * @param camera 对 Camera 实例的引用。
          * @param resource_manager 对 ResourceManager 实例的引用。
          * @param physics_engine 对 PhysicsEngine 实例的引用。
+         * @param handle_table 对 HandleTable 实例的引用。
          */
         Context(engine::input::InputManager& input_manager,
             engine::render::Renderer& renderer,
@@ -57,7 +63,8 @@ namespace engine::core {
             engine::resource::ResourceManager& resource_manager,
             engine::physics::PhysicsEngine& physics_engine,
             engine::audio::AudioPlayer& audio_player,
-            engine::core::GameState& game_state);
+            engine::core::GameState& game_state,
+            engine::object::HandleTable& handle_table);
 
         // 禁止拷贝和移动，Context 对象通常是唯一的或按需创建/传递
         Context(const Context&) = delete;
@@ -74,6 +81,7 @@ namespace engine::core {
         engine::physics::PhysicsEngine& getPhysicsEngine() const { return physics_engine_; }         ///< @brief 获取物理引擎
         engine::audio::AudioPlayer& getAudioPlayer() const { return audio_player_; }                 ///< @brief 获取音频播放器
         engine::core::GameState& getGameState() const { return game_state_; }                         ///< @brief 获取游戏状态
+        engine::object::HandleTable& getHandleTable() const { return handle_table_; }                 ///< @brief 获取游戏对象句柄表
     };
 
 } // namespace engine::core
\ No newline at end of file
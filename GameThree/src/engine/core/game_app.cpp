@@ -10,6 +10,7 @@
 #include "../render/text_renderer.h"
 #include "../input/input_manager.h"
 #include "../physics/physics_engine.h"
+#include "../object/handle_table.h"
 #include "../scene/scene_manager.h"
 #include "../../game/scene/title_scene.h"
 #include <SDL3/SDL.h>
@@ -52,6 +53,7 @@ namespace engine::core {
         if (!initConfig()) return false;
         if (!initSDL())  return false;
         if (!initTime()) return false;
+        if (!initHandleTable()) return false;
         if (!initResourceManager()) return false;
         if (!initAudioPlayer()) return false;
         if (!initRenderer()) return false;
@@ -89,13 +91,16 @@ namespace engine::core {
     }
 
     void GameApp::render() {
-        // 1. 清除屏幕
+        // 1. 在预算内上传后台解码好的纹理（必须在主线程）
+        resource_manager_->uploadPendingTextures(static_cast<std::uint64_t>(config_->texture_upload_budget_ms_ * 1'000'000.0f));
+
+        // 2. 清除屏幕
         renderer_->clearScreen();
 
-        // 2. 具体渲染代码
+        // 3. 具体渲染代码
         scene_manager_->render();
 
-        // 3. 更新屏幕显示
+        // 4. 更新屏幕显示
         renderer_->present();
     }
 
@@ -186,6 +191,7 @@ namespace engine::core {
             spdlog::error("初始化资源管理器失败: {}", e.what());
             return false;
         }
+        resource_manager_->setLateLoadReport(config_->report_late_resource_loads_);
         spdlog::trace("资源管理器初始化成功。");
         return true;
     }
@@ -215,9 +221,22 @@ namespace engine::core {
         return true;
     }
 
+    bool GameApp::initHandleTable()
+    {
+        try {
+            handle_table_ = std::make_unique<engine::object::HandleTable>();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("初始化句柄表失败: {}", e.what());
+            return false;
+        }
+        spdlog::trace("句柄表初始化成功。");
+        return true;
+    }
+
     bool GameApp::initCamera() {
         try {
-            camera_ = std::make_unique<engine::render::Camera>(glm::vec2(config_->window_width_ / 2, config_->window_height_ / 2));
+            camera_ = std::make_unique<engine::render::Camera>(*handle_table_, glm::vec2(config_->window_width_ / 2, config_->window_height_ / 2));
         }
         catch (const std::exception& e) {
             spdlog::error("初始化相机失败: {}", e.what());
@@ -288,7 +307,8 @@ namespace engine::core {
                 *resource_manager_,
                 *physics_engine_,
                 *audio_player_,
-                *game_state_);
+                *game_state_,
+                *handle_table_);
         }
         catch (const std::exception& e) {
             spdlog::error("初始化上下文失败: {}", e.what());
@@ -301,6 +321,15 @@ namespace engine::core {
     {
         try {
             scene_manager_ = std::make_unique<engine::scene::SceneManager>(*context_);
+            scene_manager_->setActivityMargin(config_->activity_margin_);
+            scene_manager_->setSpawnMargin(config_->spawn_margin_);
+            scene_manager_->setDespawnMargin(config_->despawn_margin_);
+            engine::scene::LevelStreamingSettings streaming_settings;
+            streaming_settings.chunk_budget = static_cast<std::size_t>(config_->level_stream_chunk_budget_);
+            streaming_settings.margin = config_->level_stream_margin_;
+            streaming_settings.lookahead = config_->level_stream_lookahead_;
+            streaming_settings.unloaded_solid = config_->level_stream_unloaded_solid_;
+            scene_manager_->setLevelStreamingSettings(streaming_settings);
         }
         catch (const std::exception& e) {
             spdlog::error("初始化场景管理器失败: {}", e.what());
@@ -32,6 +32,10 @@ namespace engine::audio {
     class AudioPlayer;
 }
 
+namespace engine::object {
+    class HandleTable;
+}
+
 namespace engine::core {        // 命名空间的最佳实践：与文件路径一致
     class Time;
     class Config;
@@ -49,6 +53,7 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
 
         // 引擎组件
         std::unique_ptr<engine::core::Time> time_;
+        std::unique_ptr<engine::object::HandleTable> handle_table_;     ///< @brief 需在场景管理器之前声明（场景销毁时要注销对象句柄）
         std::unique_ptr<engine::resource::ResourceManager> resource_manager_;
         std::unique_ptr<engine::render::Renderer> renderer_;
         std::unique_ptr<engine::render::Camera> camera_;
@@ -87,6 +92,7 @@ namespace engine::core {        // 命名空间的最佳实践：与文件路径
         [[nodiscard]] bool initConfig();
         [[nodiscard]] bool initSDL();
         [[nodiscard]] bool initTime();
+        [[nodiscard]] bool initHandleTable();
         [[nodiscard]] bool initResourceManager();
         [[nodiscard]] bool initAudioPlayer();
         [[nodiscard]] bool initRenderer();
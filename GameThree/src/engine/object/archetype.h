@@ -0,0 +1,117 @@
+#pragma once
+#include "../component/component.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::object {
+    class GameObject;
+    class ObjectArena;
+
+    /**
+     * @brief 原型中一种紧密存储组件的数组（类型擦除的接口，具体实现见 PackedColumn<T>）。
+     * @details 各列的行与原型的 objects 一一对应；删除某一行时，原型的所有列都与末尾行交换，保持对齐。
+     */
+    class PackedColumnBase {
+    public:
+        virtual ~PackedColumnBase() = default;
+
+        virtual engine::component::Component* at(std::size_t row) = 0;         ///< @brief 获取第 row 行的组件
+        virtual void pushFrom(engine::component::Component& component) = 0;   ///< @brief 把同类型的组件搬移到末尾（原组件只剩空壳，由调用方销毁）
+        virtual void moveRowTo(std::size_t row, PackedColumnBase& destination) = 0;    ///< @brief 把第 row 行搬到另一原型同类型列的末尾，并删除该行
+        /// @brief 把第 row 行搬移为单独分配的组件（对象离开场景时），并删除该行
+        virtual std::unique_ptr<engine::component::Component> extract(std::size_t row, ObjectArena* arena) = 0;
+        virtual void erase(std::size_t row) = 0;                              ///< @brief 销毁第 row 行（与末尾行交换）
+    };
+
+    /**
+     * @brief 按值存放组件 T 的数组。
+     * @tparam T 紧密存储的组件类型（PACKED 为 true，可以移动构造）
+     */
+    template <typename T>
+    class PackedColumn final : public PackedColumnBase {
+        std::vector<T> values_;     ///< @brief 组件本身（连续存放）
+
+    public:
+        std::vector<T>& values() { return values_; }   ///< @brief 获取组件数组
+
+        engine::component::Component* at(std::size_t row) override { return &values_[row]; }
+
+        void pushFrom(engine::component::Component& component) override {
+            values_.push_back(std::move(static_cast<T&>(component)));
+        }
+
+        void moveRowTo(std::size_t row, PackedColumnBase& destination) override {
+            static_cast<PackedColumn<T>&>(destination).values_.push_back(std::move(values_[row]));
+            erase(row);
+        }
+
+        std::unique_ptr<engine::component::Component> extract(std::size_t row, ObjectArena* arena) override {
+            std::unique_ptr<engine::component::Component> component(new (arena) T(std::move(values_[row])));
+            erase(row);
+            return component;
+        }
+
+        void erase(std::size_t row) override {
+            // 组件只能移动构造，不能赋值：先销毁该行，再用末尾元素在原位构造
+            if (row + 1 != values_.size()) {
+                std::destroy_at(&values_[row]);
+                std::construct_at(&values_[row], std::move(values_.back()));
+            }
+            values_.pop_back();
+        }
+
+        static std::unique_ptr<PackedColumnBase> make() { return std::make_unique<PackedColumn<T>>(); }    ///< @brief 创建空数组（登记为该类型的工厂）
+    };
+
+    using PackedColumnFactory = std::unique_ptr<PackedColumnBase>(*)();    ///< @brief 创建某种组件的空数组
+
+    namespace detail {
+        /// @brief 登记紧密存储的组件类型（每个类型首次添加时调用一次），之后创建的原型为它建立数组
+        bool registerPackedColumn(engine::component::ComponentTypeId type_id, PackedColumnFactory factory);
+        /// @brief 获取组件类型的数组工厂，不是紧密存储的类型返回空
+        PackedColumnFactory getPackedColumnFactory(engine::component::ComponentTypeId type_id);
+    }
+
+    /**
+     * @brief 一个原型：组件掩码相同的所有游戏对象及其组件。
+     * @details 紧密存储的组件（T::PACKED）按值存放在 packed 中，其他组件仍由对象持有，这里只记录指针。
+     */
+    struct Archetype {
+        std::uint32_t mask = 0;                     ///< @brief 组件掩码
+        std::vector<GameObject*> objects;           ///< @brief 每行对应的游戏对象
+        /// @brief 紧密存储组件的数组（只有掩码中的紧密存储类型有值）
+        std::array<std::unique_ptr<PackedColumnBase>, engine::component::MAX_COMPONENT_TYPES> packed;
+        /// @brief 其他组件的指针列（只有掩码中的其他类型有数据；指向对象持有的组件）
+        std::array<std::vector<engine::component::Component*>, engine::component::MAX_COMPONENT_TYPES> columns;
+
+        /// @brief 获取紧密存储组件 T 的数组（T 必须在掩码中）
+        template <typename T>
+        std::vector<T>& packedColumn() {
+            return static_cast<PackedColumn<T>&>(*packed[engine::component::getComponentTypeId<T>()]).values();
+        }
+
+        /**
+         * @brief 按行访问组件 T 的视图：紧密存储时直接指向数组，否则指向指针列。
+         * @details 遍历前取一次，遍历期间不要增删组件或对象（数组可能重新分配）。
+         */
+        template <typename T>
+        class View {
+            std::conditional_t<T::PACKED, T*, engine::component::Component* const*> data_;
+        public:
+            explicit View(Archetype& archetype) {
+                if constexpr (T::PACKED) data_ = archetype.packedColumn<T>().data();
+                else data_ = archetype.columns[engine::component::getComponentTypeId<T>()].data();
+            }
+            T& operator[](std::size_t row) const {
+                if constexpr (T::PACKED) return data_[row];
+                else return *static_cast<T*>(data_[row]);
+            }
+        };
+    };
+
+} // namespace engine::object
@@ -0,0 +1,169 @@
+#include "archetype_registry.h"
+#include <array>
+#include <bit>
+#include <mutex>
+#include <spdlog/spdlog.h>
+
+namespace engine::object {
+
+    namespace {
+        std::mutex packed_factories_mutex;
+        std::array<PackedColumnFactory, engine::component::MAX_COMPONENT_TYPES> packed_factories{};    ///< @brief 类型ID -> 紧密存储数组的工厂
+    }
+
+    namespace detail {
+        bool registerPackedColumn(engine::component::ComponentTypeId type_id, PackedColumnFactory factory)
+        {
+            std::lock_guard lock(packed_factories_mutex);
+            packed_factories[type_id] = factory;
+            return true;
+        }
+
+        PackedColumnFactory getPackedColumnFactory(engine::component::ComponentTypeId type_id)
+        {
+            std::lock_guard lock(packed_factories_mutex);
+            return packed_factories[type_id];
+        }
+    }
+
+    ArchetypeRegistry::~ArchetypeRegistry()
+    {
+        clear();
+    }
+
+    void ArchetypeRegistry::add(GameObject* game_object)
+    {
+        if (!game_object) return;
+        if (game_object->archetype_registry_) {
+            if (game_object->archetype_registry_ == this) return;   // 已注册
+            game_object->archetype_registry_->remove(game_object);  // 从其他注册表转移过来
+        }
+        game_object->archetype_registry_ = this;
+        auto& archetype = getOrCreateArchetype(game_object->component_mask_);
+        takeComponents(archetype, game_object, archetype.mask);
+        appendObject(archetype, game_object);
+    }
+
+    void ArchetypeRegistry::remove(GameObject* game_object)
+    {
+        if (!game_object || game_object->archetype_registry_ != this) return;
+        auto& archetype = *game_object->archetype_;
+        const auto row = game_object->archetype_row_;
+        for (auto bits = archetype.mask; bits != 0; bits &= bits - 1) {
+            const auto type_id = std::countr_zero(bits);
+            if (auto& column = archetype.packed[type_id]) {
+                // 对象仍有的组件搬回对象（离开场景后仍可使用，如回到对象池）；已清理的对象直接销毁
+                if (game_object->component_mask_ & (1u << type_id)) {
+                    game_object->components_[type_id] = column->extract(row, game_object->arena_);
+                }
+                else {
+                    column->erase(row);
+                }
+            }
+            else {
+                auto& pointers = archetype.columns[type_id];
+                pointers[row] = pointers.back();
+                pointers.pop_back();
+            }
+        }
+        eraseObject(archetype, row);
+        game_object->archetype_ = nullptr;
+        game_object->archetype_registry_ = nullptr;
+    }
+
+    void ArchetypeRegistry::refile(GameObject* game_object)
+    {
+        if (!game_object || game_object->archetype_registry_ != this) return;
+        auto& source = *game_object->archetype_;
+        if (source.mask == game_object->component_mask_) return;
+        auto& destination = getOrCreateArchetype(game_object->component_mask_);     // 原型由 unique_ptr 持有，source 不会失效
+        const auto row = game_object->archetype_row_;
+
+        // 两个原型都有的组件从源行直接搬到目标原型；移除的组件随源行销毁（槽位中的已由对象销毁）
+        for (auto bits = source.mask; bits != 0; bits &= bits - 1) {
+            const auto type_id = std::countr_zero(bits);
+            const bool kept = (destination.mask & (1u << type_id)) != 0;
+            if (auto& column = source.packed[type_id]) {
+                if (kept) column->moveRowTo(row, *destination.packed[type_id]);
+                else column->erase(row);
+            }
+            else {
+                auto& pointers = source.columns[type_id];
+                if (kept) destination.columns[type_id].push_back(pointers[row]);
+                pointers[row] = pointers.back();
+                pointers.pop_back();
+            }
+        }
+        eraseObject(source, row);
+
+        // 新增的组件在对象的槽位中
+        takeComponents(destination, game_object, destination.mask & ~source.mask);
+        appendObject(destination, game_object);
+    }
+
+    void ArchetypeRegistry::clear()
+    {
+        // 逐个注销（紧密存储的组件搬回对象），之后对象仍可单独使用或销毁
+        for (auto& archetype : archetypes_) {
+            while (!archetype->objects.empty()) {
+                remove(archetype->objects.back());
+            }
+        }
+        archetypes_.clear();
+        archetype_lookup_.clear();
+    }
+
+    Archetype& ArchetypeRegistry::getOrCreateArchetype(std::uint32_t mask)
+    {
+        if (auto it = archetype_lookup_.find(mask); it != archetype_lookup_.end()) {
+            return *archetypes_[it->second];
+        }
+        auto archetype = std::make_unique<Archetype>();
+        archetype->mask = mask;
+        for (auto bits = mask; bits != 0; bits &= bits - 1) {
+            const auto type_id = std::countr_zero(bits);
+            if (auto factory = detail::getPackedColumnFactory(type_id)) {
+                archetype->packed[type_id] = factory();
+            }
+        }
+        archetype_lookup_[mask] = archetypes_.size();
+        archetypes_.push_back(std::move(archetype));
+        spdlog::trace("ArchetypeRegistry: 新增原型，掩码 {:#010x}，当前共 {} 个原型", mask, archetypes_.size());
+        return *archetypes_.back();
+    }
+
+    void ArchetypeRegistry::takeComponents(Archetype& archetype, GameObject* game_object, std::uint32_t mask)
+    {
+        for (auto bits = mask; bits != 0; bits &= bits - 1) {
+            const auto type_id = std::countr_zero(bits);
+            auto& slot = game_object->components_[type_id];
+            if (auto& column = archetype.packed[type_id]) {
+                column->pushFrom(*slot);
+                slot.reset();       // 销毁搬空的组件，之后通过原型访问
+            }
+            else {
+                archetype.columns[type_id].push_back(slot.get());
+            }
+        }
+    }
+
+    void ArchetypeRegistry::appendObject(Archetype& archetype, GameObject* game_object)
+    {
+        game_object->archetype_ = &archetype;
+        game_object->archetype_row_ = archetype.objects.size();
+        archetype.objects.push_back(game_object);
+    }
+
+    void ArchetypeRegistry::eraseObject(Archetype& archetype, std::size_t row)
+    {
+        // 与末尾行交换后删除末尾行，与各列的删除方式一致
+        auto last = archetype.objects.size() - 1;
+        if (row != last) {
+            auto* moved = archetype.objects[last];
+            archetype.objects[row] = moved;
+            moved->archetype_row_ = row;
+        }
+        archetype.objects.pop_back();
+    }
+
+} // namespace engine::object
@@ -0,0 +1,90 @@
+#pragma once
+#include "../component/component.h"
+#include "archetype.h"
+#include "game_object.h"
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine::object {
+
+    /**
+     * @brief 原型（Archetype）注册表：按"组件组合"对游戏对象分组存放组件，支持系统式的批量遍历。
+     *
+     * 组件组合相同（组件掩码相同）的游戏对象属于同一个原型，同一行的各列属于同一个游戏对象，删除时与末尾行交换。
+     * 每帧被批量遍历的组件（变换、精灵、动画、碰撞器、物理，见 Component::PACKED）按值存放在原型的数组中：
+     * 对象登记时从对象的槽位搬入，改变组件组合时搬到新原型，注销时搬回对象（如回到对象池）。
+     * 其他组件仍由对象持有，原型只记录指针。GameObject::getComponent 按（原型, 行号）定位紧密存储的组件。
+     *
+     * 遍历 each<T1, T2>() 时只访问包含所需组件的原型，逐行读取各数组，无需逐个对象查找组件。
+     * 动画推进、物理模拟和活动区域判定使用 each<>；渲染需要保持对象的图层顺序，仍按场景的对象容器逐个进行。
+     */
+    class ArchetypeRegistry final {
+    private:
+        std::vector<std::unique_ptr<Archetype>> archetypes_;            ///< @brief 所有原型（只增不减）
+        std::unordered_map<std::uint32_t, std::size_t> archetype_lookup_; ///< @brief 组件掩码 -> 原型下标
+
+    public:
+        ArchetypeRegistry() = default;
+        ~ArchetypeRegistry();
+
+        // 禁止拷贝和移动（游戏对象中保存了指向注册表的指针）
+        ArchetypeRegistry(const ArchetypeRegistry&) = delete;
+        ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+        ArchetypeRegistry(ArchetypeRegistry&&) = delete;
+        ArchetypeRegistry& operator=(ArchetypeRegistry&&) = delete;
+
+        void add(GameObject* game_object);          ///< @brief 注册游戏对象（按当前组件掩码放入原型，紧密存储的组件搬入原型）
+        void remove(GameObject* game_object);       ///< @brief 注销游戏对象（对象仍有的紧密存储组件搬回对象）
+        void refile(GameObject* game_object);       ///< @brief 组件增删后，把游戏对象（及其组件）移动到新的原型
+        void clear();                               ///< @brief 注销所有游戏对象
+
+        /**
+         * @brief 遍历所有同时拥有组件 Ts... 的游戏对象（跳过已标记删除的对象）。
+         * @details 例如：each<TransformComponent, SpriteComponent>([](auto& transform, auto& sprite) { ... });
+         *          遍历过程中不要增删组件或游戏对象（会改变原型的行）。
+         * @tparam Ts 需要的组件类型
+         * @param func 回调函数，参数为各组件的引用
+         */
+        template <typename... Ts, typename F>
+        void each(F&& func) {
+            static_assert(sizeof...(Ts) > 0, "至少需要一种组件类型");
+            const std::uint32_t required = ((1u << engine::component::getComponentTypeId<Ts>()) | ...);
+            for (auto& archetype : archetypes_) {
+                if ((archetype->mask & required) != required || archetype->objects.empty()) continue;
+                const auto& objects = archetype->objects;
+                const std::tuple<Archetype::View<Ts>...> views{ Archetype::View<Ts>{ *archetype }... };
+                for (std::size_t row = 0; row < objects.size(); ++row) {
+                    if (objects[row]->isNeedRemove()) continue;
+                    func(std::get<Archetype::View<Ts>>(views)[row]...);
+                }
+            }
+        }
+
+        /**
+         * @brief 统计同时拥有组件 Ts... 的游戏对象数量。
+         */
+        template <typename... Ts>
+        std::size_t count() const {
+            const std::uint32_t required = ((1u << engine::component::getComponentTypeId<Ts>()) | ...);
+            std::size_t total = 0;
+            for (const auto& archetype : archetypes_) {
+                if ((archetype->mask & required) == required) total += archetype->objects.size();
+            }
+            return total;
+        }
+
+        std::size_t getArchetypeCount() const { return archetypes_.size(); }    ///< @brief 获取原型数量
+
+    private:
+        Archetype& getOrCreateArchetype(std::uint32_t mask);    ///< @brief 获取（或创建）指定掩码的原型
+        /// @brief 把对象槽位中 mask 所含的组件加入原型末尾（紧密存储的组件搬入原型，槽位清空；其他组件记录指针）
+        static void takeComponents(Archetype& archetype, GameObject* game_object, std::uint32_t mask);
+        static void appendObject(Archetype& archetype, GameObject* game_object);   ///< @brief 在原型末尾登记对象（各列已追加）
+        static void eraseObject(Archetype& archetype, std::size_t row);            ///< @brief 删除原型的对象行（与末尾行交换，各列已删除）
+    };
+
+} // namespace engine::object
@@ -1,44 +1,113 @@
 #include "game_object.h"
+#include "archetype_registry.h"
+#include "object_arena.h"
+#include "object_index.h"
+#include "handle_table.h"
 #include "../render/renderer.h"
 #include "../input/input_manager.h" 
 #include "../render/camera.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::object {
-    GameObject::GameObject(const std::string& name, const std::string& tag) : name_(name), tag_(tag)
+    GameObject::GameObject(const std::string& name, const std::string& tag)
+        : name_id_(engine::utils::internString(name)), tag_id_(engine::utils::internString(tag)),
+        name_(&engine::utils::getInternedString(name_id_)), tag_(&engine::utils::getInternedString(tag_id_)), arena_(ObjectArena::current())
     {
-        spdlog::trace("GameObject created: {} {}", name_, tag_);
+        spdlog::trace("GameObject created: {} {}", name, tag);
+    }
+
+    void GameObject::setName(const std::string& name)
+    {
+        auto old_name = name_id_;
+        name_id_ = engine::utils::internString(name);
+        name_ = &engine::utils::getInternedString(name_id_);
+        if (object_index_ && old_name != name_id_) object_index_->rename(this, old_name);
+    }
+
+    void GameObject::setTag(const std::string& tag)
+    {
+        auto old_tag = tag_id_;
+        tag_id_ = engine::utils::internString(tag);
+        tag_ = &engine::utils::getInternedString(tag_id_);
+        if (object_index_ && old_tag != tag_id_) object_index_->retag(this, old_tag);
+    }
+
+    void* GameObject::operator new(std::size_t size)
+    {
+        return ObjectArena::allocateBlock(size, ObjectArena::current());
+    }
+
+    void GameObject::operator delete(void* ptr) noexcept
+    {
+        ObjectArena::deallocateBlock(ptr);
+    }
+
+    GameObject::~GameObject()
+    {
+        component_mask_ = 0;    // 原型数组中的组件直接随注销销毁，不必搬回对象
+        if (archetype_registry_) archetype_registry_->remove(this);
+        if (object_index_) object_index_->remove(this);
+        if (handle_table_) handle_table_->unregisterObject(this);
     }
 
     void GameObject::update(float delta_time, engine::core::Context& context) {
-        // 遍历所有组件并调用它们的 update 方法
-        for (auto& pair : components_) {
-            pair.second->update(delta_time, context);
+        // 按类型ID顺序遍历所有组件并调用它们的 update 方法（组件可能在遍历中被移除，因此每次重新检查掩码）
+        for (auto mask = component_mask_; mask != 0; mask &= mask - 1) {
+            const auto type_id = static_cast<engine::component::ComponentTypeId>(std::countr_zero(mask));
+            if (component_mask_ & (1u << type_id)) {
+                getComponentById(type_id)->update(delta_time, context);
+            }
         }
     }
 
     void GameObject::render(engine::core::Context& context) {
-        // 遍历所有组件并调用它们的 render 方法
-        for (auto& pair : components_) {
-            pair.second->render(context);
+        // 按类型ID顺序遍历所有组件并调用它们的 render 方法
+        for (auto mask = component_mask_; mask != 0; mask &= mask - 1) {
+            const auto type_id = static_cast<engine::component::ComponentTypeId>(std::countr_zero(mask));
+            if (component_mask_ & (1u << type_id)) {
+                getComponentById(type_id)->render(context);
+            }
         }
     }
 
     void GameObject::clean() {
         spdlog::trace("Cleaning GameObject...");
         // 遍历所有组件并调用它们的 clean 方法
-        for (auto& pair : components_) {
-            pair.second->clean();
+        for (auto mask = component_mask_; mask != 0; mask &= mask - 1) {
+            const auto type_id = static_cast<engine::component::ComponentTypeId>(std::countr_zero(mask));
+            if (component_mask_ & (1u << type_id)) {
+                getComponentById(type_id)->clean();
+            }
+        }
+        component_mask_ = 0;
+        if (archetype_registry_) archetype_registry_->remove(this);     // 已清理的对象不再参与遍历（原型数组中的组件随之销毁）
+        for (auto& component : components_) {
+            component.reset();      // 清空槽位, unique_ptr 会自动释放内存
         }
-        components_.clear(); // 清空 map, unique_ptr 会自动释放内存
+        if (object_index_) object_index_->remove(this);                 // 也不再能被查找到
+        if (handle_table_) handle_table_->unregisterObject(this);       // 之前发放的句柄全部失效
     }
 
     void GameObject::handleInput(engine::core::Context& context) {
-        // 遍历所有组件并调用它们的 handleInput 方法
-        for (auto& pair : components_) {
-            pair.second->handleInput(context);
+        // 按类型ID顺序遍历所有组件并调用它们的 handleInput 方法
+        for (auto mask = component_mask_; mask != 0; mask &= mask - 1) {
+            const auto type_id = static_cast<engine::component::ComponentTypeId>(std::countr_zero(mask));
+            if (component_mask_ & (1u << type_id)) {
+                getComponentById(type_id)->handleInput(context);
+            }
         }
     }
 
 
+    void GameObject::notifyComponentsChanged()
+    {
+        if (archetype_registry_) archetype_registry_->refile(this);
+    }
+
+    engine::component::Component* GameObject::getComponentById(engine::component::ComponentTypeId type_id) const
+    {
+        if (archetype_ && archetype_->packed[type_id]) return archetype_->packed[type_id]->at(archetype_row_);
+        return components_[type_id].get();
+    }
+
 } // namespace engine::object 
\ No newline at end of file
@@ -1,8 +1,15 @@
 #pragma once
 #include "../component/component.h" 
+#include "../utils/string_id.h"
+#include "archetype.h"
+#include "object_handle.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <unordered_map>
-#include <typeindex>        // 用于类型索引
+#include <string>
+#include <typeinfo>
 #include <utility>          // 用于完美转发
 #include <spdlog/spdlog.h>
 
@@ -11,23 +18,58 @@ namespace engine::core {
 }
 
 namespace engine::object {
+    class ArchetypeRegistry;
+    class ObjectArena;
+    class ObjectIndex;
+    class HandleTable;
 
     /**
      * @brief 游戏对象类，负责管理游戏对象的组件。
      *
      * 该类管理游戏对象的组件，并提供添加、获取、检查和移除组件的功能。
      * 它还提供更新和渲染游戏对象的方法。
+     * 登记到场景（原型注册表）后，紧密存储的组件（见 Component::PACKED）存放在所属原型的数组中，
+     * getComponent 按（原型, 行号）定位；未登记时所有组件都在对象自己的槽位中。
      */
     class GameObject final {
+        friend class ArchetypeRegistry;     // 需要读取组件槽位，并记录对象在原型中的位置
+        friend class ObjectIndex;           // 需要记录对象所在的索引
+        friend class HandleTable;           // 需要记录发放的句柄
+    public:
+        static constexpr std::uint32_t NO_LEVEL_ORDER = std::numeric_limits<std::uint32_t>::max();  ///< @brief 不是由关卡创建的对象的关卡顺序
+
     private:
-        std::string name_;          ///< @brief 名称
-        std::string tag_;           ///< @brief 标签
-        std::unordered_map<std::type_index, std::unique_ptr<engine::component::Component>> components_;  ///< @brief 组件列表
+        engine::utils::StringId name_id_ = engine::utils::EMPTY_STRING_ID;  ///< @brief 名称（驻留字符串ID）
+        engine::utils::StringId tag_id_ = engine::utils::EMPTY_STRING_ID;   ///< @brief 标签（驻留字符串ID）
+        const std::string* name_ = nullptr;     ///< @brief 名称字符串（指向驻留表中的元素，地址不变；设置名称时缓存，读取无需加锁）
+        const std::string* tag_ = nullptr;      ///< @brief 标签字符串（同上）
+        /// @brief 组件槽位，按组件类型ID索引（见 engine::component::getComponentTypeId）。登记到原型注册表后，紧密存储组件的槽位为空
+        std::array<std::unique_ptr<engine::component::Component>, engine::component::MAX_COMPONENT_TYPES> components_;
+        std::uint32_t component_mask_ = 0;  ///< @brief 已有组件的位掩码（第 i 位对应类型ID为 i 的槽位），按位遍历保证顺序确定
         bool need_remove_ = false;  ///< @brief 延迟删除的标识，将来由场景类负责删除
+        bool dormant_ = false;      ///< @brief 是否休眠（位于场景活动区域外，由场景每帧判定；休眠对象跳过更新、物理模拟和碰撞检测）
+        bool always_active_ = false;    ///< @brief 是否始终活跃（不参与休眠判定，例如关底触发器）
+        std::string pool_key_;      ///< @brief 所属对象池的键（为空表示不是池对象；池对象被移除时放回池中而不是销毁）
+        std::uint32_t level_order_ = NO_LEVEL_ORDER;    ///< @brief 在关卡中的先后顺序（图层顺序及图层内的对象顺序，决定按需生成的对象插入的渲染位置）
+
+        ObjectArena* arena_ = nullptr;                      ///< @brief 组件使用的内存池（构造时激活的场景内存池，可以为空）
+        ObjectHandle handle_;                               ///< @brief 句柄（由场景登记，未登记时为空句柄）
+        HandleTable* handle_table_ = nullptr;               ///< @brief 发放句柄的句柄表
+        ObjectIndex* object_index_ = nullptr;               ///< @brief 所在的名称/标签索引（由场景注册，可以为空）
+        ArchetypeRegistry* archetype_registry_ = nullptr;   ///< @brief 所在的原型注册表（由场景注册，可以为空）
+        Archetype* archetype_ = nullptr;                    ///< @brief 所在的原型（由注册表维护，未注册时为空）
+        std::size_t archetype_row_ = 0;                     ///< @brief 在原型中的行号
+        std::size_t name_index_position_ = 0;               ///< @brief 在名称索引桶中的位置（由 ObjectIndex 维护）
+        std::size_t tag_index_position_ = 0;                ///< @brief 在标签索引桶中的位置（由 ObjectIndex 维护）
 
     public:
 
         GameObject(const std::string& name = "", const std::string& tag = "");  ///< @brief 构造函数。默认名称为空，标签为空
+        ~GameObject();                                                          ///< @brief 析构函数，如果仍在原型注册表中则注销
+
+        // 游戏对象内存从当前激活的场景内存池分配（见 ObjectArena）
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr) noexcept;
 
         // 禁止拷贝和移动，确保唯一性 (通常游戏对象不应随意拷贝)
         GameObject(const GameObject&) = delete;
@@ -36,12 +78,24 @@ namespace engine::object {
         GameObject& operator=(GameObject&&) = delete;
 
         // setters and getters
-        void setName(const std::string& name) { name_ = name; }                 ///< @brief 设置名称
-        const std::string& getName() const { return name_; }                    ///< @brief 获取名称
-        void setTag(const std::string& tag) { tag_ = tag; }                     ///< @brief 设置标签
-        const std::string& getTag() const { return tag_; }                      ///< @brief 获取标签
+        void setName(const std::string& name);                                  ///< @brief 设置名称（同时更新场景索引）
+        const std::string& getName() const { return *name_; }                  ///< @brief 获取名称
+        engine::utils::StringId getNameId() const { return name_id_; }          ///< @brief 获取名称ID（比较名称时使用）
+        void setTag(const std::string& tag);                                    ///< @brief 设置标签（同时更新场景索引）
+        const std::string& getTag() const { return *tag_; }                    ///< @brief 获取标签
+        engine::utils::StringId getTagId() const { return tag_id_; }            ///< @brief 获取标签ID（比较标签时使用）
         void setNeedRemove(bool need_remove) { need_remove_ = need_remove; }    ///< @brief 设置是否需要删除
         bool isNeedRemove() const { return need_remove_; }                      ///< @brief 获取是否需要删除
+        void setDormant(bool dormant) { dormant_ = dormant && !always_active_; }///< @brief 设置是否休眠（始终活跃的对象不会休眠）
+        bool isDormant() const { return dormant_; }                             ///< @brief 获取是否休眠
+        void setAlwaysActive(bool always_active) { always_active_ = always_active; if (always_active) dormant_ = false; } ///< @brief 设置是否始终活跃
+        bool isAlwaysActive() const { return always_active_; }                  ///< @brief 获取是否始终活跃
+        void setPoolKey(const std::string& pool_key) { pool_key_ = pool_key; }  ///< @brief 设置所属对象池的键
+        const std::string& getPoolKey() const { return pool_key_; }             ///< @brief 获取所属对象池的键
+        bool isPooled() const { return !pool_key_.empty(); }                    ///< @brief 是否为池对象
+        void setLevelOrder(std::uint32_t level_order) { level_order_ = level_order; }  ///< @brief 设置关卡顺序（由关卡加载器设置）
+        std::uint32_t getLevelOrder() const { return level_order_; }            ///< @brief 获取关卡顺序
+        ObjectHandle getHandle() const { return handle_; }                      ///< @brief 获取句柄（跨帧保存对象引用时使用）
 
         /**
          * @brief 添加组件 (里面会完成组件的init())
@@ -56,20 +110,28 @@ namespace engine::object {
             // 检测组件是否合法。  /*  static_assert(condition, message)：静态断言，在编译期检测，无任何性能影响 */
                                 /* std::is_base_of<Base, Derived>::value -- 判断 Base 类型是否是 Derived 类型的基类 */
             static_assert(std::is_base_of<engine::component::Component, T>::value, "T 必须继承自 Component");
-            // 获取类型标识。     /* typeid(T) -- 用于获取一个表达式或类型的运行时类型信息 (RTTI), 返回 std::type_info& */
-                                /* std::type_index -- 针对std::type_info对象的包装器，主要设计用来作为关联容器（如 std::map）的键。*/
-            auto type_index = std::type_index(typeid(T));
+            // 获取类型ID（组件类型声明的固定ID），每个类型首次添加时检查ID没有被其他类型占用
+            constexpr auto type_id = engine::component::getComponentTypeId<T>();
+            static const bool type_id_unique = engine::component::detail::registerComponentType(type_id, typeid(T));
+            if (!type_id_unique) return nullptr;
+            if constexpr (T::PACKED) {      // 紧密存储的类型：之后创建的原型为它建立按值存放的数组
+                static const bool packed_registered = detail::registerPackedColumn(type_id, &PackedColumn<T>::make);
+                (void)packed_registered;
+            }
             // 如果组件已经存在，则直接返回组件指针
             if (hasComponent<T>()) {
                 return getComponent<T>();
             }
             // 如果不存在则创建组件     /* std::forward -- 用于实现完美转发。传递多个参数的时候使用...标识 */
-            auto new_component = std::make_unique<T>(std::forward<Args>(args)...);
-            T* ptr = new_component.get();                               // 先获取裸指针以便返回
+            // 从对象所属的场景内存池分配，与对象一起在场景清理时归还
+            auto new_component = std::unique_ptr<T>(new (arena_) T(std::forward<Args>(args)...));
             new_component->setOwner(this);                              // 设置组件的拥有者
-            components_[type_index] = std::move(new_component);         // 移动组件   （new_component 变为空，不可再使用）
-            ptr->init();                                                // 初始化组件 （因此必须用ptr而不能用new_component）
-            spdlog::debug("GameObject::addComponent: {} added component {}", name_, typeid(T).name());
+            components_[type_id] = std::move(new_component);            // 移动组件   （new_component 变为空，不可再使用）
+            component_mask_ |= 1u << type_id;                           // 标记槽位已占用
+            notifyComponentsChanged();                                  // 组件组合改变，通知原型注册表（紧密存储的组件可能被搬入原型）
+            T* ptr = getComponent<T>();                                 // 搬移之后再获取组件的位置
+            ptr->init();                                                // 初始化组件
+            spdlog::debug("GameObject::addComponent: {} added component {}", getName(), typeid(T).name());
             return ptr;                                                 // 返回非拥有指针
         }
 
@@ -82,13 +144,13 @@ namespace engine::object {
         template <typename T>
         T* getComponent() const {
             static_assert(std::is_base_of<engine::component::Component, T>::value, "T 必须继承自 Component");
-            auto type_index = std::type_index(typeid(T));
-            auto it = components_.find(type_index);
-            if (it != components_.end()) {
-                // 返回unique_ptr的裸指针。(肯定是T类型, static_cast其实并无必要，但保留可以使我们意图更清晰)
-                return static_cast<T*>(it->second.get());
+            constexpr auto type_id = engine::component::getComponentTypeId<T>();
+            // 已登记时，紧密存储的组件位于所属原型数组的第 archetype_row_ 行
+            if constexpr (T::PACKED) {
+                if (archetype_) return hasComponent<T>() ? &archetype_->packedColumn<T>()[archetype_row_] : nullptr;
             }
-            return nullptr;
+            // 其他情况直接按下标取槽位。(槽位中肯定是T类型, static_cast其实并无必要，但保留可以使我们意图更清晰)
+            return static_cast<T*>(components_[type_id].get());
         }
 
         /**
@@ -100,8 +162,8 @@ namespace engine::object {
         template <typename T>
         bool hasComponent() const {
             static_assert(std::is_base_of<engine::component::Component, T>::value, "T 必须继承自 Component");
-            // contains方法为 C++20 新增
-            return components_.contains(std::type_index(typeid(T)));
+            constexpr auto type_id = engine::component::getComponentTypeId<T>();
+            return (component_mask_ & (1u << type_id)) != 0;
         }
 
         /**
@@ -112,12 +174,12 @@ namespace engine::object {
         template <typename T>
         void removeComponent() {
             static_assert(std::is_base_of<engine::component::Component, T>::value, "T 必须继承自 Component");
-            auto type_index = std::type_index(typeid(T));
-            auto it = components_.find(type_index);
-            if (it != components_.end()) {
-                it->second->clean();
-                components_.erase(it);
-            }
+            if (!hasComponent<T>()) return;
+            constexpr auto type_id = engine::component::getComponentTypeId<T>();
+            getComponentById(type_id)->clean();
+            components_[type_id].reset();           // 在原型数组中的组件由注册表在 notifyComponentsChanged 中销毁
+            component_mask_ &= ~(1u << type_id);
+            notifyComponentsChanged();
         }
 
         // 关键循环函数
@@ -126,6 +188,11 @@ namespace engine::object {
         void clean();                                                               ///< @brief 清理所有组件
         void handleInput(engine::core::Context& context);                           ///< @brief 处理输入
 
+    private:
+        void notifyComponentsChanged();     ///< @brief 组件增删后通知原型注册表（在cpp中实现，避免头文件循环包含）
+        /// @brief 按类型ID获取组件（槽位或原型数组中），用于按掩码遍历所有组件
+        engine::component::Component* getComponentById(engine::component::ComponentTypeId type_id) const;
+
     };
 
 } // namespace engine::object
\ No newline at end of file
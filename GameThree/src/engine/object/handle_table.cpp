@@ -0,0 +1,55 @@
+#include "handle_table.h"
+#include "game_object.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::object {
+
+    ObjectHandle HandleTable::registerObject(GameObject* game_object)
+    {
+        if (!game_object) return {};
+        if (game_object->handle_table_ == this) return game_object->handle_;
+        if (game_object->handle_table_) game_object->handle_table_->unregisterObject(game_object);
+
+        std::uint32_t index = 0;
+        if (!free_slots_.empty()) {
+            index = free_slots_.front();     // 最早释放的槽位优先复用
+            free_slots_.pop_front();
+        }
+        else {
+            if (slots_.size() > ObjectHandle::INDEX_MASK) {
+                spdlog::error("HandleTable: 句柄槽位已用尽（上限 {}）。", ObjectHandle::INDEX_MASK + 1);
+                return {};
+            }
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        auto& slot = slots_[index];
+        slot.object = game_object;
+        game_object->handle_ = ObjectHandle(index, slot.generation);
+        game_object->handle_table_ = this;
+        ++live_count_;
+        return game_object->handle_;
+    }
+
+    void HandleTable::unregisterObject(GameObject* game_object)
+    {
+        if (!game_object || game_object->handle_table_ != this) return;
+        const auto index = game_object->handle_.getIndex();
+        auto& slot = slots_[index];
+        slot.object = nullptr;
+        if (slot.generation < ObjectHandle::GENERATION_MASK) {
+            ++slot.generation;      // 代数递增，使旧句柄失效
+            free_slots_.push_back(index);
+        }
+        else {
+            // 代数已用尽：回绕会让很久以前的旧句柄重新生效，因此槽位退役（保持空闲，旧句柄都解析为空指针）
+            ++retired_count_;
+            spdlog::debug("HandleTable: 槽位 {} 代数用尽，已退役（共 {} 个）。", index, retired_count_);
+        }
+        game_object->handle_ = {};
+        game_object->handle_table_ = nullptr;
+        --live_count_;
+    }
+
+} // namespace engine::object
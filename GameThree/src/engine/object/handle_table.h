@@ -0,0 +1,68 @@
+#pragma once
+#include "object_handle.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace engine::object {
+    class GameObject;
+
+    /**
+     * @brief 游戏对象句柄表，负责发放句柄并在 O(1) 时间内验证、解析句柄。
+     *
+     * 场景添加对象时为其登记句柄，对象被清理或销毁时注销（槽位代数递增，旧句柄随之失效）。
+     * 空闲槽位先进先出地复用，同一槽位两次复用之间间隔尽可能长；代数用尽的槽位不再复用（退役），
+     * 因此代数不会回绕，旧句柄永远不会解析到无关的对象。
+     * 句柄表由 GameApp 持有、通过 Context 访问，比任何场景都活得久，
+     * 因此场景切换后残留的旧句柄也只会解析为空指针。
+     */
+    class HandleTable final {
+    private:
+        /// @brief 槽位：当前占用的对象和代数
+        struct Slot {
+            GameObject* object = nullptr;       ///< @brief 占用该槽位的对象（空闲时为空）
+            std::uint32_t generation = 1;       ///< @brief 当前代数（从1开始，0保留给空句柄）
+        };
+        std::vector<Slot> slots_;               ///< @brief 所有槽位
+        std::deque<std::uint32_t> free_slots_;  ///< @brief 空闲槽位下标（先进先出）
+        std::size_t live_count_ = 0;            ///< @brief 已登记的对象数量
+        std::size_t retired_count_ = 0;         ///< @brief 代数用尽、不再复用的槽位数量
+
+    public:
+        HandleTable() = default;
+
+        // 禁止拷贝和移动（游戏对象中保存了指向句柄表的指针）
+        HandleTable(const HandleTable&) = delete;
+        HandleTable& operator=(const HandleTable&) = delete;
+        HandleTable(HandleTable&&) = delete;
+        HandleTable& operator=(HandleTable&&) = delete;
+
+        /**
+         * @brief 为游戏对象登记句柄（已登记则返回原句柄）。
+         * @param game_object 游戏对象
+         * @return ObjectHandle 句柄，槽位用尽时返回空句柄
+         */
+        ObjectHandle registerObject(GameObject* game_object);
+
+        /// @brief 注销游戏对象的句柄（槽位代数递增，之前发放的句柄全部失效；代数用尽的槽位退役）
+        void unregisterObject(GameObject* game_object);
+
+        /**
+         * @brief 解析句柄。
+         * @param handle 句柄
+         * @return GameObject* 对应的游戏对象，句柄为空或已失效时返回空指针
+         */
+        GameObject* resolve(ObjectHandle handle) const {
+            if (handle.isNull()) return nullptr;
+            auto index = handle.getIndex();
+            if (index >= slots_.size()) return nullptr;
+            const auto& slot = slots_[index];
+            return slot.generation == handle.getGeneration() ? slot.object : nullptr;
+        }
+
+        std::size_t getLiveCount() const { return live_count_; }        ///< @brief 获取已登记的对象数量
+        std::size_t getRetiredCount() const { return retired_count_; }  ///< @brief 获取已退役的槽位数量
+    };
+
+} // namespace engine::object
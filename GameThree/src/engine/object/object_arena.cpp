@@ -0,0 +1,72 @@
+#include "object_arena.h"
+#include <cstddef>
+#include <new>
+#include <spdlog/spdlog.h>
+
+namespace engine::object {
+
+    namespace {
+        /// @brief 块头：记录来源内存池和块大小（释放时不需要调用方提供尺寸）
+        struct BlockHeader {
+            ObjectArena* arena;
+            std::size_t size;
+        };
+        constexpr std::size_t BLOCK_ALIGN = alignof(std::max_align_t);
+        /// @brief 块头占用的空间，向上取整以保持对象按 max_align_t 对齐
+        constexpr std::size_t HEADER_SIZE = (sizeof(BlockHeader) + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+
+        /// @brief 超过此尺寸的对象直接从上游分配（组件通常远小于此值）
+        constexpr std::size_t LARGEST_POOLED_BLOCK = 1024;
+    }
+
+    thread_local ObjectArena* ObjectArena::current_ = nullptr;
+
+    ObjectArena::ObjectArena(std::size_t initial_size)
+        : chunks_(initial_size),
+        pools_(std::pmr::pool_options{ 0, LARGEST_POOLED_BLOCK }, &chunks_)
+    {
+        spdlog::trace("ObjectArena 创建，初始块大小 {} 字节。", initial_size);
+    }
+
+    ObjectArena::~ObjectArena()
+    {
+        if (live_blocks_ > 0) {
+            spdlog::error("ObjectArena 销毁时仍有 {} 个对象未释放。", live_blocks_);
+        }
+    }
+
+    void ObjectArena::release()
+    {
+        if (live_blocks_ > 0) {
+            spdlog::warn("ObjectArena::release: 仍有 {} 个对象未释放，跳过归还内存。", live_blocks_);
+            return;
+        }
+        pools_.release();
+        chunks_.release();
+        spdlog::trace("ObjectArena 已归还全部内存。");
+    }
+
+    void* ObjectArena::allocateBlock(std::size_t size, ObjectArena* arena)
+    {
+        auto block_size = HEADER_SIZE + size;
+        void* block = arena ? arena->pools_.allocate(block_size, BLOCK_ALIGN) : ::operator new(block_size);
+        if (arena) ++arena->live_blocks_;
+        *static_cast<BlockHeader*>(block) = { arena, block_size };     // 块头记录来源
+        return static_cast<std::byte*>(block) + HEADER_SIZE;
+    }
+
+    void ObjectArena::deallocateBlock(void* ptr) noexcept
+    {
+        if (!ptr) return;
+        void* block = static_cast<std::byte*>(ptr) - HEADER_SIZE;
+        auto header = *static_cast<BlockHeader*>(block);
+        if (auto* arena = header.arena) {
+            arena->pools_.deallocate(block, header.size, BLOCK_ALIGN);
+            --arena->live_blocks_;
+        }
+        else {
+            ::operator delete(block);
+        }
+    }
+
+} // namespace engine::object
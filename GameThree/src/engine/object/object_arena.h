@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+namespace engine::object {
+
+    /**
+     * @brief 场景级对象内存池，为 GameObject 和组件提供内存。
+     *
+     * 内部由两层组成：按尺寸分级的内存池（小块，释放后可复用）和其上游的单调缓冲区（成批向系统申请大块内存）。
+     * 关卡加载时的大量对象因此只对应少数几次系统分配，场景清理时调用 release() 一次性归还全部内存。
+     *
+     * 使用方式：SceneManager 在调用场景的 init/update/handleInput 前用 Scope 激活该场景的内存池，
+     * 期间创建的 GameObject（及其之后添加的组件）都从该内存池分配。没有激活内存池时退回全局堆。
+     * 每个内存块头部记录了来源内存池和块大小，因此释放时不需要知道当前激活的是哪个内存池。
+     *
+     * 注意：对象不应在场景之间转移，其内存池必须比对象活得更久。
+     */
+    class ObjectArena final {
+    private:
+        std::pmr::monotonic_buffer_resource chunks_;    ///< @brief 上游：成批申请的大块内存，只在 release() 时归还
+        std::pmr::unsynchronized_pool_resource pools_;  ///< @brief 按尺寸分级的内存池（单线程使用）
+        std::size_t live_blocks_ = 0;                   ///< @brief 尚未释放的内存块数量（用于检查泄漏）
+
+        static thread_local ObjectArena* current_;      ///< @brief 当前线程激活的内存池
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param initial_size 第一块内存的大小（字节），之后的内存块按几何级数增长
+         */
+        explicit ObjectArena(std::size_t initial_size = 64 * 1024);
+        ~ObjectArena();
+
+        // 禁止拷贝和移动（内存块头部保存了内存池地址）
+        ObjectArena(const ObjectArena&) = delete;
+        ObjectArena& operator=(const ObjectArena&) = delete;
+        ObjectArena(ObjectArena&&) = delete;
+        ObjectArena& operator=(ObjectArena&&) = delete;
+
+        /// @brief 一次性归还全部内存。调用前应先销毁所有从该内存池分配的对象
+        void release();
+
+        std::size_t getLiveBlocks() const { return live_blocks_; }     ///< @brief 获取尚未释放的内存块数量
+
+        /// @brief 获取当前线程激活的内存池（可能为空）
+        static ObjectArena* current() { return current_; }
+
+        /**
+         * @brief 分配一个内存块（由 GameObject / Component 的 operator new 调用）。
+         * @param size 对象尺寸
+         * @param arena 来源内存池，为空时使用全局堆
+         * @return 对象地址（块头之后）
+         */
+        static void* allocateBlock(std::size_t size, ObjectArena* arena);
+
+        /**
+         * @brief 释放 allocateBlock 分配的内存块（由 GameObject / Component 的 operator delete 调用）。
+         * @param ptr 对象地址（块头中记录了来源内存池和块大小）
+         */
+        static void deallocateBlock(void* ptr) noexcept;
+
+        /**
+         * @brief 在作用域内激活指定的内存池，离开作用域时恢复之前的内存池（可嵌套）。
+         */
+        class Scope final {
+            ObjectArena* previous_;     ///< @brief 之前激活的内存池
+        public:
+            explicit Scope(ObjectArena* arena) : previous_(current_) { current_ = arena; }
+            ~Scope() { current_ = previous_; }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator=(Scope&&) = delete;
+        };
+    };
+
+} // namespace engine::object
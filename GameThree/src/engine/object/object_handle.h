@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+namespace engine::object {
+
+    /**
+     * @brief 游戏对象句柄：32 位，低 20 位为句柄表槽位下标，高 12 位为代数（generation）。
+     *
+     * 对象销毁后槽位的代数递增，旧句柄解析时代数不匹配，得到空指针而不是悬空指针。
+     * 因此句柄可以跨帧保存、放入事件队列或交给其他线程，使用前通过 HandleTable::resolve() 验证。
+     * 代数 0 保留给空句柄（value == 0）。
+     */
+    struct ObjectHandle {
+        static constexpr std::uint32_t INDEX_BITS = 20;                                 ///< @brief 槽位下标位数
+        static constexpr std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;             ///< @brief 槽位下标掩码
+        static constexpr std::uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1; ///< @brief 代数掩码（移位后）
+
+        std::uint32_t value = 0;    ///< @brief 句柄值（0 表示空句柄）
+
+        constexpr ObjectHandle() = default;
+        constexpr ObjectHandle(std::uint32_t index, std::uint32_t generation)
+            : value((index & INDEX_MASK) | ((generation & GENERATION_MASK) << INDEX_BITS)) {}
+
+        constexpr std::uint32_t getIndex() const { return value & INDEX_MASK; }                         ///< @brief 获取槽位下标
+        constexpr std::uint32_t getGeneration() const { return (value >> INDEX_BITS) & GENERATION_MASK; } ///< @brief 获取代数
+        constexpr bool isNull() const { return value == 0; }                                            ///< @brief 是否为空句柄
+        constexpr explicit operator bool() const { return value != 0; }
+
+        friend constexpr bool operator==(ObjectHandle a, ObjectHandle b) { return a.value == b.value; }
+    };
+
+} // namespace engine::object
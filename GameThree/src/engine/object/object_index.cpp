@@ -0,0 +1,85 @@
+#include "object_index.h"
+#include "game_object.h"
+
+namespace engine::object {
+
+    ObjectIndex::~ObjectIndex()
+    {
+        clear();
+    }
+
+    void ObjectIndex::add(GameObject* game_object)
+    {
+        if (!game_object || game_object->object_index_ == this) return;
+        if (game_object->object_index_) game_object->object_index_->remove(game_object);
+        game_object->object_index_ = this;
+        insert(by_name_, game_object->getNameId(), game_object, &GameObject::name_index_position_);
+        insert(by_tag_, game_object->getTagId(), game_object, &GameObject::tag_index_position_);
+    }
+
+    void ObjectIndex::remove(GameObject* game_object)
+    {
+        if (!game_object || game_object->object_index_ != this) return;
+        erase(by_name_, game_object->getNameId(), game_object, &GameObject::name_index_position_);
+        erase(by_tag_, game_object->getTagId(), game_object, &GameObject::tag_index_position_);
+        game_object->object_index_ = nullptr;
+    }
+
+    void ObjectIndex::clear()
+    {
+        for (auto& [name, bucket] : by_name_) {
+            for (auto* game_object : bucket) game_object->object_index_ = nullptr;
+        }
+        by_name_.clear();
+        by_tag_.clear();
+    }
+
+    void ObjectIndex::rename(GameObject* game_object, engine::utils::StringId old_name)
+    {
+        if (!game_object || game_object->object_index_ != this) return;
+        erase(by_name_, old_name, game_object, &GameObject::name_index_position_);
+        insert(by_name_, game_object->getNameId(), game_object, &GameObject::name_index_position_);
+    }
+
+    void ObjectIndex::retag(GameObject* game_object, engine::utils::StringId old_tag)
+    {
+        if (!game_object || game_object->object_index_ != this) return;
+        erase(by_tag_, old_tag, game_object, &GameObject::tag_index_position_);
+        insert(by_tag_, game_object->getTagId(), game_object, &GameObject::tag_index_position_);
+    }
+
+    GameObject* ObjectIndex::findByName(engine::utils::StringId name) const
+    {
+        auto it = by_name_.find(name);
+        return it != by_name_.end() && !it->second.empty() ? it->second.front() : nullptr;
+    }
+
+    GameObject* ObjectIndex::findByTag(engine::utils::StringId tag) const
+    {
+        auto it = by_tag_.find(tag);
+        return it != by_tag_.end() && !it->second.empty() ? it->second.front() : nullptr;
+    }
+
+    void ObjectIndex::insert(std::unordered_map<engine::utils::StringId, Bucket>& map, engine::utils::StringId key,
+        GameObject* game_object, PositionField position)
+    {
+        auto& bucket = map[key];
+        game_object->*position = bucket.size();
+        bucket.push_back(game_object);
+    }
+
+    void ObjectIndex::erase(std::unordered_map<engine::utils::StringId, Bucket>& map, engine::utils::StringId key,
+        GameObject* game_object, PositionField position)
+    {
+        auto it = map.find(key);
+        if (it == map.end()) return;
+        auto& bucket = it->second;
+        const auto index = game_object->*position;
+        if (index >= bucket.size() || bucket[index] != game_object) return;    // 不在该桶中（不应发生）
+        // 与末尾元素交换后删除末尾元素，被交换的对象记下新位置（空桶保留，同名对象通常会再次出现）
+        bucket[index] = bucket.back();
+        bucket[index]->*position = index;
+        bucket.pop_back();
+    }
+
+} // namespace engine::object
@@ -0,0 +1,67 @@
+#pragma once
+#include "../utils/string_id.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::object {
+    class GameObject;
+
+    /**
+     * @brief 场景中游戏对象的名称/标签索引（基于驻留字符串ID）。
+     *
+     * 按名称或标签查找对象只需一次哈希查找，不再遍历整个对象容器、逐个比较字符串。
+     * 每个名称/标签对应一个对象数组，对象记住自己在数组中的位置，移出索引时与末尾元素交换后删除，
+     * 因此即使大量对象共用同一名称或标签（空字符串、"enemy"、池化特效），移除一个对象也是 O(1)。
+     * 对象改名或改标签时 GameObject 会通知索引更新。
+     */
+    class ObjectIndex final {
+    private:
+        using Bucket = std::vector<GameObject*>;    ///< @brief 同一名称/标签的所有对象（无序）
+        using PositionField = std::size_t GameObject::*;    ///< @brief GameObject 中记录其在桶中位置的成员
+
+        std::unordered_map<engine::utils::StringId, Bucket> by_name_;  ///< @brief 名称ID -> 游戏对象
+        std::unordered_map<engine::utils::StringId, Bucket> by_tag_;   ///< @brief 标签ID -> 游戏对象
+
+    public:
+        ObjectIndex() = default;
+        ~ObjectIndex();
+
+        // 禁止拷贝和移动（游戏对象中保存了指向索引的指针）
+        ObjectIndex(const ObjectIndex&) = delete;
+        ObjectIndex& operator=(const ObjectIndex&) = delete;
+        ObjectIndex(ObjectIndex&&) = delete;
+        ObjectIndex& operator=(ObjectIndex&&) = delete;
+
+        void add(GameObject* game_object);          ///< @brief 将游戏对象加入索引
+        void remove(GameObject* game_object);       ///< @brief 将游戏对象移出索引（O(1)）
+        void clear();                               ///< @brief 清空索引
+
+        void rename(GameObject* game_object, engine::utils::StringId old_name);  ///< @brief 游戏对象改名后更新索引
+        void retag(GameObject* game_object, engine::utils::StringId old_tag);    ///< @brief 游戏对象改标签后更新索引
+
+        GameObject* findByName(engine::utils::StringId name) const;     ///< @brief 根据名称查找游戏对象（返回找到的任意一个）
+        GameObject* findByTag(engine::utils::StringId tag) const;       ///< @brief 根据标签查找游戏对象（返回找到的任意一个）
+
+        /**
+         * @brief 遍历具有指定标签的所有游戏对象（遍历过程中不要增删对象）。
+         * @param tag 标签ID
+         * @param func 回调函数，参数为 GameObject*
+         */
+        template <typename F>
+        void forEachWithTag(engine::utils::StringId tag, F&& func) const {
+            auto it = by_tag_.find(tag);
+            if (it == by_tag_.end()) return;
+            for (auto* game_object : it->second) func(game_object);
+        }
+
+    private:
+        /// @brief 把对象追加到键对应的桶，并记录其位置
+        static void insert(std::unordered_map<engine::utils::StringId, Bucket>& map, engine::utils::StringId key,
+            GameObject* game_object, PositionField position);
+        /// @brief 把对象从键对应的桶中删除（与末尾元素交换，更新被交换对象的位置）
+        static void erase(std::unordered_map<engine::utils::StringId, Bucket>& map, engine::utils::StringId key,
+            GameObject* game_object, PositionField position);
+    };
+
+} // namespace engine::object
@@ -0,0 +1,51 @@
+#include "collider.h"
+#include <algorithm>
+#include <glm/common.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::physics {
+
+    PolygonCollider::PolygonCollider(const std::vector<glm::vec2>& points)
+    {
+        // --- 使用单调链算法（Andrew's monotone chain）计算凸包 ---
+        std::vector<glm::vec2> sorted = points;
+        std::sort(sorted.begin(), sorted.end(), [](const glm::vec2& a, const glm::vec2& b) {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+            });
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        if (sorted.size() < 3) {
+            spdlog::error("PolygonCollider 至少需要3个不重复的顶点，当前只有 {} 个。", sorted.size());
+            points_ = std::move(sorted);
+        }
+        else {
+            // 叉积：判断 o->a->b 是否为逆时针转向
+            auto cross = [](const glm::vec2& o, const glm::vec2& a, const glm::vec2& b) {
+                return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+                };
+            std::vector<glm::vec2> hull(sorted.size() * 2);
+            size_t k = 0;
+            for (const auto& p : sorted) {                          // 下凸包
+                while (k >= 2 && cross(hull[k - 2], hull[k - 1], p) <= 0.0f) --k;
+                hull[k++] = p;
+            }
+            for (size_t i = sorted.size() - 1, t = k + 1; i > 0; --i) {    // 上凸包
+                const auto& p = sorted[i - 1];
+                while (k >= t && cross(hull[k - 2], hull[k - 1], p) <= 0.0f) --k;
+                hull[k++] = p;
+            }
+            hull.resize(k - 1);     // 最后一个点与第一个点重复
+            if (hull.size() != sorted.size()) {
+                spdlog::warn("PolygonCollider 传入的多边形不是凸多边形，已使用其凸包。");
+            }
+            points_ = std::move(hull);
+        }
+
+        // 包围盒尺寸 = 顶点坐标的最大值（顶点相对于包围盒左上角）
+        glm::vec2 max_point = { 0.0f, 0.0f };
+        for (const auto& p : points_) {
+            max_point = glm::max(max_point, p);
+        }
+        setAABBSize(max_point);
+    }
+
+} // namespace engine::physics
@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 #include <glm/vec2.hpp>
 
 namespace engine::physics {
@@ -10,7 +11,9 @@ namespace engine::physics {
         NONE,
         AABB,
         CIRCLE,
-        // 未来可能添加其他类型，如 Capsule, Polygon 等
+        CAPSULE,
+        POLYGON,
+        COUNT       ///< @brief 类型数量（用于碰撞检测函数表），不是有效类型
     };
 
     /**
@@ -71,4 +74,50 @@ namespace engine::physics {
         void setRadius(float radius) { radius_ = radius; }
     };
 
+    /**
+     * @brief 胶囊碰撞器。
+     *
+     * 由包围盒尺寸决定：半径为较短边的一半，中心线段沿较长边方向。
+     * （宽高相等时退化为圆形）
+     */
+    class CapsuleCollider final : public Collider {
+    private:
+        glm::vec2 size_ = { 0.0f, 0.0f };  ///< @brief 胶囊的包围盒尺寸（和aabb_size_相同）。
+
+    public:
+        /**
+         * @brief 构造函数。
+         * @param size 胶囊包围盒的宽度和高度。
+         */
+        explicit CapsuleCollider(const glm::vec2& size) : size_(size) { setAABBSize(size); }
+        ~CapsuleCollider() override = default;
+
+        // --- Getters and Setters ---
+        ColliderType getType() const override { return ColliderType::CAPSULE; }
+        const glm::vec2& getSize() const { return size_; }
+        void setSize(const glm::vec2& size) { size_ = size; setAABBSize(size); }
+    };
+
+    /**
+     * @brief 凸多边形碰撞器。
+     *
+     * 顶点坐标相对于包围盒左上角（非负）。构造时会计算凸包，保证顶点按顺序排列且为凸多边形。
+     */
+    class PolygonCollider final : public Collider {
+    private:
+        std::vector<glm::vec2> points_;     ///< @brief 凸包顶点（相对于包围盒左上角，按顺序排列）
+
+    public:
+        /**
+         * @brief 构造函数。
+         * @param points 多边形顶点（相对于包围盒左上角）。非凸时使用其凸包。
+         */
+        explicit PolygonCollider(const std::vector<glm::vec2>& points);
+        ~PolygonCollider() override = default;
+
+        // --- Getters ---
+        ColliderType getType() const override { return ColliderType::POLYGON; }
+        const std::vector<glm::vec2>& getPoints() const { return points_; }
+    };
+
 } // namespace engine::physics
\ No newline at end of file
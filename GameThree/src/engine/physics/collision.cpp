@@ -1,9 +1,228 @@
 #include "collision.h"
+#include "collider.h"
 #include "../component/collider_component.h"
 #include "../component/transform_component.h"
+#include <array>
+#include <limits>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 
 namespace engine::physics::collision {
 
+    namespace {
+        /**
+         * @brief 碰撞器在世界坐标系下的视图（不拷贝顶点，按需计算）。
+         */
+        struct ShapeView {
+            const Collider* collider;   ///< @brief 碰撞器
+            glm::vec2 pos;              ///< @brief 最小包围盒左上角的世界坐标
+            glm::vec2 size;             ///< @brief 缩放后的最小包围盒尺寸
+            glm::vec2 scale;            ///< @brief 缩放
+        };
+
+        /// @brief 窄相检测函数类型（调用前已经通过了最小包围盒检测）
+        using NarrowphaseFunc = bool(*)(const ShapeView&, const ShapeView&);
+
+        // --- 形状参数的获取 ---
+
+        glm::vec2 getCircleCenter(const ShapeView& s) { return s.pos + 0.5f * s.size; }
+        float getCircleRadius(const ShapeView& s) { return 0.5f * s.size.x; }     // 圆的半径等于AABB的一半宽度
+
+        /// @brief 获取胶囊的中心线段端点及半径
+        void getCapsuleSegment(const ShapeView& s, glm::vec2& p0, glm::vec2& p1, float& radius) {
+            if (s.size.x >= s.size.y) {     // 水平胶囊
+                radius = 0.5f * s.size.y;
+                p0 = s.pos + glm::vec2(radius, radius);
+                p1 = s.pos + glm::vec2(s.size.x - radius, radius);
+            }
+            else {                          // 竖直胶囊
+                radius = 0.5f * s.size.x;
+                p0 = s.pos + glm::vec2(radius, radius);
+                p1 = s.pos + glm::vec2(radius, s.size.y - radius);
+            }
+        }
+
+        /// @brief 凸多边形顶点数量（AABB视为4个顶点的多边形）
+        size_t getVertexCount(const ShapeView& s) {
+            if (s.collider->getType() == ColliderType::POLYGON) {
+                return static_cast<const PolygonCollider*>(s.collider)->getPoints().size();
+            }
+            return 4;
+        }
+
+        /// @brief 凸多边形第 i 个顶点的世界坐标（顺序排列）
+        glm::vec2 getVertex(const ShapeView& s, size_t i) {
+            if (s.collider->getType() == ColliderType::POLYGON) {
+                return s.pos + static_cast<const PolygonCollider*>(s.collider)->getPoints()[i] * s.scale;
+            }
+            switch (i) {
+            case 0:  return s.pos;
+            case 1:  return s.pos + glm::vec2(s.size.x, 0.0f);
+            case 2:  return s.pos + s.size;
+            default: return s.pos + glm::vec2(0.0f, s.size.y);
+            }
+        }
+
+        // --- 基础几何运算 (全部使用平方距离，不开方) ---
+
+        float cross(const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; }
+
+        /// @brief 点到线段的最近距离的平方
+        float distanceSquaredPointSegment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+            auto ab = b - a;
+            auto len_sq = glm::dot(ab, ab);
+            auto t = len_sq > 0.0f ? glm::clamp(glm::dot(p - a, ab) / len_sq, 0.0f, 1.0f) : 0.0f;
+            auto d = p - (a + ab * t);
+            return glm::dot(d, d);
+        }
+
+        /// @brief 判断两条线段是否相交
+        bool segmentsIntersect(const glm::vec2& a0, const glm::vec2& a1, const glm::vec2& b0, const glm::vec2& b1) {
+            auto d1 = cross(a1 - a0, b0 - a0);
+            auto d2 = cross(a1 - a0, b1 - a0);
+            auto d3 = cross(b1 - b0, a0 - b0);
+            auto d4 = cross(b1 - b0, a1 - b0);
+            return ((d1 > 0.0f) != (d2 > 0.0f)) && ((d3 > 0.0f) != (d4 > 0.0f));
+        }
+
+        /// @brief 两条线段之间最近距离的平方
+        float distanceSquaredSegmentSegment(const glm::vec2& a0, const glm::vec2& a1, const glm::vec2& b0, const glm::vec2& b1) {
+            if (segmentsIntersect(a0, a1, b0, b1)) return 0.0f;
+            return glm::min(glm::min(distanceSquaredPointSegment(a0, b0, b1), distanceSquaredPointSegment(a1, b0, b1)),
+                glm::min(distanceSquaredPointSegment(b0, a0, a1), distanceSquaredPointSegment(b1, a0, a1)));
+        }
+
+        /// @brief 判断点是否在凸多边形内（与所有边的叉积同号）
+        bool pointInConvex(const glm::vec2& p, const ShapeView& poly) {
+            auto count = getVertexCount(poly);
+            if (count < 3) return false;
+            bool has_pos = false, has_neg = false;
+            for (size_t i = 0; i < count; ++i) {
+                auto a = getVertex(poly, i);
+                auto b = getVertex(poly, (i + 1) % count);
+                auto c = cross(b - a, p - a);
+                has_pos |= c > 0.0f;
+                has_neg |= c < 0.0f;
+                if (has_pos && has_neg) return false;
+            }
+            return true;
+        }
+
+        /// @brief 线段到凸多边形最近距离的平方（相交或包含时为0）
+        float distanceSquaredSegmentConvex(const glm::vec2& p0, const glm::vec2& p1, const ShapeView& poly) {
+            if (pointInConvex(p0, poly)) return 0.0f;
+            auto count = getVertexCount(poly);
+            float min_dist_sq = std::numeric_limits<float>::max();
+            for (size_t i = 0; i < count; ++i) {
+                auto a = getVertex(poly, i);
+                auto b = getVertex(poly, (i + 1) % count);
+                min_dist_sq = glm::min(min_dist_sq, distanceSquaredSegmentSegment(p0, p1, a, b));
+                if (min_dist_sq <= 0.0f) break;
+            }
+            return min_dist_sq;
+        }
+
+        /// @brief 将凸多边形投影到轴上，得到区间 [min, max]
+        void projectConvex(const ShapeView& poly, const glm::vec2& axis, float& min, float& max) {
+            min = max = glm::dot(getVertex(poly, 0), axis);
+            auto count = getVertexCount(poly);
+            for (size_t i = 1; i < count; ++i) {
+                auto d = glm::dot(getVertex(poly, i), axis);
+                min = glm::min(min, d);
+                max = glm::max(max, d);
+            }
+        }
+
+        /// @brief 以 a 的各条边法线为分离轴检测（轴不需要归一化）
+        bool hasSeparatingAxis(const ShapeView& a, const ShapeView& b) {
+            auto count = getVertexCount(a);
+            for (size_t i = 0; i < count; ++i) {
+                auto edge = getVertex(a, (i + 1) % count) - getVertex(a, i);
+                auto axis = glm::vec2(-edge.y, edge.x);
+                float a_min, a_max, b_min, b_max;
+                projectConvex(a, axis, a_min, a_max);
+                projectConvex(b, axis, b_min, b_max);
+                if (a_max <= b_min || b_max <= a_min) return true;
+            }
+            return false;
+        }
+
+        // --- 各类型组合的窄相检测函数 ---
+
+        bool never(const ShapeView&, const ShapeView&) { return false; }
+
+        // AABB vs AABB, 最小包围盒已经重叠，直接返回真
+        bool aabbVsAabb(const ShapeView&, const ShapeView&) { return true; }
+
+        // Circle vs Circle: 判断两个圆心距离的平方是否小于半径之和的平方
+        bool circleVsCircle(const ShapeView& a, const ShapeView& b) {
+            return checkCircleOverlap(getCircleCenter(a), getCircleRadius(a), getCircleCenter(b), getCircleRadius(b));
+        }
+
+        // AABB vs Circle: 判断圆心到AABB的最邻近点是否在圆内
+        bool aabbVsCircle(const ShapeView& a, const ShapeView& b) {
+            auto center = getCircleCenter(b);
+            auto nearest_point = glm::clamp(center, a.pos, a.pos + a.size);
+            return checkPointInCircle(nearest_point, center, getCircleRadius(b));
+        }
+
+        // Capsule vs Circle: 圆心到胶囊中心线段的距离
+        bool capsuleVsCircle(const ShapeView& a, const ShapeView& b) {
+            glm::vec2 p0, p1;
+            float radius;
+            getCapsuleSegment(a, p0, p1, radius);
+            auto sum = radius + getCircleRadius(b);
+            return distanceSquaredPointSegment(getCircleCenter(b), p0, p1) < sum * sum;
+        }
+
+        // Capsule vs Capsule: 两条中心线段的距离
+        bool capsuleVsCapsule(const ShapeView& a, const ShapeView& b) {
+            glm::vec2 a0, a1, b0, b1;
+            float a_radius, b_radius;
+            getCapsuleSegment(a, a0, a1, a_radius);
+            getCapsuleSegment(b, b0, b1, b_radius);
+            auto sum = a_radius + b_radius;
+            return distanceSquaredSegmentSegment(a0, a1, b0, b1) < sum * sum;
+        }
+
+        // Convex (AABB/Polygon) vs Convex: 分离轴定理 (SAT)
+        bool convexVsConvex(const ShapeView& a, const ShapeView& b) {
+            if (getVertexCount(a) < 3 || getVertexCount(b) < 3) return false;
+            return !hasSeparatingAxis(a, b) && !hasSeparatingAxis(b, a);
+        }
+
+        // Convex vs Circle: 圆心在多边形内，或圆心到多边形的距离小于半径
+        bool convexVsCircle(const ShapeView& a, const ShapeView& b) {
+            auto center = getCircleCenter(b);
+            auto radius = getCircleRadius(b);
+            return distanceSquaredSegmentConvex(center, center, a) < radius * radius;
+        }
+
+        // Convex vs Capsule: 胶囊中心线段到多边形的距离小于半径
+        bool convexVsCapsule(const ShapeView& a, const ShapeView& b) {
+            glm::vec2 p0, p1;
+            float radius;
+            getCapsuleSegment(b, p0, p1, radius);
+            return distanceSquaredSegmentConvex(p0, p1, a) < radius * radius;
+        }
+
+        /// @brief 交换参数顺序的包装，用于填充函数表的对称位置
+        template <NarrowphaseFunc F>
+        bool swapped(const ShapeView& a, const ShapeView& b) { return F(b, a); }
+
+        constexpr size_t TYPE_COUNT = static_cast<size_t>(ColliderType::COUNT);
+
+        /// @brief 类型对 -> 窄相检测函数（行：a的类型，列：b的类型；顺序同 ColliderType）
+        constexpr std::array<std::array<NarrowphaseFunc, TYPE_COUNT>, TYPE_COUNT> NARROWPHASE_TABLE = { {
+            //  NONE    AABB                        CIRCLE                      CAPSULE                     POLYGON
+            {   never,  never,                      never,                      never,                      never },                    // NONE
+            {   never,  aabbVsAabb,                 aabbVsCircle,               convexVsCapsule,            convexVsConvex },           // AABB
+            {   never,  swapped<aabbVsCircle>,      circleVsCircle,             swapped<capsuleVsCircle>,   swapped<convexVsCircle> },  // CIRCLE
+            {   never,  swapped<convexVsCapsule>,   capsuleVsCircle,            capsuleVsCapsule,           swapped<convexVsCapsule> }, // CAPSULE
+            {   never,  convexVsConvex,             convexVsCircle,             convexVsCapsule,            convexVsConvex },           // POLYGON
+        } };
+    }
+
     bool checkCollision(const engine::component::ColliderComponent& a, const engine::component::ColliderComponent& b) {
         // 获取两个碰撞盒及对应Transform信息
         auto a_collider = a.getCollider();
@@ -20,42 +239,22 @@ namespace engine::physics::collision {
             return false;
         }
 
-        // --- 如果最小包围盒有碰撞，再进行更细致的判断 ---
-        // AABB vs AABB, 直接返回真
-        if (a_collider->getType() == engine::physics::ColliderType::AABB && b_collider->getType() == engine::physics::ColliderType::AABB) {
-            return true;
-        }
-        // Circle vs Circle: 判断两个圆心距离是否小于两个圆的半径之和
-        else if (a_collider->getType() == engine::physics::ColliderType::CIRCLE && b_collider->getType() == engine::physics::ColliderType::CIRCLE)
-        {
-            auto a_center = a_pos + 0.5f * a_size;  // 圆心位置
-            auto b_center = b_pos + 0.5f * b_size;
-            auto a_radius = 0.5f * a_size.x;        // 圆的半径等于AABB的一半宽度
-            auto b_radius = 0.5f * b_size.x;
-            return checkCircleOverlap(a_center, a_radius, b_center, b_radius);
+        // --- 如果最小包围盒有碰撞，再根据类型对查表，进行更细致的判断 ---
+        auto a_type = static_cast<size_t>(a_collider->getType());
+        auto b_type = static_cast<size_t>(b_collider->getType());
+        if (a_type >= TYPE_COUNT || b_type >= TYPE_COUNT) {
+            return false;
         }
-        // AABB vs Circle: 判断圆心到AABB的最邻近点是否在圆内
-        else if (a_collider->getType() == engine::physics::ColliderType::AABB && b_collider->getType() == engine::physics::ColliderType::CIRCLE)
-        {
-            auto b_center = b_pos + 0.5f * b_size;
-            auto b_radius = 0.5f * b_size.x;
-            auto nearest_point = glm::clamp(b_center, a_pos, a_pos + a_size);   // 计算圆心到AABB的最邻近点
-            return checkPointInCircle(nearest_point, b_center, b_radius);
-        }
-        // Circle vs AABB
-        else if (a_collider->getType() == engine::physics::ColliderType::CIRCLE && b_collider->getType() == engine::physics::ColliderType::AABB)
-        {
-            auto a_center = a_pos + 0.5f * a_size;
-            auto a_radius = 0.5f * a_size.x;
-            auto nearest_point = glm::clamp(a_center, b_pos, b_pos + b_size);   // 计算圆心到AABB的最邻近点
-            return checkPointInCircle(nearest_point, a_center, a_radius);
-        }
-        return false;
+        return NARROWPHASE_TABLE[a_type][b_type](
+            ShapeView{ a_collider, a_pos, a_size, a_transform->getScale() },
+            ShapeView{ b_collider, b_pos, b_size, b_transform->getScale() });
     }
 
     bool checkCircleOverlap(const glm::vec2& a_center, const float a_radius, const glm::vec2& b_center, const float b_radius)
     {
-        return (glm::length(a_center - b_center) < a_radius + b_radius);
+        auto d = a_center - b_center;
+        auto sum = a_radius + b_radius;
+        return (glm::dot(d, d) < sum * sum);
     }
 
     bool checkAABBOverlap(const glm::vec2& a_pos, const glm::vec2& a_size, const glm::vec2& b_pos, const glm::vec2& b_size) {
@@ -73,7 +272,8 @@ namespace engine::physics::collision {
 
     bool checkPointInCircle(const glm::vec2& point, const glm::vec2& center, const float radius)
     {
-        return (glm::length(point - center) < radius);
+        auto d = point - center;
+        return (glm::dot(d, d) < radius * radius);
     }
 
-} // namespace engine::physics::collision 
\ No newline at end of file
+} // namespace engine::physics::collision
@@ -9,6 +9,8 @@ namespace engine::physics::collision {
 
 	/**
 	 * @brief 检查两个碰撞器组件是否重叠。
+	 *
+	 * 先进行最小包围盒检测，重叠后再根据两者的碰撞器类型查表，调用对应的窄相检测函数。
 	 * @param a 第一个碰撞器组件。
 	 * @param b 第二个碰撞器组件。
 	 * @return true 如果碰撞器组件重叠，否则为 false。
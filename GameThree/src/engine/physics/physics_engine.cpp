@@ -5,48 +5,76 @@
 #include "../component/collider_component.h"
 #include "../component/tilelayer_component.h"
 #include "../object/game_object.h"
-#include <set>
+#include "../object/archetype_registry.h"
+#include "../utils/string_id.h"
+#include "../utils/thread_pool.h"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <spdlog/spdlog.h>
 #include <glm/common.hpp>
 
 namespace engine::physics {
 
-    void PhysicsEngine::registerComponent(engine::component::PhysicsComponent* component) {
-        components_.push_back(component);
-        spdlog::trace("物理组件注册完成。");
-    }
-
-    void PhysicsEngine::unregisterComponent(engine::component::PhysicsComponent* component) {
-        // 使用 remove-erase 方法安全地移除指针
-        auto it = std::remove(components_.begin(), components_.end(), component);
-        components_.erase(it, components_.end());
-        spdlog::trace("物理组件注销完成。");
+    namespace {
+        /// @brief 需要生成触发事件的瓦片特性（梯子由物理引擎自己处理，不记录事件）
+        constexpr std::uint8_t TRIGGER_TRAITS = engine::component::tile_trait::HAZARD;
+
+        /// @brief 特性位序号 -> 触发事件中的瓦片类型 (只有 TRIGGER_TRAITS 中的位会被查询)
+        constexpr std::array<engine::component::TileType, 8> TRAIT_BIT_TO_TYPE = {
+            engine::component::TileType::SOLID,
+            engine::component::TileType::UNISOLID,
+            engine::component::TileType::SLOPE_0_1,
+            engine::component::TileType::HAZARD,
+            engine::component::TileType::LADDER,
+            engine::component::TileType::EMPTY,
+            engine::component::TileType::EMPTY,
+            engine::component::TileType::EMPTY,
+        };
+
+        /// @brief "solid" 标签的ID（静态固体对象）
+        const engine::utils::StringId SOLID_TAG = engine::utils::internString("solid");
+
+        /// @brief 获取瓦片类型（空指针视为空白瓦片）
+        engine::component::TileType getTileType(const engine::component::TileInfo* tile) {
+            return tile ? tile->type : engine::component::TileType::EMPTY;
+        }
     }
 
     void PhysicsEngine::registerCollisionLayer(engine::component::TileLayerComponent* layer)
     {
         layer->setPhysicsEngine(this); // 设置物理引擎指针
         collision_tile_layers_.push_back(layer);
+        rebuildTileTraitGrid();
         spdlog::trace("碰撞瓦片图层注册完成。");
     }
 
     void PhysicsEngine::unregisterCollisionLayer(engine::component::TileLayerComponent* layer) {
         auto it = std::remove(collision_tile_layers_.begin(), collision_tile_layers_.end(), layer);
         collision_tile_layers_.erase(it, collision_tile_layers_.end());
+        rebuildTileTraitGrid();
         spdlog::trace("碰撞瓦片图层注销完成。");
     }
 
-    void PhysicsEngine::update(float delta_time) {
+    void PhysicsEngine::update(float delta_time, engine::object::ArchetypeRegistry& registry) {
         // 每帧开始时先清空碰撞对列表和瓦片触发事件列表
         collision_pairs_.clear();
         tile_trigger_events_.clear();
 
-        // 遍历所有注册的物理组件
-        for (auto* pc : components_) {
-            if (!pc || !pc->isEnabled()) { // 检查组件是否有效和启用
-                continue;
-            }
-
+        // 筛选本帧参与模拟的物理组件（按原型顺序遍历连续存放的组件）：跳过禁用以及休眠（远离活动区域）的对象。
+        // 后续积分、对象碰撞和瓦片触发检测都只遍历这个列表，休眠对象保持原有状态不变
+        active_components_.clear();
+        registry.each<engine::component::PhysicsComponent>([this](engine::component::PhysicsComponent& pc) {
+            if (!pc.isEnabled()) return;
+            auto* obj = pc.getOwner();
+            if (obj && obj->isDormant()) return;
+            active_components_.push_back(&pc);
+        });
+        // 预留足够容量（每个物体每种触发特性最多一个事件），容量足够时不会重新分配
+        tile_trigger_events_.reserve(active_components_.size() * std::popcount(TRIGGER_TRAITS));
+
+        // 遍历所有参与模拟的物理组件
+        for (auto* pc : active_components_) {
             pc->resetCollisionFlags();  // 重置碰撞标志
 
             // 应用重力 (如果组件受重力影响)：F = g * m
@@ -74,18 +102,16 @@ namespace engine::physics {
 
     void PhysicsEngine::checkObjectCollisions()
     {
-        // 两层循环遍历所有包含物理组件的 GameObject
-        for (size_t i = 0; i < components_.size(); ++i) {
-            auto* pc_a = components_[i];
-            if (!pc_a || !pc_a->isEnabled()) continue;
+        // 两层循环遍历所有参与模拟的 GameObject
+        for (size_t i = 0; i < active_components_.size(); ++i) {
+            auto* pc_a = active_components_[i];
             auto* obj_a = pc_a->getOwner();
             if (!obj_a) continue;
             auto* cc_a = obj_a->getComponent<engine::component::ColliderComponent>();
             if (!cc_a || !cc_a->isActive()) continue;
 
-            for (size_t j = i + 1; j < components_.size(); ++j) {
-                auto* pc_b = components_[j];
-                if (!pc_b || !pc_b->isEnabled()) continue;
+            for (size_t j = i + 1; j < active_components_.size(); ++j) {
+                auto* pc_b = active_components_[j];
                 auto* obj_b = pc_b->getOwner();
                 if (!obj_b) continue;
                 auto* cc_b = obj_b->getComponent<engine::component::ColliderComponent>();
@@ -94,15 +120,15 @@ namespace engine::physics {
 
                 if (collision::checkCollision(*cc_a, *cc_b)) {
                     // 如果是可移动物体与SOLID物体碰撞，则直接处理位置变化，不用记录碰撞对
-                    if (obj_a->getTag() != "solid" && obj_b->getTag() == "solid") {
+                    if (obj_a->getTagId() != SOLID_TAG && obj_b->getTagId() == SOLID_TAG) {
                         resolveSolidObjectCollisions(obj_a, obj_b);
                     }
-                    else if (obj_a->getTag() == "solid" && obj_b->getTag() != "solid") {
+                    else if (obj_a->getTagId() == SOLID_TAG && obj_b->getTagId() != SOLID_TAG) {
                         resolveSolidObjectCollisions(obj_b, obj_a);
                     }
                     else {
                         // 记录碰撞对
-                        collision_pairs_.emplace_back(obj_a, obj_b);
+                        collision_pairs_.emplace_back(obj_a->getHandle(), obj_b->getHandle());
                     }
                 }
             }
@@ -145,7 +171,8 @@ namespace engine::physics {
                 auto tile_y = static_cast<int>(floor(obj_pos.y / tile_size.y));
                 auto tile_type_top = layer->getTileTypeAt({ tile_x, tile_y });        // 右上角瓦片类型
                 auto tile_y_bottom = static_cast<int>(floor((obj_pos.y + obj_size.y - tolerance) / tile_size.y));
-                auto tile_type_bottom = layer->getTileTypeAt({ tile_x, tile_y_bottom });     // 右下角瓦片类型
+                const auto* tile_bottom = layer->getTileInfoAt({ tile_x, tile_y_bottom });   // 右下角瓦片
+                auto tile_type_bottom = getTileType(tile_bottom);
 
                 if (tile_type_top == engine::component::TileType::SOLID || tile_type_bottom == engine::component::TileType::SOLID) {
                     // 撞墙了！速度归零，x方向移动到贴着墙的位置
@@ -156,7 +183,7 @@ namespace engine::physics {
                 else {
                     // 检测右下角斜坡瓦片
                     auto width_right = new_obj_pos.x + obj_size.x - tile_x * tile_size.x;
-                    auto height_right = getTileHeightAtWidth(width_right, tile_type_bottom, tile_size);
+                    auto height_right = getTileHeightAtWidth(width_right, tile_bottom, tile_size);
                     if (height_right > 0.0f) {
                         // 如果有碰撞（角点的世界y坐标 > 斜坡地面的世界y坐标）, 就让物体贴着斜坡表面
                         if (new_obj_pos.y > (tile_y_bottom + 1) * layer->getTileSize().y - obj_size.y - height_right) {
@@ -174,7 +201,8 @@ namespace engine::physics {
                 auto tile_y = static_cast<int>(floor(obj_pos.y / tile_size.y));
                 auto tile_type_top = layer->getTileTypeAt({ tile_x, tile_y });        // 左上角瓦片类型
                 auto tile_y_bottom = static_cast<int>(floor((obj_pos.y + obj_size.y - tolerance) / tile_size.y));
-                auto tile_type_bottom = layer->getTileTypeAt({ tile_x, tile_y_bottom });     // 左下角瓦片类型
+                const auto* tile_bottom = layer->getTileInfoAt({ tile_x, tile_y_bottom });   // 左下角瓦片
+                auto tile_type_bottom = getTileType(tile_bottom);
 
                 if (tile_type_top == engine::component::TileType::SOLID || tile_type_bottom == engine::component::TileType::SOLID) {
                     // 撞墙了！速度归零，x方向移动到贴着墙的位置
@@ -185,7 +213,7 @@ namespace engine::physics {
                 else {
                     // 检测左下角斜坡瓦片
                     auto width_left = new_obj_pos.x - tile_x * tile_size.x;
-                    auto height_left = getTileHeightAtWidth(width_left, tile_type_bottom, tile_size);
+                    auto height_left = getTileHeightAtWidth(width_left, tile_bottom, tile_size);
                     if (height_left > 0.0f) {
                         if (new_obj_pos.y > (tile_y_bottom + 1) * layer->getTileSize().y - obj_size.y - height_left) {
                             new_obj_pos.y = (tile_y_bottom + 1) * layer->getTileSize().y - obj_size.y - height_left;
@@ -201,9 +229,11 @@ namespace engine::physics {
                 auto tile_y = static_cast<int>(floor(bottom_left_y / tile_size.y));
 
                 auto tile_x = static_cast<int>(floor(obj_pos.x / tile_size.x));
-                auto tile_type_left = layer->getTileTypeAt({ tile_x, tile_y });           // 左下角瓦片类型   
+                const auto* tile_left = layer->getTileInfoAt({ tile_x, tile_y });         // 左下角瓦片
+                auto tile_type_left = getTileType(tile_left);
                 auto tile_x_right = static_cast<int>(floor((obj_pos.x + obj_size.x - tolerance) / tile_size.x));
-                auto tile_type_right = layer->getTileTypeAt({ tile_x_right, tile_y });     // 右下角瓦片类型
+                const auto* tile_right = layer->getTileInfoAt({ tile_x_right, tile_y });   // 右下角瓦片
+                auto tile_type_right = getTileType(tile_right);
 
                 if (tile_type_left == engine::component::TileType::SOLID || tile_type_right == engine::component::TileType::SOLID ||
                     tile_type_left == engine::component::TileType::UNISOLID || tile_type_right == engine::component::TileType::UNISOLID) {
@@ -233,8 +263,8 @@ namespace engine::physics {
                     // 检测斜坡瓦片（下方两个角点都要检测）
                     auto width_left = obj_pos.x - tile_x * tile_size.x;
                     auto width_right = obj_pos.x + obj_size.x - tile_x_right * tile_size.x;
-                    auto height_left = getTileHeightAtWidth(width_left, tile_type_left, tile_size);
-                    auto height_right = getTileHeightAtWidth(width_right, tile_type_right, tile_size);
+                    auto height_left = getTileHeightAtWidth(width_left, tile_left, tile_size);
+                    auto height_right = getTileHeightAtWidth(width_right, tile_right, tile_size);
                     auto height = glm::max(height_left, height_right);  // 找到两个角点的最高点进行检测
                     if (height > 0.0f) {    // 说明至少有一个角点处于斜坡瓦片
                         if (new_obj_pos.y > (tile_y + 1) * layer->getTileSize().y - obj_size.y - height) {
@@ -327,75 +357,160 @@ namespace engine::physics {
         }
     }
 
-    float PhysicsEngine::getTileHeightAtWidth(float width, engine::component::TileType type, glm::vec2 tile_size)
+    float PhysicsEngine::getTileHeightAtWidth(float width, const engine::component::TileInfo* tile, glm::vec2 tile_size)
     {
-        auto rel_x = glm::clamp(width / tile_size.x, 0.0f, 1.0f);
-        switch (type) {
-        case engine::component::TileType::SLOPE_0_1:        // 左0  右1
-            return rel_x * tile_size.y;
-        case engine::component::TileType::SLOPE_0_2:        // 左0  右1/2
-            return rel_x * tile_size.y * 0.5f;
-        case engine::component::TileType::SLOPE_2_1:        // 左1/2右1
-            return rel_x * tile_size.y * 0.5f + tile_size.y * 0.5f;
-        case engine::component::TileType::SLOPE_1_0:        // 左1  右0
-            return (1.0f - rel_x) * tile_size.y;
-        case engine::component::TileType::SLOPE_2_0:        // 左1/2右0
-            return (1.0f - rel_x) * tile_size.y * 0.5f;
-        case engine::component::TileType::SLOPE_1_2:        // 左1  右1/2
-            return (1.0f - rel_x) * tile_size.y * 0.5f + tile_size.y * 0.5f;
-        default:
-            return 0.0f;   // 默认返回0，表示没有斜坡
+        if (!tile || !tile->height_profile || tile->height_profile->empty()) {
+            return 0.0f;   // 没有高度表，表示没有斜坡
         }
+        // 高度表按像素列存储（加载时已按地图瓦片尺寸光栅化），按比例换算列号即可
+        const auto& profile = *tile->height_profile;
+        auto columns = static_cast<int>(profile.size());
+        auto column = glm::clamp(static_cast<int>(width / tile_size.x * columns), 0, columns - 1);
+        return static_cast<float>(profile[column]);
     }
 
     void PhysicsEngine::checkTileTriggers()
     {
-        for (auto* pc : components_) {
-            if (!pc || !pc->isEnabled()) continue;  // 检查组件是否有效和启用
+        if (tile_trait_chunks_.empty()) return;
+
+        for (auto* pc : active_components_) {
             auto* obj = pc->getOwner();
             if (!obj) continue;
             auto* cc = obj->getComponent<engine::component::ColliderComponent>();
             if (!cc || !cc->isActive() || cc->isTrigger()) continue;    // 如果游戏对象本就是触发器，则不需要检查瓦片触发事件
 
-            // 获取物体的世界AABB
-            auto world_aabb = cc->getWorldAABB();
-
-            // 使用 set 来跟踪循环遍历中已经触发过的瓦片类型，防止重复添加（例如，玩家同时踩到两个尖刺，只需要受到一次伤害）
-            std::set<engine::component::TileType> triggers_set;
-
-            // 遍历所有注册的碰撞瓦片层分别进行检测
-            for (auto* layer : collision_tile_layers_) {
-                if (!layer) continue;
-                auto tile_size = layer->getTileSize();
-                constexpr float tolerance = 1.0f;   // 检查右边缘和下边缘时，需要减1像素，否则会检查到下一行/列的瓦片
-                // 获取瓦片坐标范围
-                auto start_x = static_cast<int>(floor(world_aabb.position.x / tile_size.x));
-                auto end_x = static_cast<int>(ceil((world_aabb.position.x + world_aabb.size.x - tolerance) / tile_size.x));
-                auto start_y = static_cast<int>(floor(world_aabb.position.y / tile_size.y));
-                auto end_y = static_cast<int>(ceil((world_aabb.position.y + world_aabb.size.y - tolerance) / tile_size.y));
-
-                // 遍历瓦片坐标范围进行检测
-                for (int x = start_x; x < end_x; ++x) {
-                    for (int y = start_y; y < end_y; ++y) {
-                        auto tile_type = layer->getTileTypeAt({ x, y });
-                        // 未来可以添加更多触发器类型的瓦片，目前只有 HAZARD 类型
-                        if (tile_type == engine::component::TileType::HAZARD) {
-                            triggers_set.insert(tile_type);     // 记录触发事件，set 保证每个瓦片类型只记录一次
-                        }
-                        // 梯子类型不必记录到事件容器，物理引擎自己处理
-                        else if (tile_type == engine::component::TileType::LADDER) {
-                            pc->setCollidedLadder(true);
-                        }
-                    }
+            // 物体覆盖范围内所有瓦片特性的并集（例如，玩家同时踩到两个尖刺，也只有一个 HAZARD 位）
+            auto traits = getTileTraitsInRect(cc->getWorldAABB());
+
+            // 梯子类型不必记录到事件容器，物理引擎自己处理
+            if (traits & engine::component::tile_trait::LADDER) {
+                pc->setCollidedLadder(true);
+            }
+            // 每个置位的触发特性记录一个事件
+            for (std::uint8_t bits = traits & TRIGGER_TRAITS; bits != 0; bits &= bits - 1) {
+                tile_trigger_events_.emplace_back(obj->getHandle(), TRAIT_BIT_TO_TYPE[std::countr_zero(bits)]);
+            }
+        }
+    }
+
+    void PhysicsEngine::rebuildTileTraitGrid()
+    {
+        using engine::component::TileChunkMap;
+        tile_trait_chunks_.clear();
+        trait_tile_size_ = { 0, 0 };
+
+        // 以第一个有效图层的瓦片尺寸为准，瓦片尺寸不一致的图层不参与合并
+        for (auto* layer : collision_tile_layers_) {
+            if (!layer) continue;
+            auto tile_size = layer->getTileSize();
+            if (trait_tile_size_ == glm::ivec2(0, 0)) {
+                trait_tile_size_ = tile_size;
+            }
+            else if (tile_size != trait_tile_size_) {
+                spdlog::warn("碰撞瓦片图层的瓦片尺寸与特性网格不一致，该图层不参与瓦片触发检测。");
+                continue;
+            }
+            // 只遍历有瓦片的块：各块的特性由线程池并行计算，再按块合并（只为含有特性的块分配内存）
+            const auto& tiles = layer->getTiles();
+            const auto& palette = tiles.getPalette();
+            std::vector<std::uint8_t> palette_traits(palette.size());
+            for (size_t i = 0; i < palette.size(); ++i) {
+                palette_traits[i] = engine::component::getTileTraits(palette[i]);
+            }
+            std::vector<std::pair<glm::ivec2, const TileChunkMap::Chunk*>> chunks;
+            chunks.reserve(tiles.getChunkCount());
+            tiles.forEachChunk([&chunks](glm::ivec2 chunk_coord, const TileChunkMap::Chunk& chunk) {
+                chunks.emplace_back(chunk_coord, &chunk);
+            });
+            std::vector<std::vector<std::uint8_t>> chunk_traits(chunks.size());
+            engine::utils::ThreadPool::getInstance().parallelFor(chunks.size(), [&](std::size_t chunk_index) {
+                const auto& chunk = *chunks[chunk_index].second;
+                auto& traits = chunk_traits[chunk_index];
+                for (int i = 0; i < TileChunkMap::CHUNK_AREA; ++i) {
+                    auto trait = palette_traits[chunk.tiles[i]];
+                    if (trait == engine::component::tile_trait::NONE) continue;
+                    if (traits.empty()) traits.resize(TileChunkMap::CHUNK_AREA, engine::component::tile_trait::NONE);
+                    traits[i] = trait;
+                }
+            });
+            for (std::size_t chunk_index = 0; chunk_index < chunks.size(); ++chunk_index) {
+                auto& traits = chunk_traits[chunk_index];
+                if (traits.empty()) continue;
+                auto& merged = tile_trait_chunks_[TileChunkMap::packKey(chunks[chunk_index].first)];
+                if (merged.empty()) {
+                    merged = std::move(traits);
+                    continue;
+                }
+                for (int i = 0; i < TileChunkMap::CHUNK_AREA; ++i) {
+                    merged[i] |= traits[i];
+                }
+            }
+        }
+    }
+
+    void PhysicsEngine::refreshTileTraitChunk(glm::ivec2 chunk_coord)
+    {
+        using engine::component::TileChunkMap;
+        const auto key = TileChunkMap::packKey(chunk_coord);
+        tile_trait_chunks_.erase(key);
+        std::vector<std::uint8_t>* traits = nullptr;
+        for (auto* layer : collision_tile_layers_) {
+            if (!layer || layer->getTileSize() != trait_tile_size_) continue;
+            const auto& tiles = layer->getTiles();
+            const auto* chunk = tiles.findChunk(chunk_coord);
+            if (!chunk) continue;       // 空块或未载入的块没有特性（未载入块的碰撞由 getTileInfoAt 的占位瓦片处理）
+            const auto& palette = tiles.getPalette();
+            for (int i = 0; i < TileChunkMap::CHUNK_AREA; ++i) {
+                auto trait = engine::component::getTileTraits(palette[chunk->tiles[i]]);
+                if (trait == engine::component::tile_trait::NONE) continue;
+                if (!traits) {
+                    traits = &tile_trait_chunks_[key];
+                    traits->resize(TileChunkMap::CHUNK_AREA, engine::component::tile_trait::NONE);
                 }
-                // 遍历触发事件集合，添加到 tile_trigger_events_ 中
-                for (const auto& type : triggers_set) {
-                    tile_trigger_events_.emplace_back(obj, type);
-                    spdlog::trace("tile_trigger_events_中 添加了 GameObject {} 和瓦片触发类型: {}",
-                        obj->getName(), static_cast<int>(type));
+                (*traits)[i] |= trait;
+            }
+        }
+    }
+
+    std::uint8_t PhysicsEngine::getTileTraitsInRect(const engine::utils::Rect& rect) const
+    {
+        using engine::component::TileChunkMap;
+        if (tile_trait_chunks_.empty() || trait_tile_size_.x <= 0 || trait_tile_size_.y <= 0) {
+            return engine::component::tile_trait::NONE;
+        }
+        constexpr float tolerance = 1.0f;   // 检查右边缘和下边缘时，需要减1像素，否则会检查到下一行/列的瓦片
+        // 获取瓦片坐标范围（闭区间）
+        glm::ivec2 start = {
+            static_cast<int>(floor(rect.position.x / trait_tile_size_.x)),
+            static_cast<int>(floor(rect.position.y / trait_tile_size_.y))
+        };
+        glm::ivec2 end = {
+            static_cast<int>(floor((rect.position.x + rect.size.x - tolerance) / trait_tile_size_.x)),
+            static_cast<int>(floor((rect.position.y + rect.size.y - tolerance) / trait_tile_size_.y))
+        };
+
+        // 按块遍历（物体通常只覆盖一两个块）
+        std::uint8_t traits = engine::component::tile_trait::NONE;
+        const auto chunk_start = TileChunkMap::toChunkCoord(start);
+        const auto chunk_end = TileChunkMap::toChunkCoord(end);
+        for (int chunk_y = chunk_start.y; chunk_y <= chunk_end.y; ++chunk_y) {
+            for (int chunk_x = chunk_start.x; chunk_x <= chunk_end.x; ++chunk_x) {
+                auto it = tile_trait_chunks_.find(TileChunkMap::packKey({ chunk_x, chunk_y }));
+                if (it == tile_trait_chunks_.end()) continue;
+                const auto& chunk = it->second;
+                const int y_begin = std::max(start.y, chunk_y * TileChunkMap::CHUNK_SIZE);
+                const int y_end = std::min(end.y, chunk_y * TileChunkMap::CHUNK_SIZE + TileChunkMap::CHUNK_SIZE - 1);
+                const int x_begin = std::max(start.x, chunk_x * TileChunkMap::CHUNK_SIZE);
+                const int x_end = std::min(end.x, chunk_x * TileChunkMap::CHUNK_SIZE + TileChunkMap::CHUNK_SIZE - 1);
+                for (int y = y_begin; y <= y_end; ++y) {
+                    const auto* row = chunk.data() + (y & (TileChunkMap::CHUNK_SIZE - 1)) * TileChunkMap::CHUNK_SIZE;
+                    for (int x = x_begin; x <= x_end; ++x) {
+                        traits |= row[x & (TileChunkMap::CHUNK_SIZE - 1)];
+                    }
                 }
             }
         }
+        return traits;
     }
 
     void PhysicsEngine::applyWorldBounds(engine::component::PhysicsComponent* pc)
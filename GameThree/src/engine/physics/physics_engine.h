@@ -1,18 +1,23 @@
 #pragma once
 #include "../utils/math.h"
+#include "../object/object_handle.h"
 #include <vector>
 #include <utility>  // for std::pair
 #include <optional>
+#include <cstdint>
+#include <unordered_map>
 #include <glm/vec2.hpp>
 
 namespace engine::component {
     class PhysicsComponent;
     class TileLayerComponent;
+    struct TileInfo;
     enum class TileType;
 }
 
 namespace engine::object {
     class GameObject;
+    class ArchetypeRegistry;
 }
 
 namespace engine::physics {
@@ -22,16 +27,22 @@ namespace engine::physics {
      */
     class PhysicsEngine {
     private:
-        std::vector<engine::component::PhysicsComponent*> components_; ///< @brief 注册的物理组件容器，非拥有指针
+        /// @brief 本帧参与模拟的物理组件（每次 update 开始时从场景原型中筛选，跳过禁用和休眠对象；指向原型数组，只在 update 期间有效）
+        std::vector<engine::component::PhysicsComponent*> active_components_;
         std::vector<engine::component::TileLayerComponent*> collision_tile_layers_; ///< @brief 注册的碰撞瓦片图层容器
         glm::vec2 gravity_ = { 0.0f, 980.0f };        ///< @brief 默认重力值 (像素/秒^2, 相当于100像素对应现实1m)
         float max_speed_ = 500.0f;                  ///< @brief 最大速度 (像素/秒)
         std::optional<engine::utils::Rect> world_bounds_;     ///< @brief 世界边界，用于限制物体移动范围
 
-        /// @brief 存储本帧发生的 GameObject 碰撞对 （每次 update 开始时清空）
-        std::vector<std::pair<engine::object::GameObject*, engine::object::GameObject*>> collision_pairs_;
-        /// @brief 存储本帧发生的瓦片触发事件 (GameObject*, 触发的瓦片类型, 每次 update 开始时清空)
-        std::vector<std::pair<engine::object::GameObject*, engine::component::TileType>> tile_trigger_events_;
+        // --- 打包的瓦片特性网格 (所有碰撞图层按位或合并，注册/注销图层时重建) ---
+        /// @brief 与瓦片图层相同的分块方式：块坐标键 -> 每个瓦片一个字节的特性位掩码（没有特性的块不存储）
+        std::unordered_map<std::uint64_t, std::vector<std::uint8_t>> tile_trait_chunks_;
+        glm::ivec2 trait_tile_size_ = { 0, 0 };               ///< @brief 特性网格的瓦片尺寸（像素）
+
+        /// @brief 存储本帧发生的 GameObject 碰撞对 （对象句柄，每对8字节；每次 update 开始时清空）
+        std::vector<std::pair<engine::object::ObjectHandle, engine::object::ObjectHandle>> collision_pairs_;
+        /// @brief 存储本帧发生的瓦片触发事件 (对象句柄, 触发的瓦片类型, 每次 update 开始时清空)
+        std::vector<std::pair<engine::object::ObjectHandle, engine::component::TileType>> tile_trigger_events_;
 
     public:
         PhysicsEngine() = default;
@@ -42,14 +53,14 @@ namespace engine::physics {
         PhysicsEngine(PhysicsEngine&&) = delete;
         PhysicsEngine& operator=(PhysicsEngine&&) = delete;
 
-        void registerComponent(engine::component::PhysicsComponent* component);     ///< @brief 注册物理组件
-        void unregisterComponent(engine::component::PhysicsComponent* component);   ///< @brief 注销物理组件
-
         // 如果瓦片层需要进行碰撞检测则注册。（不需要则不必注册）
         void registerCollisionLayer(engine::component::TileLayerComponent* layer);  ///< @brief 注册用于碰撞检测的 TileLayerComponent
         void unregisterCollisionLayer(engine::component::TileLayerComponent* layer);///< @brief 注销用于碰撞检测的 TileLayerComponent
+        /// @brief 碰撞图层的某个块被载入或回收后，只重新计算瓦片特性网格中的这一块（流式加载时调用）
+        void refreshTileTraitChunk(glm::ivec2 chunk_coord);
 
-        void update(float delta_time);      ///< @brief 核心循环：更新所有注册的物理组件的状态
+        /// @brief 核心循环：更新场景中所有物理组件的状态（按原型遍历紧密存储的物理组件）
+        void update(float delta_time, engine::object::ArchetypeRegistry& registry);
 
         // 设置器/获取器
         void setGravity(const glm::vec2& gravity) { gravity_ = gravity; }   ///< @brief 设置全局重力加速度
@@ -59,11 +70,11 @@ namespace engine::physics {
         void setWorldBounds(const engine::utils::Rect& world_bounds) { world_bounds_ = world_bounds; }   ///< @brief 设置世界边界
         const std::optional<engine::utils::Rect>& getWorldBounds() const { return world_bounds_; }       ///< @brief 获取世界边界
         /// @brief 获取本帧检测到的所有 GameObject 碰撞对。(此列表在每次 update 开始时清空)
-        const std::vector<std::pair<engine::object::GameObject*, engine::object::GameObject*>>& getCollisionPairs() const {
+        const std::vector<std::pair<engine::object::ObjectHandle, engine::object::ObjectHandle>>& getCollisionPairs() const {
             return collision_pairs_;
         };
         /// @brief 获取本帧检测到的所有瓦片触发事件。(此列表在每次 update 开始时清空)
-        const std::vector<std::pair<engine::object::GameObject*, engine::component::TileType>>& getTileTriggerEvents() const {
+        const std::vector<std::pair<engine::object::ObjectHandle, engine::component::TileType>>& getTileTriggerEvents() const {
             return tile_trigger_events_;
         };
 
@@ -76,18 +87,29 @@ namespace engine::physics {
         void applyWorldBounds(engine::component::PhysicsComponent* pc);     ///< @brief 应用世界边界，限制物体移动范围
 
         /**
-         * @brief 根据瓦片类型和指定宽度x坐标，计算瓦片上对应y坐标。
+         * @brief 根据瓦片高度表和指定宽度x坐标，查表得到瓦片上对应高度。
          * @param width 从瓦片左侧起算的宽度。
-         * @param type 瓦片类型。
+         * @param tile 瓦片信息（可以为空）。
          * @param tile_size 瓦片尺寸。
-         * @return 瓦片上对应高度（从瓦片下侧起算）。
+         * @return 瓦片上对应高度（从瓦片下侧起算），没有高度表时返回0。
          */
-        float getTileHeightAtWidth(float width, engine::component::TileType type, glm::vec2 tile_size);
+        float getTileHeightAtWidth(float width, const engine::component::TileInfo* tile, glm::vec2 tile_size);
 
         /**
          * @brief 检测所有游戏对象与瓦片层的触发器类型瓦片碰撞，并记录触发事件。(位移处理完毕后再调用)
+         * @note 对物体覆盖的瓦片范围按位或得到特性掩码，每个置位的触发特性只产生一个事件，不分配额外内存。
          */
         void checkTileTriggers();
+
+        /// @brief 根据当前注册的碰撞图层重建打包的瓦片特性网格
+        void rebuildTileTraitGrid();
+
+        /**
+         * @brief 获取世界矩形所覆盖瓦片的特性位掩码（按位或合并）。
+         * @param rect 世界坐标系下的矩形
+         * @return std::uint8_t 覆盖范围内所有瓦片特性的并集，没有瓦片的部分视为无特性
+         */
+        std::uint8_t getTileTraitsInRect(const engine::utils::Rect& rect) const;
     };
 
 } // namespace engine::physics
\ No newline at end of file
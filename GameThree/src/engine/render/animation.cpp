@@ -1,4 +1,5 @@
 #include "animation.h"
+#include <algorithm>
 #include <glm/common.hpp>
 #include <spdlog/spdlog.h>
 
@@ -13,8 +14,13 @@ namespace engine::render {
             spdlog::warn("尝试向动画 '{}' 添加无效持续时间的帧", name_);
             return;
         }
+        // 第一帧确定统一时长，之后出现不同时长的帧则不再统一
+        if (frames_.empty()) uniform_frame_duration_ = duration;
+        else if (duration != uniform_frame_duration_) uniform_frame_duration_ = 0.0f;
+
         frames_.push_back({ source_rect, duration });
         total_duration_ += duration;
+        frame_end_times_.push_back(total_duration_);
     }
 
     const AnimationFrame& Animation::getFrame(float time) const {
@@ -22,6 +28,11 @@ namespace engine::render {
             spdlog::error("动画 '{}' 没有帧，无法获取帧", name_);
             return frames_.back();      // 返回最后一帧（空的）
         }
+        return frames_[getFrameIndex(time)];
+    }
+
+    std::size_t Animation::getFrameIndex(float time) const {
+        if (frames_.empty()) return 0;
 
         float current_time = time;
 
@@ -32,22 +43,19 @@ namespace engine::render {
         else {
             // 对于非循环动画，如果时间超过总时长，则停留在最后一帧
             if (current_time >= total_duration_) {
-                return frames_.back();
+                return frames_.size() - 1;
             }
         }
+        if (current_time <= 0.0f) return 0;
 
-        // 遍历帧以找到正确的帧
-        float accumulated_time = 0.0f;
-        for (const auto& frame : frames_) {
-            accumulated_time += frame.duration;
-            if (current_time < accumulated_time) {
-                return frame;
-            }
+        const auto last = frames_.size() - 1;   // 浮点误差可能使计算结果越界，统一限制到最后一帧
+        // 统一帧时长：直接计算
+        if (uniform_frame_duration_ > 0.0f) {
+            return std::min(static_cast<std::size_t>(current_time / uniform_frame_duration_), last);
         }
-
-        // 理论上在不应到达这里，但为了安全起见，返回最后一帧
-        spdlog::warn("动画 '{}' 在获取帧信息时出现错误。", name_);
-        return frames_.back();
+        // 否则在累计结束时间中二分查找第一个大于当前时间的帧
+        auto it = std::upper_bound(frame_end_times_.begin(), frame_end_times_.end(), current_time);
+        return std::min(static_cast<std::size_t>(it - frame_end_times_.begin()), last);
     }
 
 } // namespace engine::render 
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <SDL3/SDL_rect.h>
+#include <cstddef>
 #include <vector>
 #include <string>
 
@@ -19,11 +20,14 @@ namespace engine::render {
      * @brief 管理一系列动画帧。
      *
      * 存储动画的帧、总时长、名称和循环行为。
+     * 添加帧时预先计算每帧的累计结束时间，按时间查帧为二分查找；所有帧时长相同时直接除法得到帧下标。
      */
     class Animation final {
     private:
         std::string name_;                      ///< @brief 动画的名称 (例如, "walk", "idle")。
         std::vector<AnimationFrame> frames_;    ///< @brief 动画帧列表
+        std::vector<float> frame_end_times_;    ///< @brief 每帧的累计结束时间（秒），与 frames_ 一一对应，单调递增
+        float uniform_frame_duration_ = 0.0f;   ///< @brief 所有帧的统一时长（秒），帧时长不一致时为0
         float total_duration_ = 0.0f;           ///< @brief 动画的总持续时间（秒）
         bool loop_ = true;                      ///< @brief 默认动画是循环的
 
@@ -57,6 +61,13 @@ namespace engine::render {
          */
         const AnimationFrame& getFrame(float time) const;
 
+        /**
+         * @brief 获取在给定时间点应该显示的帧下标。统一帧时长时 O(1)，否则 O(log n)。
+         * @param time 当前时间（秒）。如果动画循环，则可以超过总持续时间。
+         * @return 帧下标（动画没有帧时返回0）。
+         */
+        std::size_t getFrameIndex(float time) const;
+
         // --- Setters and Getters ---
         const std::string& getName() const { return name_; }                        ///< @brief 获取动画名称。
         const std::vector<AnimationFrame>& getFrames() const { return frames_; }    ///< @brief 获取动画帧列表。
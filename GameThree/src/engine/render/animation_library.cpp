@@ -0,0 +1,39 @@
+#include "animation_library.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+
+    const AnimationSet* AnimationLibrary::addSet(const std::string& key, AnimationSet set)
+    {
+        auto [it, inserted] = sets_.try_emplace(key, std::move(set));
+        if (inserted) {
+            clip_count_ += it->second.size();
+            spdlog::debug("AnimationLibrary: 注册动画集 '{}'（{} 个动画）。", key, it->second.size());
+        }
+        return &it->second;
+    }
+
+    const AnimationSet* AnimationLibrary::getSet(const std::string& key) const
+    {
+        auto it = sets_.find(key);
+        return it != sets_.end() ? &it->second : nullptr;
+    }
+
+    const Animation* AnimationLibrary::getClip(const std::string& key, const std::string& clip_name) const
+    {
+        const auto* set = getSet(key);
+        if (!set) return nullptr;
+        auto it = set->find(clip_name);
+        return it != set->end() ? it->second.get() : nullptr;
+    }
+
+    void AnimationLibrary::clear()
+    {
+        if (!sets_.empty()) {
+            spdlog::debug("AnimationLibrary: 清空 {} 个动画集。", sets_.size());
+        }
+        sets_.clear();
+        clip_count_ = 0;
+    }
+
+} // namespace engine::render
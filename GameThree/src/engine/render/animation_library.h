@@ -0,0 +1,54 @@
+#pragma once
+#include "animation.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace engine::render {
+
+    /// @brief 动画集：同一预制体（如某种敌人、某种特效）的所有动画片段（动画名称 -> 动画），注册后不再修改
+    using AnimationSet = std::unordered_map<std::string, std::unique_ptr<const Animation>>;
+
+    /**
+     * @brief 共享动画库，持有所有不可变的动画片段。
+     *
+     * 动画集按预制体键（例如 "assets/maps/actor.tsj#3" 或 "effect_enemy"）注册一次，
+     * 之后所有同类对象的 AnimationComponent 只引用同一个动画集，自身只保存播放状态。
+     * 动画库由 ResourceManager 持有，动画集的地址在清空之前保持不变。
+     */
+    class AnimationLibrary final {
+    private:
+        std::unordered_map<std::string, AnimationSet> sets_;   ///< @brief 预制体键 -> 动画集（节点容器，插入时不会使已有元素失效）
+        std::size_t clip_count_ = 0;                            ///< @brief 所有动画片段的数量
+
+    public:
+        AnimationLibrary() = default;
+
+        // 禁止拷贝和移动（组件中保存了指向动画集的指针）
+        AnimationLibrary(const AnimationLibrary&) = delete;
+        AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+        AnimationLibrary(AnimationLibrary&&) = delete;
+        AnimationLibrary& operator=(AnimationLibrary&&) = delete;
+
+        /**
+         * @brief 注册动画集。
+         * @param key 预制体键
+         * @param set 动画集
+         * @return 注册后的动画集指针；键已存在时丢弃传入的动画集，返回已有的动画集
+         */
+        const AnimationSet* addSet(const std::string& key, AnimationSet set);
+
+        /// @brief 获取动画集，未注册时返回空指针
+        const AnimationSet* getSet(const std::string& key) const;
+
+        /// @brief 获取动画集中的一个动画片段，未找到时返回空指针
+        const Animation* getClip(const std::string& key, const std::string& clip_name) const;
+
+        void clear();       ///< @brief 清空所有动画集（必须确保没有组件仍在引用）
+
+        std::size_t getSetCount() const { return sets_.size(); }       ///< @brief 获取动画集数量
+        std::size_t getClipCount() const { return clip_count_; }       ///< @brief 获取动画片段数量
+    };
+
+} // namespace engine::render
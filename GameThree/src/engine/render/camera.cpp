@@ -1,12 +1,14 @@
 #include "camera.h"
 #include "../utils/math.h"
 #include "../component/transform_component.h"
+#include "../object/game_object.h"
+#include "../object/handle_table.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::render {
 
-    Camera::Camera(const glm::vec2& viewport_size, const glm::vec2& position, const std::optional<engine::utils::Rect> limit_bounds)
-        : viewport_size_(viewport_size), position_(position), limit_bounds_(limit_bounds) {
+    Camera::Camera(const engine::object::HandleTable& handle_table, const glm::vec2& viewport_size, const glm::vec2& position, const std::optional<engine::utils::Rect> limit_bounds)
+        : handle_table_(handle_table), viewport_size_(viewport_size), position_(position), limit_bounds_(limit_bounds) {
         spdlog::trace("Camera 初始化成功，位置: {},{}", position_.x, position_.y);
     }
 
@@ -17,9 +19,9 @@ namespace engine::render {
 
     void Camera::update(float delta_time)
     {
-        if (target_ == nullptr)  return;
-        glm::vec2 target_pos = target_->getPosition();
-        glm::vec2 desired_position = target_pos - viewport_size_ / 2.0f;      // 计算目标位置 (让目标位于视口中心)
+        auto desired = getDesiredPosition();
+        if (!desired) return;
+        glm::vec2 desired_position = *desired;
 
         // 计算当前位置与目标位置的距离
         auto distance_ = glm::distance(position_, desired_position);
@@ -39,6 +41,14 @@ namespace engine::render {
         clampPosition();
     }
 
+    void Camera::snapToTarget()
+    {
+        if (auto desired = getDesiredPosition(); desired) {
+            position_ = *desired;
+            clampPosition();
+        }
+    }
+
     void Camera::move(const glm::vec2& offset)
     {
         position_ += offset;
@@ -51,12 +61,12 @@ namespace engine::render {
         clampPosition(); // 设置边界后，立即应用限制
     }
 
-    void Camera::setTarget(engine::component::TransformComponent* target)
+    void Camera::setTarget(engine::object::ObjectHandle target)
     {
         target_ = target;
     }
 
-    engine::component::TransformComponent* Camera::getTarget() const
+    engine::object::ObjectHandle Camera::getTarget() const
     {
         return target_;
     }
@@ -65,6 +75,16 @@ namespace engine::render {
         return position_;
     }
 
+    std::optional<glm::vec2> Camera::getDesiredPosition() const
+    {
+        // 解析目标句柄（目标已销毁时句柄失效，相机停止跟随）
+        auto* target_obj = handle_table_.resolve(target_);
+        if (!target_obj) return std::nullopt;
+        auto* target_transform = target_obj->getComponent<engine::component::TransformComponent>();
+        if (!target_transform) return std::nullopt;
+        return target_transform->getPosition() - viewport_size_ / 2.0f;      // 计算目标位置 (让目标位于视口中心)
+    }
+
     void Camera::clampPosition()
     {
         // 边界检查需要确保相机视图（position 到 position + viewport_size）在 limit_bounds 内
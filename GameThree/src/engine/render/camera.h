@@ -1,9 +1,10 @@
 #pragma once
 #include "../utils/math.h"
+#include "../object/object_handle.h"
 #include <optional>
 
-namespace engine::component {
-    class TransformComponent;
+namespace engine::object {
+    class HandleTable;
 }
 
 namespace engine::render {
@@ -14,17 +15,19 @@ namespace engine::render {
      */
     class Camera final {
     private:
+        const engine::object::HandleTable& handle_table_;                        ///< @brief 句柄表（解析跟随目标）
         glm::vec2 viewport_size_;                                                ///< @brief 视口大小（屏幕大小）
         glm::vec2 position_;                                                     ///< @brief 相机左上角的世界坐标
         std::optional<engine::utils::Rect> limit_bounds_;                        ///< @brief 限制相机的移动范围，空值表示不限制
         float smooth_speed_ = 5.0f;                                              ///< @brief 相机移动的平滑速度
-        engine::component::TransformComponent* target_ = nullptr;                ///< @brief 跟随目标变换组件，空值表示不跟随
+        engine::object::ObjectHandle target_;                                    ///< @brief 跟随目标对象的句柄，空句柄表示不跟随（目标销毁后自动失效）
 
     public:
 
-        Camera(const glm::vec2& viewport_size, const glm::vec2& position = glm::vec2(0.0f, 0.0f), const std::optional<engine::utils::Rect> limit_bounds = std::nullopt);
+        Camera(const engine::object::HandleTable& handle_table, const glm::vec2& viewport_size, const glm::vec2& position = glm::vec2(0.0f, 0.0f), const std::optional<engine::utils::Rect> limit_bounds = std::nullopt);
 
         void update(float delta_time);                                          ///< @brief 更新相机位置
+        void snapToTarget();                                                    ///< @brief 立即移动到跟随目标处（不平滑，例如关卡开始时，使首帧的视口就在目标周围）
         void move(const glm::vec2& offset);                                     ///< @brief 移动相机
 
         glm::vec2 worldToScreen(const glm::vec2& world_pos) const;              ///< @brief 世界坐标转屏幕坐标
@@ -33,12 +36,12 @@ namespace engine::render {
 
         void setPosition(const glm::vec2& position);                            ///< @brief 设置相机位置
         void setLimitBounds(std::optional<engine::utils::Rect> bounds);         ///< @brief 设置限制相机的移动范围
-        void setTarget(engine::component::TransformComponent* target);          ///< @brief 设置跟随目标变换组件
+        void setTarget(engine::object::ObjectHandle target);                    ///< @brief 设置跟随目标对象（需要有变换组件）
 
         const glm::vec2& getPosition() const;                                   ///< @brief 获取相机位置
         std::optional<engine::utils::Rect> getLimitBounds() const;              ///< @brief 获取限制相机的移动范围
         glm::vec2 getViewportSize() const;                                      ///< @brief 获取视口大小
-        engine::component::TransformComponent* getTarget() const;               ///< @brief 获取跟随目标变换组件
+        engine::object::ObjectHandle getTarget() const;                         ///< @brief 获取跟随目标对象的句柄
 
         // 禁用拷贝和移动语义
         Camera(const Camera&) = delete;
@@ -48,6 +51,7 @@ namespace engine::render {
 
     private:
         void clampPosition();                                                   ///< @brief 限制相机位置在边界内
+        std::optional<glm::vec2> getDesiredPosition() const;                    ///< @brief 让跟随目标位于视口中心的相机位置（没有有效目标时为空）
     };
 
 } // namespace engine::render
\ No newline at end of file
@@ -31,6 +31,10 @@ namespace engine::render {
             return;
         }
 
+        // 纹理仍在后台加载：有源矩形时用占位纹理填充同样大小的区域，否则尺寸未知，先不绘制
+        const bool placeholder = resource_manager_->isPlaceholderTexture(texture);
+        if (placeholder && !sprite.getSourceRect().has_value()) return;
+
         auto src_rect = getSpriteSrcRect(sprite);
         if (!src_rect.has_value()) {
             spdlog::error("无法获取精灵的源矩形，ID: {}", sprite.getTextureId());
@@ -56,7 +60,7 @@ namespace engine::render {
         }
 
         // 执行绘制(默认旋转中心为精灵的中心点)
-        if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, angle, NULL, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
+        if (!SDL_RenderTextureRotated(renderer_, texture, placeholder ? nullptr : &src_rect.value(), &dest_rect, angle, NULL, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
             spdlog::error("渲染旋转纹理失败（ID: {}）：{}", sprite.getTextureId(), SDL_GetError());
         }
     }
@@ -68,6 +72,7 @@ namespace engine::render {
             spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
             return;
         }
+        if (resource_manager_->isPlaceholderTexture(texture)) return;   // 背景仍在后台加载，尺寸未知，先不绘制
 
         auto src_rect = getSpriteSrcRect(sprite);
         if (!src_rect.has_value()) {
@@ -120,6 +125,9 @@ namespace engine::render {
             spdlog::error("无法为 ID {} 获取纹理。", sprite.getTextureId());
             return;
         }
+        // 纹理仍在后台加载：能确定目标尺寸时绘制占位纹理，否则先不绘制
+        const bool placeholder = resource_manager_->isPlaceholderTexture(texture);
+        if (placeholder && !size.has_value() && !sprite.getSourceRect().has_value()) return;
 
         auto src_rect = getSpriteSrcRect(sprite);
         if (!src_rect.has_value()) {
@@ -138,7 +146,7 @@ namespace engine::render {
         }
 
         // 执行绘制(未考虑UI旋转)
-        if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect.value(), &dest_rect, 0.0, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
+        if (!SDL_RenderTextureRotated(renderer_, texture, placeholder ? nullptr : &src_rect.value(), &dest_rect, 0.0, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
             spdlog::error("渲染 UI Sprite 失败 (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
         }
     }
@@ -60,6 +60,22 @@ namespace engine::resource {
         return raw_chunk;
     }
 
+    Mix_Chunk* AudioManager::addSound(const std::string& file_path, Mix_Chunk* chunk) {
+        std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter> owned_chunk(chunk);
+        auto it = sounds_.find(file_path);
+        if (it != sounds_.end()) {
+            return it->second.get();    // owned_chunk 离开作用域时释放
+        }
+        if (!owned_chunk) {
+            spdlog::error("缓存音效失败: '{}': 音效为空", file_path);
+            return nullptr;
+        }
+        auto* raw_chunk = owned_chunk.get();
+        sounds_.emplace(file_path, std::move(owned_chunk));
+        spdlog::debug("成功缓存音效: {}", file_path);
+        return raw_chunk;
+    }
+
     Mix_Chunk* AudioManager::getSound(const std::string& file_path) {
         auto it = sounds_.find(file_path);
         if (it != sounds_.end()) {
@@ -59,14 +59,18 @@ namespace engine::resource {
     private:  // 仅供 ResourceManager 访问的方法
 
         Mix_Chunk* loadSound(const std::string& file_path);     ///< @brief 从文件路径加载音效
+        /// @brief 缓存已解码的音效（如后台线程加载的），获取 chunk 所有权；已缓存则释放 chunk 并返回已有音效
+        Mix_Chunk* addSound(const std::string& file_path, Mix_Chunk* chunk);
         Mix_Chunk* getSound(const std::string& file_path);      ///< @brief 尝试获取已加载音效的指针，如果未加载则尝试加载
         void unloadSound(const std::string& file_path);         ///< @brief 卸载指定的音效资源
         void clearSounds();                                      ///< @brief 清空所有音效资源
+        bool hasSound(const std::string& file_path) const { return sounds_.contains(file_path); }  ///< @brief 音效是否已缓存
 
         Mix_Music* loadMusic(const std::string& file_path);     ///< @brief 从文件路径加载音乐
         Mix_Music* getMusic(const std::string& file_path);      ///< @brief 尝试获取已加载音乐的指针，如果未加载则尝试加载
         void unloadMusic(const std::string& file_path);         ///< @brief 卸载指定的音乐资源
         void clearMusic();                                      ///< @brief 清空所有音乐资源
+        bool hasMusic(const std::string& file_path) const { return music_.contains(file_path); }   ///< @brief 音乐是否已缓存
 
         void clearAudio();                                      ///< @brief 清空所有音频资源
     };
@@ -67,6 +67,8 @@ namespace engine::resource {
         TTF_Font* getFont(const std::string& file_path, int point_size);      ///< @brief 尝试获取已加载字体的指针，如果未加载则尝试加载
         void unloadFont(const std::string& file_path, int point_size);        ///< @brief 卸载特定字体（通过路径和大小标识）
         void clearFonts();                                                    ///< @brief 清空所有缓存的字体
+        /// @brief 字体是否已缓存
+        bool hasFont(const std::string& file_path, int point_size) const { return fonts_.contains(FontKey(file_path, point_size)); }
     };
 
 } // namespace engine::resource
\ No newline at end of file
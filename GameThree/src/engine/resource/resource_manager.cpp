@@ -2,8 +2,11 @@
 #include "texture_manager.h"
 #include "audio_manager.h"
 #include "font_manager.h" 
+#include "resource_manifest.h"
+#include "../render/animation_library.h"
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h> 
+#include <SDL3/SDL_timer.h>
 #include <glm/glm.hpp>
 #include <spdlog/spdlog.h>
 
@@ -16,29 +19,63 @@ namespace engine::resource {
         texture_manager_ = std::make_unique<TextureManager>(renderer);
         audio_manager_ = std::make_unique<AudioManager>();
         font_manager_ = std::make_unique<FontManager>();
+        animation_library_ = std::make_unique<engine::render::AnimationLibrary>();
 
         spdlog::trace("ResourceManager 构造成功。");
         // RAII: 构造成功即代表资源管理器可以正常工作，无需再初始化，无需检查指针是否为空
     }
 
     void ResourceManager::clear() {
+        animation_library_->clear();
         font_manager_->clearFonts();
         audio_manager_->clearSounds();
         texture_manager_->clearTextures();
         spdlog::trace("ResourceManager 中的资源通过 clear() 清空。");
     }
 
+    void ResourceManager::preload(const ResourceManifest& manifest) {
+        if (manifest.empty()) return;
+        const auto start_ns = SDL_GetTicksNS();
+
+        const auto texture_count = texture_manager_->preloadTextures(manifest.getTextures());
+        std::size_t other_count = 0;
+        for (const auto& file_path : manifest.getSounds()) {
+            if (!audio_manager_->hasSound(file_path) && audio_manager_->loadSound(file_path)) ++other_count;
+        }
+        for (const auto& file_path : manifest.getMusic()) {
+            if (!audio_manager_->hasMusic(file_path) && audio_manager_->loadMusic(file_path)) ++other_count;
+        }
+        for (const auto& [file_path, point_size] : manifest.getFonts()) {
+            if (!font_manager_->hasFont(file_path, point_size) && font_manager_->loadFont(file_path, point_size)) ++other_count;
+        }
+
+        spdlog::info("预加载资源清单：{} 项，新载入 {} 张纹理、{} 个音频/字体，用时 {:.1f} 毫秒。", manifest.size(),
+            texture_count, other_count, static_cast<double>(SDL_GetTicksNS() - start_ns) / 1'000'000.0);
+    }
+
+    void ResourceManager::reportLateLoad(const char* kind, const std::string& name) {
+        ++late_load_count_;
+        spdlog::warn("[卡顿来源] 场景 '{}' 激活后才加载{} '{}'，应加入该场景的资源清单。", watched_scene_, kind, name);
+    }
+
     // --- 纹理接口实现 ---
     SDL_Texture* ResourceManager::loadTexture(const std::string& file_path) {
+        if (isWatchingLoads() && !texture_manager_->isTextureKnown(file_path)) reportLateLoad("纹理", file_path);
         // 构造函数已经确保了 texture_manager_ 不为空，因此不需要再进行if检查，以免性能浪费
         return texture_manager_->loadTexture(file_path);
     }
 
+    SDL_Texture* ResourceManager::loadTexture(const std::string& file_path, SDL_Surface* surface) {
+        return texture_manager_->loadTexture(file_path, surface);
+    }
+
     SDL_Texture* ResourceManager::getTexture(const std::string& file_path) {
+        if (isWatchingLoads() && !texture_manager_->isTextureKnown(file_path)) reportLateLoad("纹理", file_path);
         return texture_manager_->getTexture(file_path);
     }
 
     glm::vec2 ResourceManager::getTextureSize(const std::string& file_path) {
+        if (isWatchingLoads() && !texture_manager_->isTextureKnown(file_path)) reportLateLoad("纹理", file_path);
         return texture_manager_->getTextureSize(file_path);
     }
 
@@ -50,12 +87,43 @@ namespace engine::resource {
         texture_manager_->clearTextures();
     }
 
+    TextureHandle ResourceManager::requestTexture(const std::string& file_path) {
+        if (isWatchingLoads() && !texture_manager_->isTextureKnown(file_path)) reportLateLoad("纹理", file_path);
+        return texture_manager_->requestTexture(file_path);
+    }
+
+    TextureState ResourceManager::getTextureState(TextureHandle handle) const {
+        return texture_manager_->getTextureState(handle);
+    }
+
+    SDL_Texture* ResourceManager::getTexture(TextureHandle handle) {
+        return texture_manager_->getTexture(handle);
+    }
+
+    std::size_t ResourceManager::uploadPendingTextures(std::uint64_t budget_ns) {
+        return texture_manager_->uploadPendingTextures(budget_ns);
+    }
+
+    std::size_t ResourceManager::getPendingTextureCount() const {
+        return texture_manager_->getPendingTextureCount();
+    }
+
+    bool ResourceManager::isPlaceholderTexture(const SDL_Texture* texture) const {
+        return texture_manager_->isPlaceholder(texture);
+    }
+
     // --- 音频接口实现 ---
     Mix_Chunk* ResourceManager::loadSound(const std::string& file_path) {
+        if (isWatchingLoads() && !audio_manager_->hasSound(file_path)) reportLateLoad("音效", file_path);
         return audio_manager_->loadSound(file_path);
     }
 
+    Mix_Chunk* ResourceManager::addSound(const std::string& file_path, Mix_Chunk* chunk) {
+        return audio_manager_->addSound(file_path, chunk);
+    }
+
     Mix_Chunk* ResourceManager::getSound(const std::string& file_path) {
+        if (isWatchingLoads() && !audio_manager_->hasSound(file_path)) reportLateLoad("音效", file_path);
         return audio_manager_->getSound(file_path);
     }
 
@@ -68,10 +136,12 @@ namespace engine::resource {
     }
 
     Mix_Music* ResourceManager::loadMusic(const std::string& file_path) {
+        if (isWatchingLoads() && !audio_manager_->hasMusic(file_path)) reportLateLoad("音乐", file_path);
         return audio_manager_->loadMusic(file_path);
     }
 
     Mix_Music* ResourceManager::getMusic(const std::string& file_path) {
+        if (isWatchingLoads() && !audio_manager_->hasMusic(file_path)) reportLateLoad("音乐", file_path);
         return audio_manager_->getMusic(file_path);
     }
 
@@ -85,10 +155,12 @@ namespace engine::resource {
 
     // --- 字体接口实现 ---
     TTF_Font* ResourceManager::loadFont(const std::string& file_path, int point_size) {
+        if (isWatchingLoads() && !font_manager_->hasFont(file_path, point_size)) reportLateLoad("字体", file_path + '#' + std::to_string(point_size));
         return font_manager_->loadFont(file_path, point_size);
     }
 
     TTF_Font* ResourceManager::getFont(const std::string& file_path, int point_size) {
+        if (isWatchingLoads() && !font_manager_->hasFont(file_path, point_size)) reportLateLoad("字体", file_path + '#' + std::to_string(point_size));
         return font_manager_->getFont(file_path, point_size);
     }
 
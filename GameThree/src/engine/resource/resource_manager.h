@@ -1,4 +1,7 @@
 #pragma once
+#include "texture_handle.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory> // 用于 std::unique_ptr
 #include <string> // 用于 std::string
 #include <glm/glm.hpp>
@@ -6,16 +9,22 @@
 // 前向声明 SDL 类型
 struct SDL_Renderer;
 struct SDL_Texture;
+struct SDL_Surface;
 struct Mix_Chunk;
 struct Mix_Music;
 struct TTF_Font;
 
+namespace engine::render {
+    class AnimationLibrary;
+}
+
 namespace engine::resource {
 
     // 前向声明内部管理器
     class TextureManager;
     class AudioManager;
     class FontManager;
+    class ResourceManifest;
 
     /**
      * @brief 作为访问各种资源管理器的中央控制点（外观模式 Facade）。
@@ -27,6 +36,11 @@ namespace engine::resource {
         std::unique_ptr<TextureManager> texture_manager_;
         std::unique_ptr<AudioManager> audio_manager_;
         std::unique_ptr<FontManager> font_manager_;
+        std::unique_ptr<engine::render::AnimationLibrary> animation_library_;   ///< @brief 共享的不可变动画片段
+
+        bool late_load_report_ = false;         ///< @brief 诊断模式：报告场景激活后才加载的资源（卡顿来源）
+        std::string watched_scene_;             ///< @brief 正在监视的激活场景名称（为空表示场景切换中，不报告）
+        std::size_t late_load_count_ = 0;       ///< @brief 已报告的激活后加载次数
 
     public:
         /**
@@ -39,6 +53,18 @@ namespace engine::resource {
 
         void clear();        ///< @brief 清空所有资源
 
+        /**
+         * @brief 载入资源清单中尚未缓存的全部资源（场景激活前由 SceneManager 调用）。
+         * @details 纹理由线程池并行解码后在调用线程上传；音效、音乐和字体依次载入。
+         */
+        void preload(const ResourceManifest& manifest);
+
+        // -- 激活后加载诊断 --
+        void setLateLoadReport(bool enabled) { late_load_report_ = enabled; }  ///< @brief 开启/关闭激活后加载报告（诊断模式）
+        void watchLateLoads(const std::string& scene_name) { watched_scene_ = scene_name; }  ///< @brief 场景已激活：之后的首次加载都视为卡顿来源
+        void stopWatchingLateLoads() { watched_scene_.clear(); }              ///< @brief 场景切换中：加载属于准备工作，不报告
+        std::size_t getLateLoadCount() const { return late_load_count_; }     ///< @brief 获取已报告的激活后加载次数
+
         // 当前设计中，我们只需要一个ResourceManager，所有权不变，所以不需要拷贝、移动相关构造及赋值运算符
         ResourceManager(const ResourceManager&) = delete;
         ResourceManager& operator=(const ResourceManager&) = delete;
@@ -48,13 +74,21 @@ namespace engine::resource {
         // --- 统一资源访问接口 ---
         // -- Texture --
         SDL_Texture* loadTexture(const std::string& file_path);     ///< @brief 载入纹理资源
-        SDL_Texture* getTexture(const std::string& file_path);      ///< @brief 尝试获取已加载纹理的指针，如果未加载则尝试加载
+        SDL_Texture* loadTexture(const std::string& file_path, SDL_Surface* surface);   ///< @brief 由已解码的图片创建纹理（不获取 surface 所有权）
+        SDL_Texture* getTexture(const std::string& file_path);      ///< @brief 获取已加载纹理的指针，未加载时转为后台加载并返回占位纹理
         void unloadTexture(const std::string& file_path);          ///< @brief 卸载指定的纹理资源
         glm::vec2 getTextureSize(const std::string& file_path);    ///< @brief 获取指定纹理的尺寸
         void clearTextures();                                      ///< @brief 清空所有纹理资源
+        TextureHandle requestTexture(const std::string& file_path); ///< @brief 请求后台加载纹理，立即返回句柄
+        TextureState getTextureState(TextureHandle handle) const;   ///< @brief 查询异步纹理请求的状态
+        SDL_Texture* getTexture(TextureHandle handle);              ///< @brief 通过句柄获取纹理（加载中返回占位纹理）
+        std::size_t uploadPendingTextures(std::uint64_t budget_ns); ///< @brief 在时间预算内上传后台解码好的纹理（主线程每帧调用）
+        std::size_t getPendingTextureCount() const;                 ///< @brief 获取尚未完成的异步纹理请求数量
+        bool isPlaceholderTexture(const SDL_Texture* texture) const;///< @brief 判断纹理是否为加载中的占位纹理
 
         // -- Sound Effects (Chunks) --
         Mix_Chunk* loadSound(const std::string& file_path);         ///< @brief 载入音效资源
+        Mix_Chunk* addSound(const std::string& file_path, Mix_Chunk* chunk);    ///< @brief 缓存已解码的音效（获取 chunk 所有权）
         Mix_Chunk* getSound(const std::string& file_path);          ///< @brief 尝试获取已加载音效的指针，如果未加载则尝试加载
         void unloadSound(const std::string& file_path);             ///< @brief 卸载指定的音效资源
         void clearSounds();                                         ///< @brief 清空所有音效资源
@@ -70,6 +104,14 @@ namespace engine::resource {
         TTF_Font* getFont(const std::string& file_path, int point_size);      ///< @brief 尝试获取已加载字体的指针，如果未加载则尝试加载
         void unloadFont(const std::string& file_path, int point_size);        ///< @brief 卸载指定的字体资源
         void clearFonts();                                                  ///< @brief 清空所有字体资源
+
+        // -- Animations --
+        engine::render::AnimationLibrary& getAnimationLibrary() const { return *animation_library_; }  ///< @brief 获取共享动画库
+
+    private:
+        bool isWatchingLoads() const { return late_load_report_ && !watched_scene_.empty(); }  ///< @brief 是否需要检查激活后加载
+        /// @brief 报告一次激活后加载（kind 为资源类别，name 为资源标识）
+        void reportLateLoad(const char* kind, const std::string& name);
     };
 
 } // namespace engine::resource
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "resource_manifest.h"
+
+namespace engine::resource {
+
+    void ResourceManifest::addTexture(const std::string& file_path) {
+        if (!file_path.empty() && markSeen('T', file_path)) textures_.push_back(file_path);
+    }
+
+    void ResourceManifest::addSound(const std::string& file_path) {
+        if (!file_path.empty() && markSeen('S', file_path)) sounds_.push_back(file_path);
+    }
+
+    void ResourceManifest::addMusic(const std::string& file_path) {
+        if (!file_path.empty() && markSeen('M', file_path)) music_.push_back(file_path);
+    }
+
+    void ResourceManifest::addFont(const std::string& file_path, int point_size) {
+        if (!file_path.empty() && markSeen('F', file_path + '#' + std::to_string(point_size))) {
+            fonts_.emplace_back(file_path, point_size);
+        }
+    }
+
+    void ResourceManifest::merge(const ResourceManifest& other) {
+        for (const auto& file_path : other.textures_) addTexture(file_path);
+        for (const auto& file_path : other.sounds_) addSound(file_path);
+        for (const auto& file_path : other.music_) addMusic(file_path);
+        for (const auto& [file_path, point_size] : other.fonts_) addFont(file_path, point_size);
+    }
+
+    void ResourceManifest::clear() {
+        textures_.clear();
+        sounds_.clear();
+        music_.clear();
+        fonts_.clear();
+        seen_.clear();
+    }
+
+    bool ResourceManifest::markSeen(char kind, const std::string& key) {
+        return seen_.insert(kind + key).second;
+    }
+
+} // namespace engine::resource
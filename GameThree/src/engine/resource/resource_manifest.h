@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace engine::resource {
+
+    /**
+     * @brief 资源清单：一个场景（或关卡）会用到的纹理、音效、音乐和字体。
+     *
+     * 场景在激活前由 SceneManager 通过 ResourceManager::preload 一次性载入清单中的资源，
+     * 避免首次绘制或播放时才从磁盘加载。添加时自动去重，保持添加顺序。
+     */
+    class ResourceManifest final {
+        std::vector<std::string> textures_;                 ///< @brief 纹理路径
+        std::vector<std::string> sounds_;                   ///< @brief 音效路径
+        std::vector<std::string> music_;                    ///< @brief 音乐路径
+        std::vector<std::pair<std::string, int>> fonts_;    ///< @brief 字体 (路径, 点大小)
+        std::unordered_set<std::string> seen_;              ///< @brief 已添加条目的键（类别前缀 + 路径），用于去重
+
+    public:
+        void addTexture(const std::string& file_path);              ///< @brief 添加纹理
+        void addSound(const std::string& file_path);                ///< @brief 添加音效
+        void addMusic(const std::string& file_path);                ///< @brief 添加音乐
+        void addFont(const std::string& file_path, int point_size); ///< @brief 添加指定点大小的字体
+        void merge(const ResourceManifest& other);                  ///< @brief 合并另一个清单
+        void clear();                                               ///< @brief 清空清单
+
+        const std::vector<std::string>& getTextures() const { return textures_; }               ///< @brief 获取纹理路径
+        const std::vector<std::string>& getSounds() const { return sounds_; }                   ///< @brief 获取音效路径
+        const std::vector<std::string>& getMusic() const { return music_; }                     ///< @brief 获取音乐路径
+        const std::vector<std::pair<std::string, int>>& getFonts() const { return fonts_; }     ///< @brief 获取字体 (路径, 点大小)
+        std::size_t size() const { return textures_.size() + sounds_.size() + music_.size() + fonts_.size(); }  ///< @brief 获取条目总数
+        bool empty() const { return size() == 0; }                                              ///< @brief 清单是否为空
+
+    private:
+        /// @brief 记录条目键，首次出现时返回 true
+        bool markSeen(char kind, const std::string& key);
+    };
+
+} // namespace engine::resource
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+namespace engine::resource {
+
+    /// @brief 异步纹理请求的状态
+    enum class TextureState {
+        PENDING,        ///< @brief 后台解码中或等待上传（期间渲染占位纹理）
+        READY,          ///< @brief 已上传，可以使用
+        UNAVAILABLE     ///< @brief 加载失败或已被卸载
+    };
+
+    /**
+     * @brief 异步纹理请求的句柄，由 ResourceManager::requestTexture 立即返回。
+     *
+     * 同一路径的多次请求返回相同的句柄。句柄只是请求槽位编号加代数，可以随意拷贝；
+     * 每个路径固定使用一个槽位，纹理被卸载或清空时槽位代数递增，旧句柄的状态变为 UNAVAILABLE（需要时重新请求）。
+     */
+    struct TextureHandle {
+        std::uint32_t id = 0;           ///< @brief 请求槽位编号（槽位下标 + 1，0 表示无效句柄）
+        std::uint32_t generation = 0;   ///< @brief 发放句柄时槽位的代数
+
+        bool isValid() const { return id != 0; }   ///< @brief 是否为有效句柄
+        bool operator==(const TextureHandle&) const = default;
+    };
+
+} // namespace engine::resource
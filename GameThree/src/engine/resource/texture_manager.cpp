@@ -1,5 +1,7 @@
 #include "texture_manager.h"
+#include "../utils/thread_pool.h"
 #include <SDL3_image/SDL_image.h> // 用于 IMG_LoadTexture, IMG_Init, IMG_Quit
+#include <SDL3/SDL_timer.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
@@ -10,9 +12,41 @@ namespace engine::resource {
             throw std::runtime_error("TextureManager 构造失败: 渲染器指针为空。");
         }
         // SDL3中不再需要手动调用IMG_Init/IMG_Quit
+        createPlaceholder();
+        decode_queue_ = std::make_shared<DecodeQueue>();
         spdlog::trace("TextureManager 构造成功。");
     }
 
+    TextureManager::~TextureManager() {
+        // 尚未开始的解码任务直接跳过，正在解码的等它结束（之后任务不再访问 SDL）
+        std::unique_lock lock(decode_queue_->mutex);
+        decode_queue_->cancelled = true;
+        decode_queue_->idle.wait(lock, [this]() { return decode_queue_->in_flight == 0; });
+        for (auto& image : decode_queue_->decoded) {
+            SDL_DestroySurface(image.surface);
+        }
+        decode_queue_->decoded.clear();
+        for (auto& image : uploads_) {
+            SDL_DestroySurface(image.surface);
+        }
+    }
+
+    void TextureManager::createPlaceholder() {
+        // 2x2 的半透明灰色棋盘格，拉伸到精灵大小绘制
+        constexpr Uint8 pixels[] = {
+            160, 160, 160, 96,   96, 96, 96, 96,
+            96, 96, 96, 96,      160, 160, 160, 96,
+        };
+        SDL_Texture* raw_texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 2, 2);
+        if (!raw_texture || !SDL_UpdateTexture(raw_texture, nullptr, pixels, 2 * 4)) {
+            SDL_DestroyTexture(raw_texture);
+            throw std::runtime_error(std::string("TextureManager 构造失败: 无法创建占位纹理: ") + SDL_GetError());
+        }
+        SDL_SetTextureBlendMode(raw_texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST);
+        placeholder_.reset(raw_texture);
+    }
+
     SDL_Texture* TextureManager::loadTexture(const std::string& file_path) {
         // 检查是否已加载
         auto it = textures_.find(file_path);
@@ -35,11 +69,40 @@ namespace engine::resource {
 
         // 使用带有自定义删除器的 unique_ptr 存储加载的纹理
         textures_.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
+        markLoaded(file_path);
         spdlog::debug("成功加载并缓存纹理: {}", file_path);
 
         return raw_texture;
     }
 
+    SDL_Texture* TextureManager::loadTexture(const std::string& file_path, SDL_Surface* surface) {
+        // 检查是否已加载
+        auto it = textures_.find(file_path);
+        if (it != textures_.end()) {
+            return it->second.get();
+        }
+        if (!surface) {
+            spdlog::error("创建纹理失败: '{}': 图片为空", file_path);
+            return nullptr;
+        }
+
+        // 只有上传到GPU这一步在主线程完成
+        SDL_Texture* raw_texture = SDL_CreateTextureFromSurface(renderer_, surface);
+        if (!raw_texture) {
+            spdlog::error("创建纹理失败: '{}': {}", file_path, SDL_GetError());
+            return nullptr;
+        }
+        // 与 loadTexture 一致，使用最邻近插值
+        if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
+            spdlog::warn("无法设置纹理缩放模式为最邻近插值");
+        }
+
+        textures_.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
+        markLoaded(file_path);
+        spdlog::debug("成功创建并缓存纹理: {}", file_path);
+        return raw_texture;
+    }
+
     SDL_Texture* TextureManager::getTexture(const std::string& file_path) {
         // 查找现有纹理
         auto it = textures_.find(file_path);
@@ -47,14 +110,27 @@ namespace engine::resource {
             return it->second.get();
         }
 
-        // 如果未找到，尝试加载它
-        spdlog::warn("纹理 '{}' 未找到缓存，尝试加载。", file_path);
-        return loadTexture(file_path);
+        // 已经请求过：加载中返回占位纹理，加载失败返回空（不再重复尝试）
+        if (auto slot = findActiveSlot(file_path); slot) {
+            return getTexture(makeHandle(*slot));
+        }
+
+        // 如果未找到，转为后台加载（通常发生在渲染路径中，不能在这里同步解码）
+        spdlog::warn("纹理 '{}' 未找到缓存，转为后台加载，完成前绘制占位纹理。", file_path);
+        return getTexture(requestTexture(file_path));
     }
 
     glm::vec2 TextureManager::getTextureSize(const std::string& file_path) {
-        // 获取纹理
-        SDL_Texture* texture = getTexture(file_path);
+        // 获取纹理（需要真实尺寸，未加载时只能同步加载）
+        SDL_Texture* texture = nullptr;
+        auto it = textures_.find(file_path);
+        if (it != textures_.end()) {
+            texture = it->second.get();
+        }
+        else {
+            spdlog::warn("纹理 '{}' 未找到缓存，同步加载以获取尺寸。", file_path);
+            texture = loadTexture(file_path);
+        }
         if (!texture) {
             spdlog::error("无法获取纹理: {}", file_path);
             return glm::vec2(0);
@@ -70,12 +146,19 @@ namespace engine::resource {
     }
 
     void TextureManager::unloadTexture(const std::string& file_path) {
+        // 旧句柄随之失效（槽位保留，再次请求时复用）；尚在解码的图片到达后会被丢弃
+        auto slot = findActiveSlot(file_path);
+        const bool requested = slot.has_value();
+        if (requested) {
+            retireRequest(requests_[*slot]);
+        }
+
         auto it = textures_.find(file_path);
         if (it != textures_.end()) {
             spdlog::debug("卸载纹理: {}", file_path);
             textures_.erase(it); // unique_ptr 通过自定义删除器处理删除
         }
-        else {
+        else if (!requested) {
             spdlog::warn("尝试卸载不存在的纹理: {}", file_path);
         }
     }
@@ -85,6 +168,171 @@ namespace engine::resource {
             spdlog::debug("正在清除所有 {} 个缓存的纹理。", textures_.size());
             textures_.clear(); // unique_ptr 处理所有元素的删除
         }
+        // 所有句柄失效（槽位保留，再次请求时复用）；尚在解码或等待上传的图片到达后会被丢弃
+        for (auto& request : requests_) {
+            if (request.active) retireRequest(request);
+        }
+    }
+
+    std::size_t TextureManager::preloadTextures(const std::vector<std::string>& file_paths) {
+        std::vector<const std::string*> missing;
+        for (const auto& file_path : file_paths) {
+            if (!textures_.contains(file_path)) missing.push_back(&file_path);
+        }
+        if (missing.empty()) return 0;
+
+        // 解码与渲染器无关，可以并行；上传必须在主线程
+        std::vector<DecodedImage> images(missing.size());
+        engine::utils::ThreadPool::getInstance().parallelFor(missing.size(), [&](std::size_t i) {
+            images[i].surface = IMG_Load(missing[i]->c_str());
+            if (!images[i].surface) images[i].error = SDL_GetError();
+        });
+
+        std::size_t loaded = 0;
+        for (std::size_t i = 0; i < missing.size(); ++i) {
+            auto& image = images[i];
+            if (!image.surface) {
+                spdlog::error("加载纹理失败: '{}': {}", *missing[i], image.error);
+                continue;
+            }
+            if (loadTexture(*missing[i], image.surface)) ++loaded;
+            SDL_DestroySurface(image.surface);
+        }
+        return loaded;
+    }
+
+    TextureHandle TextureManager::requestTexture(const std::string& file_path) {
+        // 每个路径固定一个槽位：首次请求时分配，之后（包括卸载后再次请求）复用
+        auto [slot_it, inserted] = request_slots_.try_emplace(file_path, static_cast<std::uint32_t>(requests_.size()));
+        if (inserted) {
+            requests_.emplace_back().file_path = file_path;
+        }
+        const auto slot = slot_it->second;
+        auto& request = requests_[slot];
+        if (request.active) {
+            return makeHandle(slot);
+        }
+
+        request.active = true;
+        if (textures_.contains(file_path)) {    // 已同步加载过
+            request.state = TextureState::READY;
+        }
+        else {
+            request.state = TextureState::PENDING;
+            ++pending_count_;
+            submitDecode(slot, request.generation, file_path);
+        }
+        return makeHandle(slot);
+    }
+
+    TextureState TextureManager::getTextureState(TextureHandle handle) const {
+        if (!handle.isValid() || handle.id > requests_.size()) return TextureState::UNAVAILABLE;
+        const auto& request = requests_[handle.id - 1];
+        // 代数不同说明句柄对应的请求已被卸载或清空（槽位可能已被同一路径的新请求复用）
+        if (!request.active || request.generation != handle.generation) return TextureState::UNAVAILABLE;
+        return request.state;
+    }
+
+    SDL_Texture* TextureManager::getTexture(TextureHandle handle) {
+        switch (getTextureState(handle)) {
+        case TextureState::PENDING:
+            return placeholder_.get();
+        case TextureState::READY: {
+            auto it = textures_.find(requests_[handle.id - 1].file_path);
+            return it != textures_.end() ? it->second.get() : nullptr;
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    std::size_t TextureManager::uploadPendingTextures(std::uint64_t budget_ns) {
+        {
+            std::lock_guard lock(decode_queue_->mutex);
+            for (auto& image : decode_queue_->decoded) {
+                uploads_.push_back(std::move(image));
+            }
+            decode_queue_->decoded.clear();
+        }
+
+        const auto start_ns = SDL_GetTicksNS();
+        std::size_t uploaded = 0;
+        while (!uploads_.empty()) {
+            auto image = std::move(uploads_.front());
+            uploads_.pop_front();
+            auto& request = requests_[image.slot];
+            // 已被卸载、清空（代数已变）或同步加载的请求直接丢弃结果
+            if (request.generation == image.generation && request.state == TextureState::PENDING) {
+                if (!image.surface) {
+                    spdlog::error("加载纹理失败: '{}': {}", request.file_path, image.error);
+                    finishRequest(request, TextureState::UNAVAILABLE);
+                }
+                else if (!loadTexture(request.file_path, image.surface)) {  // 成功时 markLoaded 会把请求标记为 READY
+                    finishRequest(request, TextureState::UNAVAILABLE);
+                }
+                ++uploaded;
+            }
+            SDL_DestroySurface(image.surface);
+            if (uploaded > 0 && SDL_GetTicksNS() - start_ns >= budget_ns) break;
+        }
+        if (uploaded > 0) {
+            spdlog::trace("本帧上传 {} 张纹理，剩余 {} 个请求。", uploaded, pending_count_);
+        }
+        return uploaded;
+    }
+
+    void TextureManager::submitDecode(std::uint32_t slot, std::uint32_t generation, const std::string& file_path) {
+        auto queue = decode_queue_;
+        {
+            std::lock_guard lock(queue->mutex);
+            ++queue->in_flight;
+        }
+        engine::utils::ThreadPool::getInstance().submit([queue, slot, generation, file_path]() {
+            DecodedImage image{ slot, generation, nullptr, {} };
+            bool cancelled = false;
+            {
+                std::lock_guard lock(queue->mutex);
+                cancelled = queue->cancelled;
+            }
+            if (!cancelled) {
+                image.surface = IMG_Load(file_path.c_str());    // 只解码到 SDL_Surface，上传留给主线程
+                if (!image.surface) image.error = SDL_GetError();
+            }
+
+            std::lock_guard lock(queue->mutex);
+            if (queue->cancelled) {
+                SDL_DestroySurface(image.surface);
+            }
+            else {
+                queue->decoded.push_back(std::move(image));
+            }
+            if (--queue->in_flight == 0) queue->idle.notify_all();
+        });
+    }
+
+    void TextureManager::markLoaded(const std::string& file_path) {
+        auto slot = findActiveSlot(file_path);
+        if (!slot) return;
+        auto& request = requests_[*slot];
+        if (request.state == TextureState::PENDING) finishRequest(request, TextureState::READY);
+    }
+
+    void TextureManager::finishRequest(TextureRequest& request, TextureState state) {
+        request.state = state;
+        --pending_count_;
+    }
+
+    void TextureManager::retireRequest(TextureRequest& request) {
+        if (request.state == TextureState::PENDING) finishRequest(request, TextureState::UNAVAILABLE);
+        request.state = TextureState::UNAVAILABLE;
+        request.active = false;
+        ++request.generation;
+    }
+
+    std::optional<std::uint32_t> TextureManager::findActiveSlot(const std::string& file_path) const {
+        auto it = request_slots_.find(file_path);
+        if (it == request_slots_.end() || !requests_[it->second].active) return std::nullopt;
+        return it->second;
     }
 
 } // namespace engine::resource
\ No newline at end of file
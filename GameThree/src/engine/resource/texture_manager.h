@@ -1,8 +1,16 @@
 #pragma once
+#include "texture_handle.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>       // 用于 std::unique_ptr
+#include <mutex>
+#include <optional>
 #include <stdexcept>    // 用于 std::runtime_error
 #include <string>       // 用于 std::string
 #include <unordered_map> // 用于 std::unordered_map
+#include <vector>
 #include <SDL3/SDL_render.h> // 用于 SDL_Texture 和 SDL_Renderer
 #include <glm/glm.hpp>
 
@@ -13,6 +21,10 @@ namespace engine::resource {
      *
      * 在构造时初始化。使用文件路径作为键，确保纹理只加载一次并正确释放。
      * 依赖于一个有效的 SDL_Renderer，构造失败会抛出异常。
+     *
+     * 异步加载：requestTexture 把图片解码（IMG_Load）交给线程池后立即返回句柄；
+     * 解码好的图片由主线程每帧在时间预算内上传为纹理（uploadPendingTextures）。上传完成之前获取纹理得到占位纹理。
+     * 渲染时遇到未缓存的纹理也走这条路径，不会在绘制中同步解码。
      */
     class TextureManager final {
         friend class ResourceManager;
@@ -27,11 +39,43 @@ namespace engine::resource {
             }
         };
 
+        /// @brief 后台解码的结果
+        struct DecodedImage {
+            std::uint32_t slot = 0;             ///< @brief 请求槽位下标
+            std::uint32_t generation = 0;       ///< @brief 提交时槽位的代数（代数已变说明请求已被卸载或清空，结果丢弃）
+            SDL_Surface* surface = nullptr;     ///< @brief 解码出的图片（拥有，失败时为空）
+            std::string error;                  ///< @brief 解码失败的原因
+        };
+
+        /// @brief 与后台解码任务共享的状态（任务可能在管理器析构时仍在队列中，因此由 shared_ptr 持有）
+        struct DecodeQueue {
+            std::mutex mutex;                   ///< @brief 保护以下成员
+            std::condition_variable idle;       ///< @brief 所有任务完成时通知（析构时等待）
+            std::vector<DecodedImage> decoded;  ///< @brief 已解码、待主线程取走的图片
+            std::size_t in_flight = 0;          ///< @brief 已提交、尚未完成的任务数量
+            bool cancelled = false;             ///< @brief 管理器正在析构，尚未开始的任务直接跳过
+        };
+
+        /// @brief 异步纹理请求槽位（下标为句柄编号 - 1，每个路径固定一个槽位，卸载后再次请求时复用）
+        struct TextureRequest {
+            std::string file_path;                          ///< @brief 纹理文件路径
+            TextureState state = TextureState::UNAVAILABLE; ///< @brief 当前状态
+            std::uint32_t generation = 1;                   ///< @brief 代数（请求被卸载或清空时递增，使旧句柄失效）
+            bool active = false;                            ///< @brief 槽位当前是否有有效的请求
+        };
+
         // 存储文件路径和指向管理纹理的 unique_ptr 的映射。
         std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures_;
 
         SDL_Renderer* renderer_ = nullptr; // 指向主渲染器的非拥有指针
 
+        std::unique_ptr<SDL_Texture, SDLTextureDeleter> placeholder_;   ///< @brief 上传完成之前代替纹理绘制的占位纹理
+        std::vector<TextureRequest> requests_;                          ///< @brief 请求槽位（句柄编号 - 1 为下标，数量等于请求过的不同路径数）
+        std::unordered_map<std::string, std::uint32_t> request_slots_;  ///< @brief 文件路径 -> 请求槽位下标（卸载后保留，再次请求时复用）
+        std::size_t pending_count_ = 0;                                 ///< @brief 处于 PENDING 状态的请求数量
+        std::deque<DecodedImage> uploads_;                              ///< @brief 已取回、等待上传的图片（超出上一帧预算的留到下一帧）
+        std::shared_ptr<DecodeQueue> decode_queue_;                     ///< @brief 与后台解码任务共享的状态
+
     public:
         /**
          * @brief 构造函数，执行初始化。
@@ -39,6 +83,7 @@ namespace engine::resource {
          * @throws std::runtime_error 如果 renderer 为 nullptr 或初始化失败。
          */
         explicit TextureManager(SDL_Renderer* renderer);
+        ~TextureManager();      ///< @brief 等待尚在进行的后台解码结束，释放未上传的图片
 
         // 当前设计中，我们只需要一个TextureManager，所有权不变，所以不需要拷贝、移动相关构造及赋值运算符
         TextureManager(const TextureManager&) = delete;
@@ -49,10 +94,43 @@ namespace engine::resource {
     private: // 仅供 ResourceManager 访问的方法
 
         SDL_Texture* loadTexture(const std::string& file_path);      ///< @brief 从文件路径加载纹理
-        SDL_Texture* getTexture(const std::string& file_path);       ///< @brief 尝试获取已加载纹理的指针，如果未加载则尝试加载
-        glm::vec2 getTextureSize(const std::string& file_path);      ///< @brief 获取指定纹理的尺寸
+        /// @brief 由已解码的图片（如后台线程加载的）创建纹理并以 file_path 为键缓存；已缓存则直接返回。不获取 surface 所有权
+        SDL_Texture* loadTexture(const std::string& file_path, SDL_Surface* surface);
+        /// @brief 获取已加载纹理的指针；未加载时发起异步请求并返回占位纹理，加载失败返回 nullptr
+        SDL_Texture* getTexture(const std::string& file_path);
+        glm::vec2 getTextureSize(const std::string& file_path);      ///< @brief 获取指定纹理的尺寸（未加载时同步加载）
         void unloadTexture(const std::string& file_path);            ///< @brief 卸载指定的纹理资源
         void clearTextures();                                        ///< @brief 清空所有纹理资源
+        /// @brief 由线程池并行解码尚未缓存的图片，再在调用线程（主线程）逐个上传；返回新加载的纹理数量
+        std::size_t preloadTextures(const std::vector<std::string>& file_paths);
+        /// @brief 纹理是否已缓存或已发起异步请求（之后再获取不会触发新的加载）
+        bool isTextureKnown(const std::string& file_path) const { return textures_.contains(file_path) || findActiveSlot(file_path).has_value(); }
+
+        /// @brief 请求异步加载纹理并立即返回句柄（已缓存时状态直接为 READY）
+        TextureHandle requestTexture(const std::string& file_path);
+        TextureState getTextureState(TextureHandle handle) const;    ///< @brief 查询异步请求的状态（无效句柄返回 UNAVAILABLE）
+        /// @brief 通过句柄获取纹理：READY 返回纹理，PENDING 返回占位纹理，UNAVAILABLE 返回 nullptr
+        SDL_Texture* getTexture(TextureHandle handle);
+
+        /**
+         * @brief 把后台解码好的图片上传为纹理（主线程每帧调用一次）。
+         * @param budget_ns 本帧的时间预算（纳秒）；至少上传一张，用完预算后剩余的留到下一帧
+         * @return 本帧上传（或确认失败）的请求数量
+         */
+        std::size_t uploadPendingTextures(std::uint64_t budget_ns);
+        std::size_t getPendingTextureCount() const { return pending_count_; }   ///< @brief 获取尚未完成的异步请求数量
+        /// @brief 判断纹理是否为占位纹理（占位纹理没有有意义的源矩形，应整张绘制）
+        bool isPlaceholder(const SDL_Texture* texture) const { return texture && texture == placeholder_.get(); }
+
+    private:
+        void createPlaceholder();                               ///< @brief 创建占位纹理（构造时调用，失败抛出异常）
+        void submitDecode(std::uint32_t slot, std::uint32_t generation, const std::string& file_path);  ///< @brief 把解码任务交给线程池
+        void markLoaded(const std::string& file_path);          ///< @brief 纹理被同步加载后，把对应的 PENDING 请求标记为 READY
+        void finishRequest(TextureRequest& request, TextureState state);    ///< @brief 结束一个 PENDING 请求
+        void retireRequest(TextureRequest& request);            ///< @brief 作废一个有效请求（卸载或清空时调用，代数递增使旧句柄失效）
+        std::optional<std::uint32_t> findActiveSlot(const std::string& file_path) const;    ///< @brief 查找路径当前有效的请求槽位
+        /// @brief 为槽位当前的请求生成句柄
+        TextureHandle makeHandle(std::uint32_t slot) const { return TextureHandle{ slot + 1, requests_[slot].generation }; }
     };
 
 } // namespace engine::resource
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "cooked_level.h"
+#include <filesystem>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene::cooked {
+
+    std::string getCookedPath(const std::string& map_path)
+    {
+        return std::filesystem::path(map_path).replace_extension(".g3lvl").string();
+    }
+
+    std::optional<std::vector<std::uint8_t>> readFile(const std::string& file_path)
+    {
+        std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return std::nullopt;
+        auto size = file.tellg();
+        if (size < 0) return std::nullopt;
+        std::vector<std::uint8_t> buffer(static_cast<std::size_t>(size));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(buffer.data()), size)) return std::nullopt;
+        return buffer;
+    }
+
+    std::optional<std::vector<std::uint8_t>> readFileRange(const std::string& file_path, std::uint64_t offset, std::uint64_t size)
+    {
+        std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return std::nullopt;
+        auto file_size = file.tellg();
+        if (file_size < 0 || offset > static_cast<std::uint64_t>(file_size) || size > static_cast<std::uint64_t>(file_size) - offset) {
+            return std::nullopt;
+        }
+        std::vector<std::uint8_t> buffer(static_cast<std::size_t>(size));
+        file.seekg(static_cast<std::streamoff>(offset));
+        if (!file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size))) return std::nullopt;
+        return buffer;
+    }
+
+    std::optional<std::uint64_t> hashFile(const std::string& file_path)
+    {
+        auto buffer = readFile(file_path);
+        if (!buffer) return std::nullopt;
+        std::uint64_t hash = 14695981039346656037ull;       // FNV-1a 64位偏移基数
+        for (auto byte : *buffer) {
+            hash ^= byte;
+            hash *= 1099511628211ull;                        // FNV-1a 64位质数
+        }
+        return hash;
+    }
+
+    // --- BinaryWriter ---
+
+    void BinaryWriter::writeBytes(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    void BinaryWriter::writeString(std::string_view str)
+    {
+        write(static_cast<std::uint32_t>(str.size()));
+        writeBytes(str.data(), str.size());
+    }
+
+    void BinaryWriter::writeBlob(const std::vector<std::uint8_t>& blob)
+    {
+        write(static_cast<std::uint32_t>(blob.size()));
+        writeBytes(blob.data(), blob.size());
+    }
+
+    bool BinaryWriter::saveToFile(const std::string& file_path) const
+    {
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            spdlog::error("无法写入文件: {}", file_path);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        return static_cast<bool>(file);
+    }
+
+    // --- BinaryReader ---
+
+    const std::uint8_t* BinaryReader::readBytes(std::size_t size)
+    {
+        if (!ok_ || size > size_ - position_) {
+            ok_ = false;
+            return nullptr;
+        }
+        const auto* bytes = data_ + position_;
+        position_ += size;
+        return bytes;
+    }
+
+    std::string BinaryReader::readString()
+    {
+        auto size = read<std::uint32_t>();
+        const auto* bytes = readBytes(size);
+        return bytes ? std::string(reinterpret_cast<const char*>(bytes), size) : std::string();
+    }
+
+    std::pair<const std::uint8_t*, std::size_t> BinaryReader::readBlob()
+    {
+        auto size = read<std::uint32_t>();
+        const auto* bytes = readBytes(size);
+        return { bytes, bytes ? size : 0 };
+    }
+
+    std::uint32_t BinaryReader::readCount(std::size_t min_element_size)
+    {
+        auto count = read<std::uint32_t>();
+        if (!ok_ || (min_element_size > 0 && count > (size_ - position_) / min_element_size)) {
+            ok_ = false;
+            return 0;
+        }
+        return count;
+    }
+
+} // namespace engine::scene::cooked
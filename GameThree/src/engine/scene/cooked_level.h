@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 烘焙关卡 (.g3lvl) 的二进制格式定义与读写工具。
+ *
+ * 文件按顺序存放（小端序，无对齐填充）：
+ * 1. 文件头：魔数 "G3LV"、版本号、块数据区的文件偏移（文件头 + 元数据之后）
+ * 2. 源文件列表：路径（相对于地图文件，下同）、firstgid（地图为0）、内容哈希（任一源文件内容改变则烘焙文件过期）
+ * 3. 地图信息：地图尺寸、瓦片尺寸
+ * 4. 纹理清单：关卡用到的所有纹理路径（其他数据通过下标引用）
+ * 5. 瓦片调色板：去重后的瓦片信息（纹理下标、源矩形、类型、高度表），下标0为空瓦片
+ * 6. 预制体蓝图：对象图层引用的 gid 及其瓦片数据（调色板下标、瓦片json的CBOR）
+ * 7. 图层：图片图层参数 / 瓦片图层的块目录（块坐标 + 块数据在块数据区中的偏移，见 TileChunkMap） / 对象图层json的CBOR
+ * 8. 块数据区：各瓦片块的调色板下标数组
+ *
+ * 1-7 为元数据，加载时一次读入；块数据区可以整体读入，也可以由 LevelStreamer 按块随机读取（流式加载）。
+ */
+namespace engine::scene::cooked {
+
+    inline constexpr char MAGIC[4] = { 'G', '3', 'L', 'V' };    ///< @brief 文件魔数
+    inline constexpr std::uint32_t VERSION = 4;                 ///< @brief 格式版本（格式改变时递增，旧文件视为过期）
+    inline constexpr std::size_t HEADER_SIZE = sizeof(MAGIC) + sizeof(std::uint32_t) + sizeof(std::uint64_t);    ///< @brief 文件头大小
+    inline constexpr std::uint32_t NO_INDEX = 0xFFFFFFFFu;      ///< @brief 无效下标（如没有纹理的瓦片）
+
+    /// @brief 图层类型
+    enum class LayerKind : std::uint8_t {
+        IMAGE = 0,
+        TILE = 1,
+        OBJECT = 2,
+    };
+
+    /// @brief 由地图路径得到烘焙文件路径（替换扩展名，如 "assets/maps/level1.tmj" -> "assets/maps/level1.g3lvl"）
+    std::string getCookedPath(const std::string& map_path);
+
+    /// @brief 读取整个文件，失败返回 std::nullopt
+    std::optional<std::vector<std::uint8_t>> readFile(const std::string& file_path);
+
+    /**
+     * @brief 读取文件的一段。
+     * @param file_path 文件路径
+     * @param offset 起始偏移
+     * @param size 读取长度（超出文件末尾时失败）
+     * @return 读取的数据，失败返回 std::nullopt
+     */
+    std::optional<std::vector<std::uint8_t>> readFileRange(const std::string& file_path, std::uint64_t offset, std::uint64_t size);
+
+    /// @brief 计算文件内容的 FNV-1a 64位哈希，文件无法读取时返回 std::nullopt
+    std::optional<std::uint64_t> hashFile(const std::string& file_path);
+
+    /**
+     * @brief 二进制写入器：把数据依次追加到内存缓冲区，最后一次性写入文件。
+     */
+    class BinaryWriter final {
+        std::vector<std::uint8_t> buffer_;     ///< @brief 数据缓冲区
+
+    public:
+        /// @brief 写入一个平凡可复制的值
+        template <typename T>
+        void write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter::write 只支持平凡可复制类型");
+            writeBytes(&value, sizeof(T));
+        }
+
+        void writeBytes(const void* data, std::size_t size);   ///< @brief 写入原始字节
+        void writeString(std::string_view str);                ///< @brief 写入字符串（u32长度 + 字符）
+        void writeBlob(const std::vector<std::uint8_t>& blob); ///< @brief 写入数据块（u32长度 + 字节）
+
+        const std::vector<std::uint8_t>& getBuffer() const { return buffer_; }    ///< @brief 获取缓冲区
+        [[nodiscard]] bool saveToFile(const std::string& file_path) const;         ///< @brief 将缓冲区写入文件
+    };
+
+    /**
+     * @brief 二进制读取器：直接从内存缓冲区按顺序读取，不复制整块数据。
+     * @details 越界读取不会抛出异常，而是置为失败状态并返回默认值；调用者在读完一段数据后检查 ok()。
+     *          （由 readFile 一次读入内存，不使用平台相关的内存映射）
+     */
+    class BinaryReader final {
+        const std::uint8_t* data_ = nullptr;   ///< @brief 数据起始地址
+        std::size_t size_ = 0;                 ///< @brief 数据长度
+        std::size_t position_ = 0;             ///< @brief 当前读取位置
+        bool ok_ = true;                       ///< @brief 是否未发生越界
+
+    public:
+        BinaryReader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+        /// @brief 读取一个平凡可复制的值（越界时返回默认值）
+        template <typename T>
+        T read() {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryReader::read 只支持平凡可复制类型");
+            T value{};
+            if (const auto* bytes = readBytes(sizeof(T)); bytes) {
+                std::memcpy(&value, bytes, sizeof(T));
+            }
+            return value;
+        }
+
+        /// @brief 读取 size 个字节，返回指向缓冲区内部的指针（越界时返回空指针）
+        const std::uint8_t* readBytes(std::size_t size);
+        std::string readString();                               ///< @brief 读取字符串（u32长度 + 字符）
+        std::pair<const std::uint8_t*, std::size_t> readBlob(); ///< @brief 读取数据块（u32长度 + 字节），返回缓冲区内部的指针和长度
+
+        /**
+         * @brief 读取元素数量（u32），并检查剩余数据至少能容纳这么多元素，防止损坏的文件导致超大分配。
+         * @param min_element_size 每个元素至少占用的字节数
+         * @return 元素数量（检查失败时返回0并置为失败状态）
+         */
+        std::uint32_t readCount(std::size_t min_element_size);
+
+        void setFailed() { ok_ = false; }                       ///< @brief 置为失败状态（数据内容无效时由调用者设置）
+        bool ok() const { return ok_; }                         ///< @brief 是否未发生越界且数据有效
+    };
+
+} // namespace engine::scene::cooked
@@ -0,0 +1,127 @@
+#include "level_load_task.h"
+#include "level_loader.h"
+#include "../resource/resource_manager.h"
+#include <SDL3/SDL_timer.h>
+#include <SDL3_image/SDL_image.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+    namespace {
+        constexpr float PREPARE_WEIGHT = 0.3f;      ///< 工作线程进度中解析关卡所占的比例（其余为解码资源）
+        constexpr float LOAD_WEIGHT = 0.8f;         ///< 总进度中工作线程所占的比例（其余为主线程上传）
+    }
+
+    void LevelLoadTask::SurfaceDeleter::operator()(SDL_Surface* surface) const {
+        if (surface) {
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    void LevelLoadTask::ChunkDeleter::operator()(Mix_Chunk* chunk) const {
+        if (chunk) {
+            Mix_FreeChunk(chunk);
+        }
+    }
+
+    LevelLoadTask::LevelLoadTask(std::string map_path, const LevelStreamingSettings& streaming_settings)
+        : level_loader_(std::make_shared<LevelLoader>()), map_path_(std::move(map_path)) {
+        level_loader_->setStreamingSettings(streaming_settings);
+        worker_ = std::thread(&LevelLoadTask::run, this);
+        spdlog::trace("关卡 '{}' 开始后台加载。", map_path_);
+    }
+
+    LevelLoadTask::~LevelLoadTask() {
+        cancelled_.store(true, std::memory_order_relaxed);
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    float LevelLoadTask::getProgress() const {
+        if (!isLoaded()) {
+            return load_progress_.load(std::memory_order_relaxed) * LOAD_WEIGHT;
+        }
+        auto total = surfaces_.size() + sounds_.size();
+        auto upload_progress = total > 0 ? static_cast<float>(uploaded_count_) / static_cast<float>(total) : 1.0f;
+        return LOAD_WEIGHT + upload_progress * (1.0f - LOAD_WEIGHT);
+    }
+
+    bool LevelLoadTask::upload(engine::resource::ResourceManager& resource_manager, std::uint64_t time_budget_ns) {
+        if (!isLoaded()) return false;
+
+        const auto total = surfaces_.size() + sounds_.size();
+        const auto start_ns = SDL_GetTicksNS();
+        while (uploaded_count_ < total) {
+            if (uploaded_count_ < surfaces_.size()) {
+                auto& [texture_id, surface] = surfaces_[uploaded_count_];
+                resource_manager.loadTexture(texture_id, surface.get());
+                surface.reset();        // 纹理已创建，释放内存中的图片
+            }
+            else {
+                auto& [sound_path, chunk] = sounds_[uploaded_count_ - surfaces_.size()];
+                resource_manager.addSound(sound_path, chunk.release());
+            }
+            ++uploaded_count_;
+            if (SDL_GetTicksNS() - start_ns >= time_budget_ns) break;
+        }
+        return uploaded_count_ >= total;
+    }
+
+    std::shared_ptr<LevelLoader> LevelLoadTask::takeLevelLoader() {
+        if (!isLoaded()) {
+            spdlog::error("关卡 '{}' 尚未加载完成，无法取出加载器。", map_path_);
+            return nullptr;
+        }
+        return std::move(level_loader_);
+    }
+
+    void LevelLoadTask::run() {
+        // 1. 解析关卡（烘焙文件或 JSON），生成待构建的图层和资源清单
+        success_ = level_loader_->prepareLevel(map_path_);
+        load_progress_.store(PREPARE_WEIGHT, std::memory_order_relaxed);
+
+        // 2. 解码资源清单中的图片和音效（不创建纹理，纹理必须在主线程创建）
+        if (success_) {
+            const auto& textures = level_loader_->getResourceManifest().getTextures();
+            const auto& sounds = level_loader_->getResourceManifest().getSounds();
+            const auto total = textures.size() + sounds.size();
+            std::size_t done = 0;
+            auto advance = [&]() {
+                ++done;
+                load_progress_.store(PREPARE_WEIGHT + (1.0f - PREPARE_WEIGHT) * static_cast<float>(done) / static_cast<float>(total),
+                    std::memory_order_relaxed);
+            };
+
+            surfaces_.reserve(textures.size());
+            for (const auto& texture_id : textures) {
+                if (cancelled_.load(std::memory_order_relaxed)) break;
+                if (auto* surface = IMG_Load(texture_id.c_str()); surface) {
+                    surfaces_.emplace_back(texture_id, std::unique_ptr<SDL_Surface, SurfaceDeleter>(surface));
+                }
+                else {      // 构建关卡时会再次尝试从文件加载并报告错误
+                    spdlog::warn("后台解码图片失败: '{}': {}", texture_id, SDL_GetError());
+                }
+                advance();
+            }
+            sounds_.reserve(sounds.size());
+            for (const auto& sound_path : sounds) {
+                if (cancelled_.load(std::memory_order_relaxed)) break;
+                if (auto* chunk = Mix_LoadWAV(sound_path.c_str()); chunk) {
+                    sounds_.emplace_back(sound_path, std::unique_ptr<Mix_Chunk, ChunkDeleter>(chunk));
+                }
+                else {
+                    spdlog::warn("后台解码音效失败: '{}': {}", sound_path, SDL_GetError());
+                }
+                advance();
+            }
+        }
+
+        load_progress_.store(1.0f, std::memory_order_relaxed);
+        loaded_.store(true, std::memory_order_release);
+        spdlog::info("关卡 '{}' 后台加载{}: {} 张图片, {} 个音效待上传。", map_path_, success_ ? "完成" : "失败",
+            surfaces_.size(), sounds_.size());
+    }
+
+} // namespace engine::scene
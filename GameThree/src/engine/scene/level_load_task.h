@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "level_streamer.h"
+
+struct SDL_Surface;
+struct Mix_Chunk;
+
+namespace engine::resource {
+    class ResourceManager;
+}
+
+namespace engine::scene {
+    class LevelLoader;
+
+    /**
+     * @brief 后台关卡加载任务：工作线程解析关卡并解码图片和音效，主线程分帧上传纹理。
+     *
+     * 工作线程只执行不依赖渲染器和场景的工作（LevelLoader::prepareLevel、图片解码、音效解码）；
+     * 工作线程结束后，主线程每帧调用 upload() 在时间预算内创建纹理、缓存音效，
+     * 全部完成后取出加载器，交给新场景调用 LevelLoader::buildLevel 创建对象。
+     */
+    class LevelLoadTask final {
+        struct SurfaceDeleter {
+            void operator()(SDL_Surface* surface) const;
+        };
+        struct ChunkDeleter {
+            void operator()(Mix_Chunk* chunk) const;
+        };
+
+        std::shared_ptr<LevelLoader> level_loader_;     ///< @brief 关卡加载器（工作线程结束前只由工作线程访问）
+        std::string map_path_;                          ///< @brief 地图路径
+
+        /// @brief 解码好的图片 (纹理路径, 图片)，工作线程写入，结束后由主线程上传
+        std::vector<std::pair<std::string, std::unique_ptr<SDL_Surface, SurfaceDeleter>>> surfaces_;
+        /// @brief 解码好的音效 (音效路径, 音效)，工作线程写入，结束后由主线程移交给资源管理器
+        std::vector<std::pair<std::string, std::unique_ptr<Mix_Chunk, ChunkDeleter>>> sounds_;
+        std::size_t uploaded_count_ = 0;                ///< @brief 已上传的资源数量（主线程）
+
+        std::atomic<float> load_progress_ = 0.0f;       ///< @brief 工作线程的进度 [0, 1]
+        std::atomic<bool> loaded_ = false;              ///< @brief 工作线程是否已结束（之后主线程才能访问上面的数据）
+        std::atomic<bool> cancelled_ = false;           ///< @brief 是否已取消（任务提前销毁时）
+        bool success_ = false;                          ///< @brief 关卡是否解析成功（工作线程写入，loaded_ 之后读取）
+        std::thread worker_;                            ///< @brief 工作线程（最后声明，确保其他成员先初始化）
+
+    public:
+        /**
+         * @brief 创建任务并立即启动工作线程。
+         * @param map_path 地图文件路径
+         * @param streaming_settings 流式加载设置（解析烘焙关卡时决定是否流式加载）
+         */
+        LevelLoadTask(std::string map_path, const LevelStreamingSettings& streaming_settings);
+        ~LevelLoadTask();   ///< @brief 取消并等待工作线程结束
+
+        // 禁止拷贝和移动
+        LevelLoadTask(const LevelLoadTask&) = delete;
+        LevelLoadTask& operator=(const LevelLoadTask&) = delete;
+        LevelLoadTask(LevelLoadTask&&) = delete;
+        LevelLoadTask& operator=(LevelLoadTask&&) = delete;
+
+        bool isLoaded() const { return loaded_.load(std::memory_order_acquire); }   ///< @brief 工作线程是否已结束
+        bool isSuccessful() const { return isLoaded() && success_; }                ///< @brief 关卡是否解析成功（工作线程结束后有效）
+        float getProgress() const;      ///< @brief 获取总进度 [0, 1]（后台解析解码 + 主线程上传）
+
+        /**
+         * @brief 在时间预算内上传解码好的资源（主线程每帧调用，工作线程结束后才有效）。
+         * @details 每次调用至少上传一项，避免预算过小时无法推进。
+         * @param resource_manager 资源管理器
+         * @param time_budget_ns 本帧的时间预算（纳秒）
+         * @return bool 是否已全部上传
+         */
+        bool upload(engine::resource::ResourceManager& resource_manager, std::uint64_t time_budget_ns);
+
+        /// @brief 取出关卡加载器（全部上传后调用，交给新场景构建关卡）
+        std::shared_ptr<LevelLoader> takeLevelLoader();
+
+    private:
+        void run();     ///< @brief 工作线程入口
+    };
+
+} // namespace engine::scene
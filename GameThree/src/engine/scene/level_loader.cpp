@@ -10,31 +10,821 @@
 #include "../component/audio_component.h"
 #include "../object/game_object.h"
 #include "../scene/scene.h"
+#include "object_spawner.h"
+#include "cooked_level.h"
+#include "tileset_cache.h"
+#include "tile_data.h"
 #include "../core/context.h"
 #include "../resource/resource_manager.h"
 #include "../render/sprite.h"
 #include "../render/animation.h"
+#include "../render/animation_library.h"
 #include "../utils/math.h"
+#include "../utils/thread_pool.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <spdlog/spdlog.h>
 #include <glm/vec2.hpp>
 #include <filesystem>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <unordered_map>
 
 namespace engine::scene {
 
+    namespace {
+        /**
+         * @brief 解析动画json为动画集（之后注册到共享动画库）。
+         * @param anim_json 动画json数据（自定义）
+         * @param sprite_size 每一帧动画的尺寸
+         */
+        engine::render::AnimationSet parseAnimations(const nlohmann::json& anim_json, const glm::vec2& sprite_size)
+        {
+            engine::render::AnimationSet animation_set;
+            // 检查 anim_json 必须是一个对象
+            if (!anim_json.is_object()) {
+                spdlog::error("无效的动画 JSON。");
+                return animation_set;
+            }
+            // 遍历动画 JSON 对象中的每个键值对（动画名称 : 动画信息）
+            for (const auto& anim : anim_json.items()) {
+                const std::string& anim_name = anim.key();
+                const auto& anim_info = anim.value();
+                if (!anim_info.is_object()) {
+                    spdlog::warn("动画 '{}' 的信息无效或为空。", anim_name);
+                    continue;
+                }
+                // 获取可能存在的动画帧信息
+                auto duration_ms = anim_info.value("duration", 100);        // 默认持续时间为100毫秒
+                auto duration = static_cast<float>(duration_ms) / 1000.0f;  // 转换为秒
+                auto row = anim_info.value("row", 0);                       // 默认行数为0
+                // 帧信息（数组）是必须存在的
+                if (!anim_info.contains("frames") || !anim_info["frames"].is_array()) {
+                    spdlog::warn("动画 '{}' 缺少 'frames' 数组。", anim_name);
+                    continue;
+                }
+                // 创建一个Animation对象 (默认为循环播放)
+                auto animation = std::make_unique<engine::render::Animation>(anim_name);
+
+                // 遍历数组并添加帧信息
+                for (const auto& frame : anim_info["frames"]) {
+                    if (!frame.is_number_integer()) {
+                        spdlog::warn("动画 {} 中 frames 数组格式错误！", anim_name);
+                        continue;
+                    }
+                    auto column = frame.get<int>();
+                    // 计算源矩形
+                    SDL_FRect src_rect = {
+                        column * sprite_size.x,
+                        row * sprite_size.y,
+                        sprite_size.x,
+                        sprite_size.y
+                    };
+                    animation->addFrame(src_rect, duration);
+                }
+                animation_set[anim_name] = std::move(animation);
+            }
+            return animation_set;
+        }
+
+        /**
+         * @brief 解析音效json为 (音效id, 音效路径) 列表。
+         * @param sound_json 音效json数据（自定义）
+         */
+        std::vector<std::pair<std::string, std::string>> parseSounds(const nlohmann::json& sound_json)
+        {
+            std::vector<std::pair<std::string, std::string>> sounds;
+            if (!sound_json.is_object()) {
+                spdlog::error("无效的音效 JSON。");
+                return sounds;
+            }
+            // 遍历音效 JSON 对象中的每个键值对（音效id : 音效路径）
+            for (const auto& sound : sound_json.items()) {
+                const std::string& sound_id = sound.key();
+                const std::string& sound_path = sound.value();
+                if (sound_id.empty() || sound_path.empty()) {
+                    spdlog::warn("音效 '{}' 缺少必要信息。", sound_id);
+                    continue;
+                }
+                sounds.emplace_back(sound_id, sound_path);
+            }
+            return sounds;
+        }
+    }
+
+    /// @brief 预制体：同一gid的图片对象共用的组件蓝图（瓦片json只解析一次，实例化时不再访问json）
+    struct LevelLoader::ObjectPrefab {
+        engine::component::TileInfo tile_info;                  ///< @brief 瓦片信息（精灵与类型）
+        glm::vec2 src_size = glm::vec2(0.0f);                   ///< @brief 图片源矩形尺寸
+        std::optional<engine::utils::Rect> collider_rect;       ///< @brief 自定义碰撞盒（非SOLID瓦片）
+        std::optional<std::string> tag;                         ///< @brief 标签
+        std::optional<bool> gravity;                            ///< @brief 是否受重力影响
+        std::optional<int> health;                              ///< @brief 生命值
+        bool always_active = false;                             ///< @brief 是否始终活跃
+        bool has_sound = false;                                 ///< @brief 是否有音效属性
+        const engine::render::AnimationSet* animations = nullptr;   ///< @brief 共享动画集（由动画库持有，首次在主线程创建对象时注册）
+        std::string animation_key;                              ///< @brief 动画集在动画库中的键（空表示没有动画）
+        engine::render::AnimationSet parsed_animations;         ///< @brief 解析阶段解析好、尚未注册到动画库的动画集
+        std::vector<std::pair<std::string, std::string>> sounds;///< @brief 音效 (id, 路径)
+    };
+
+    /// @brief 瓦片表项：加载图块集时预先解析的瓦片数据，按gid直接索引
+    struct LevelLoader::TileEntry {
+        engine::component::TileInfo tile_info;                  ///< @brief 瓦片信息（纹理路径已解析、源矩形、类型、高度表）
+        const nlohmann::json* tile_json = nullptr;              ///< @brief 瓦片json（指向 tileset_data_ 持有的数据，没有条目时为空）
+        int first_gid = 0;                                      ///< @brief 所属图块集的 firstgid（0表示该gid不存在）
+        bool prefab_resolved = false;                           ///< @brief 预制体是否已尝试创建
+        std::unique_ptr<ObjectPrefab> prefab;                   ///< @brief 预制体（解析阶段或首次创建对象时生成，空指针表示该gid无法创建对象）
+    };
+
+    /// @brief 预处理好的图层：解析阶段生成（可在后台线程），构建阶段据此创建游戏对象，不再访问地图文件
+    struct LevelLoader::PreparedLayer {
+        cooked::LayerKind kind = cooked::LayerKind::IMAGE;      ///< @brief 图层类型
+        std::string name;                                       ///< @brief 图层名称
+        std::string texture_id;                                 ///< @brief 图片图层：纹理路径（已解析）
+        glm::vec2 offset = glm::vec2(0.0f);                     ///< @brief 图片图层：偏移
+        glm::vec2 scroll_factor = glm::vec2(1.0f);              ///< @brief 图片图层：视差因子
+        glm::bvec2 repeat = glm::bvec2(false);                  ///< @brief 图片图层：是否重复
+        engine::component::TileChunkMap tiles;                  ///< @brief 瓦片图层：分块存储的瓦片
+        std::uint8_t index_width = 0;                           ///< @brief 瓦片图层（流式加载）：调色板下标宽度（字节）
+        std::vector<std::pair<glm::ivec2, std::uint64_t>> chunk_directory;  ///< @brief 瓦片图层（流式加载）：块目录 (块坐标, 文件偏移)
+        nlohmann::json layer_json;                              ///< @brief 对象图层：图层json
+    };
+
+    LevelLoader::LevelLoader() = default;
+    LevelLoader::~LevelLoader() = default;
+
+    template<typename Func>
+    bool LevelLoader::forEachLayerTile(const nlohmann::json& layer_json, Func&& func)
+    {
+        std::vector<std::uint32_t> gids;
+        // 1. 无限地图：瓦片数据按块存放在 chunks 数组中，每块有自己的位置和尺寸
+        if (layer_json.contains("chunks") && layer_json["chunks"].is_array()) {
+            for (const auto& chunk_json : layer_json["chunks"]) {
+                glm::ivec2 chunk_pos = { chunk_json.value("x", 0), chunk_json.value("y", 0) };
+                auto chunk_width = std::max(chunk_json.value("width", 0), 0);
+                auto chunk_height = std::max(chunk_json.value("height", 0), 0);
+                if (chunk_width == 0) continue;
+                if (!tile_data::decodeChunkData(chunk_json, layer_json, static_cast<std::size_t>(chunk_width) * chunk_height, gids)) {
+                    return false;
+                }
+                for (std::size_t i = 0; i < gids.size(); ++i) {
+                    if (gids[i] == 0) continue;
+                    func(chunk_pos + glm::ivec2(static_cast<int>(i % chunk_width), static_cast<int>(i / chunk_width)), gids[i]);
+                }
+            }
+            return true;
+        }
+
+        // 2. 有限地图：整个图层的数据（行主序，宽度为地图宽度）
+        if (!tile_data::decodeLayerData(layer_json, getTileCount(), gids)) {
+            return false;
+        }
+        const auto width = static_cast<std::size_t>(std::max(map_size_.x, 1));
+        for (std::size_t i = 0; i < gids.size(); ++i) {
+            if (gids[i] == 0) continue;
+            func(glm::ivec2(static_cast<int>(i % width), static_cast<int>(i / width)), gids[i]);
+        }
+        return true;
+    }
+
     bool LevelLoader::loadLevel(const std::string& level_path, Scene& scene) {
-        // 1. 加载 JSON 文件
-        std::ifstream file(level_path);
-        if (!file.is_open()) {
-            spdlog::error("无法打开关卡文件: {}", level_path);
+        return prepareLevel(level_path) && buildLevel(scene);
+    }
+
+    bool LevelLoader::prepareLevel(const std::string& level_path) {
+        prepared_ = false;
+        prepared_layers_.clear();
+        cooked_path_.clear();
+        resource_manifest_.clear();
+
+        // 0. 优先使用烘焙关卡（存在且与源文件一致时）
+        if (prepareCookedLevel(level_path)) {
+            prepared_ = true;
+            return true;
+        }
+
+        // 1. 解析地图 JSON 并加载 tileset
+        nlohmann::json json_data;
+        if (!parseMap(level_path, json_data)) {
             return false;
         }
 
-        // 2. 解析 JSON 数据
+        // 2. 按图层顺序建立预处理图层，同时标记用到的 gid（生成资源清单）。
+        //    图片和对象图层直接处理，瓦片图层只占位，解码交给线程池并行执行
+        std::vector<std::uint8_t> used_gids(tile_table_.size(), 0);
+        std::vector<std::uint8_t> object_gids(tile_table_.size(), 0);
+        std::vector<std::pair<std::size_t, const nlohmann::json*>> tile_jobs;  // (预处理图层下标, 图层json)
+        for (auto& layer_json : json_data["layers"]) {
+            // 获取各图层对象中的类型（type）字段
+            std::string layer_type = layer_json.value("type", "none");
+            if (!layer_json.value("visible", true)) {
+                spdlog::info("图层 '{}' 不可见，跳过加载。", layer_json.value("name", "Unnamed"));
+                continue;
+            }
+
+            // 根据图层类型决定解析方法
+            if (layer_type == "imagelayer") {
+                prepareImageLayer(layer_json);
+            }
+            else if (layer_type == "tilelayer") {
+                tile_jobs.emplace_back(prepared_layers_.size(), &layer_json);
+                prepared_layers_.emplace_back();
+            }
+            else if (layer_type == "objectgroup") {
+                prepareObjectLayer(std::move(layer_json), object_gids);
+            }
+            else {
+                spdlog::warn("不支持的图层类型: {}", layer_type);
+            }
+        }
+
+        // 3. 并行解码瓦片图层（各图层写入自己的预处理图层和 gid 标记），解码失败的图层随后按顺序移除
+        std::vector<std::vector<std::uint8_t>> tile_used_gids(tile_jobs.size());
+        std::vector<std::uint8_t> decoded(tile_jobs.size(), 0);
+        engine::utils::ThreadPool::getInstance().parallelFor(tile_jobs.size(), [&](std::size_t i) {
+            const auto& [layer_index, layer_json] = tile_jobs[i];
+            tile_used_gids[i].assign(tile_table_.size(), 0);
+            decoded[i] = prepareTileLayer(*layer_json, prepared_layers_[layer_index], tile_used_gids[i]);
+        });
+        for (std::size_t i = tile_jobs.size(); i-- > 0;) {
+            if (!decoded[i]) prepared_layers_.erase(prepared_layers_.begin() + static_cast<std::ptrdiff_t>(tile_jobs[i].first));
+        }
+        for (std::size_t gid = 0; gid < used_gids.size(); ++gid) {
+            used_gids[gid] = object_gids[gid];
+            for (const auto& layer_used : tile_used_gids) used_gids[gid] |= layer_used[gid];
+        }
+
+        // 4. 并行解析对象用到的预制体（构建阶段只需实例化组件）
+        std::vector<int> prefab_gids;
+        for (std::size_t gid = 0; gid < object_gids.size(); ++gid) {
+            if (object_gids[gid]) prefab_gids.push_back(static_cast<int>(gid));
+        }
+        prepareObjectPrefabs(prefab_gids);
+
+        // 5. 资源清单：图片图层的纹理，以及用到的瓦片的纹理和音效
+        for (const auto& layer : prepared_layers_) {
+            if (layer.kind == cooked::LayerKind::IMAGE) resource_manifest_.addTexture(layer.texture_id);
+        }
+        for (std::size_t gid = 0; gid < used_gids.size(); ++gid) {
+            if (!used_gids[gid]) continue;
+            resource_manifest_.addTexture(tile_table_[gid].tile_info.sprite.getTextureId());
+            collectSounds(tile_table_[gid].tile_json);
+        }
+
+        prepared_ = true;
+        return true;
+    }
+
+    bool LevelLoader::buildLevel(Scene& scene) {
+        if (!prepared_) {
+            spdlog::error("关卡 '{}' 尚未成功解析，无法构建。", map_path_);
+            return false;
+        }
+        prepared_ = false;
+
+        // 按资源清单预先载入纹理和音效（已由加载场景上传的资源直接命中缓存），避免首次使用时才从磁盘加载
+        auto& resource_manager = scene.getContext().getResourceManager();
+        resource_manager.preload(resource_manifest_);
+
+        // 流式加载的关卡：瓦片块由场景的流式加载器在相机接近时读入
+        std::unique_ptr<LevelStreamer> level_streamer;
+        if (!cooked_path_.empty()) {
+            level_streamer = std::make_unique<LevelStreamer>(cooked_path_, tile_size_, streaming_settings_);
+        }
+
+        // 依次为每个图层创建游戏对象（按创建顺序分配关卡顺序，按需生成的对象据此插入到所在图层的位置）
+        next_level_order_ = 0;
+        for (auto& layer : prepared_layers_) {
+            switch (layer.kind) {
+            case cooked::LayerKind::IMAGE: {
+                // 依次添加Transform，Parallax组件
+                auto game_object = std::make_unique<engine::object::GameObject>(layer.name);
+                game_object->addComponent<engine::component::TransformComponent>(layer.offset);
+                game_object->addComponent<engine::component::ParallaxComponent>(layer.texture_id, layer.scroll_factor, layer.repeat);
+                game_object->setLevelOrder(next_level_order_++);
+                scene.addGameObject(std::move(game_object));
+                spdlog::info("加载图层: '{}' 完成", layer.name);
+                break;
+            }
+            case cooked::LayerKind::TILE: {
+                // 添加Tilelayer组件
+                auto game_object = std::make_unique<engine::object::GameObject>(layer.name);
+                auto* tile_layer = game_object->addComponent<engine::component::TileLayerComponent>(tile_size_, map_size_, std::move(layer.tiles));
+                if (level_streamer && !layer.chunk_directory.empty()) {
+                    level_streamer->addLayer(tile_layer, layer.index_width, layer.chunk_directory);
+                }
+                game_object->setLevelOrder(next_level_order_++);
+                scene.addGameObject(std::move(game_object));
+                spdlog::info("加载瓦片图层: '{}' 完成", layer.name);
+                break;
+            }
+            case cooked::LayerKind::OBJECT:
+                loadObjectLayer(layer.layer_json, scene);
+                break;
+            }
+        }
+        prepared_layers_.clear();
+        if (level_streamer) {
+            scene.setLevelStreamer(std::move(level_streamer));
+        }
+
+        spdlog::info("关卡加载完成: {}", map_path_);
+        return true;
+    }
+
+    bool LevelLoader::cookLevel(const std::string& map_path, const std::string& output_path)
+    {
         nlohmann::json json_data;
+        if (!parseMap(map_path, json_data)) {
+            return false;
+        }
+
+        // 纹理清单和瓦片调色板在写入图层时收集，最后按文件顺序写入
+        std::vector<std::string> textures;
+        std::unordered_map<std::string, std::uint32_t> texture_indices;
+        auto getTextureIndex = [&](const std::string& texture_id) -> std::uint32_t {
+            if (texture_id.empty()) return cooked::NO_INDEX;
+            auto [it, inserted] = texture_indices.try_emplace(texture_id, static_cast<std::uint32_t>(textures.size()));
+            if (inserted) textures.push_back(texture_id);
+            return it->second;
+        };
+        std::vector<int> palette_gids = { 0 };     // 调色板下标 -> gid（下标0为空瓦片）
+        std::unordered_map<int, std::uint32_t> palette_indices;
+        auto getPaletteIndex = [&](int gid) -> std::uint32_t {
+            if (gid == 0) return 0;
+            if (!findTileEntry(gid)) {      // 无效gid按空瓦片处理（与 JSON 加载的结果一致）
+                spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
+                return 0;
+            }
+            auto [it, inserted] = palette_indices.try_emplace(gid, static_cast<std::uint32_t>(palette_gids.size()));
+            if (inserted) palette_gids.push_back(gid);
+            return it->second;
+        };
+
+        // 1. 图层
+        cooked::BinaryWriter layer_writer;
+        cooked::BinaryWriter chunk_writer;      // 块数据区
+        std::uint32_t layer_count = 0;
+        std::set<int> object_gids;
+        for (const auto& layer_json : json_data["layers"]) {
+            std::string layer_type = layer_json.value("type", "none");
+            const std::string layer_name = layer_json.value("name", "Unnamed");
+            if (!layer_json.value("visible", true)) continue;       // 不可见图层不烘焙
+
+            if (layer_type == "imagelayer") {
+                const std::string image_path = layer_json.value("image", "");
+                if (image_path.empty()) {
+                    spdlog::error("图层 '{}' 缺少 'image' 属性。", layer_name);
+                    continue;
+                }
+                layer_writer.write(cooked::LayerKind::IMAGE);
+                layer_writer.writeString(layer_name);
+                layer_writer.write(getTextureIndex(resolvePath(image_path, map_path_)));
+                layer_writer.write(glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f)));
+                layer_writer.write(glm::vec2(layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f)));
+                layer_writer.write(static_cast<std::uint8_t>(layer_json.value("repeatx", false)));
+                layer_writer.write(static_cast<std::uint8_t>(layer_json.value("repeaty", false)));
+            }
+            else if (layer_type == "tilelayer") {
+                // 按块收集调色板下标（块坐标排序，保证输出稳定），只写入有瓦片的块
+                std::map<std::pair<int, int>, std::vector<std::uint32_t>> chunks;
+                std::uint32_t max_index = 0;
+                bool decoded = forEachLayerTile(layer_json, [&](glm::ivec2 pos, std::uint32_t gid) {
+                    auto index = getPaletteIndex(static_cast<int>(gid));
+                    if (index == 0) return;
+                    auto chunk_coord = engine::component::TileChunkMap::toChunkCoord(pos);
+                    auto& chunk = chunks[{ chunk_coord.y, chunk_coord.x }];
+                    if (chunk.empty()) chunk.resize(engine::component::TileChunkMap::CHUNK_AREA, 0);
+                    const int mask = engine::component::TileChunkMap::CHUNK_SIZE - 1;
+                    chunk[(pos.y & mask) * engine::component::TileChunkMap::CHUNK_SIZE + (pos.x & mask)] = index;
+                    max_index = std::max(max_index, index);
+                });
+                if (!decoded) {
+                    continue;
+                }
+                // 调色板下标按该图层最大下标选择 16 位或 32 位存储
+                const std::uint8_t index_width = max_index <= 0xFFFF ? 2 : 4;
+                layer_writer.write(cooked::LayerKind::TILE);
+                layer_writer.writeString(layer_name);
+                layer_writer.write(index_width);
+                layer_writer.write(static_cast<std::uint32_t>(chunks.size()));
+                // 块目录写在图层中，块数据写入文件末尾的块数据区（流式加载时按偏移随机读取）
+                for (const auto& [chunk_key, indices] : chunks) {
+                    layer_writer.write(static_cast<std::int32_t>(chunk_key.second));
+                    layer_writer.write(static_cast<std::int32_t>(chunk_key.first));
+                    layer_writer.write(static_cast<std::uint64_t>(chunk_writer.getBuffer().size()));
+                    for (auto index : indices) {
+                        if (index_width == 2) chunk_writer.write(static_cast<std::uint16_t>(index));
+                        else chunk_writer.write(index);
+                    }
+                }
+            }
+            else if (layer_type == "objectgroup") {
+                if (!layer_json.contains("objects") || !layer_json["objects"].is_array()) {
+                    spdlog::error("对象图层 '{}' 缺少 'objects' 属性。", layer_name);
+                    continue;
+                }
+                for (const auto& object : layer_json["objects"]) {
+                    if (auto gid = object.value("gid", 0); gid != 0) object_gids.insert(gid);
+                }
+                // 对象数据量小且需要保留任意自定义属性，以 CBOR（二进制JSON）保存，加载时走与 JSON 相同的对象创建流程
+                layer_writer.write(cooked::LayerKind::OBJECT);
+                layer_writer.writeString(layer_name);
+                layer_writer.writeBlob(nlohmann::json::to_cbor(layer_json));
+            }
+            else {
+                spdlog::warn("不支持的图层类型: {}", layer_type);
+                continue;
+            }
+            ++layer_count;
+        }
+
+        // 2. 预制体蓝图：对象引用的 gid 及其瓦片json
+        cooked::BinaryWriter blueprint_writer;
+        std::uint32_t blueprint_count = 0;
+        for (auto gid : object_gids) {
+            const auto* entry = findTileEntry(gid);
+            if (!entry) continue;       // 无效gid，加载时创建对象会报告错误
+            blueprint_writer.write(static_cast<std::int32_t>(gid));
+            blueprint_writer.write(static_cast<std::int32_t>(entry->first_gid));
+            blueprint_writer.write(getPaletteIndex(gid));
+            blueprint_writer.writeBlob(entry->tile_json ? nlohmann::json::to_cbor(*entry->tile_json) : std::vector<std::uint8_t>());
+            ++blueprint_count;
+        }
+
+        // 3. 瓦片调色板
+        cooked::BinaryWriter palette_writer;
+        for (auto gid : palette_gids) {
+            const auto& tile_info = getTileInfoByGid(gid);
+            const auto& source_rect = tile_info.sprite.getSourceRect();
+            palette_writer.write(getTextureIndex(tile_info.sprite.getTextureId()));
+            palette_writer.write(static_cast<std::uint8_t>(source_rect.has_value()));
+            palette_writer.write(source_rect.value_or(SDL_FRect{ 0.0f, 0.0f, 0.0f, 0.0f }));
+            palette_writer.write(static_cast<std::uint8_t>(tile_info.type));
+            palette_writer.writeBlob(tile_info.height_profile ? *tile_info.height_profile : std::vector<std::uint8_t>());
+        }
+
+        // 4. 按文件顺序写入元数据：源文件、地图信息、纹理清单、调色板、蓝图、图层
+        cooked::BinaryWriter writer;
+        writer.write(static_cast<std::uint32_t>(1 + tileset_data_.size()));
+        auto writeSource = [&](const std::string& source_path, int first_gid) {
+            auto hash = cooked::hashFile(source_path);
+            if (!hash) {
+                spdlog::error("无法读取源文件 '{}'，烘焙失败。", source_path);
+                return false;
+            }
+            writer.writeString(makeRelativePath(source_path, map_path));   // 路径均相对于地图文件，读取时再解析
+            writer.write(static_cast<std::int32_t>(first_gid));
+            writer.write(*hash);
+            return true;
+        };
+        if (!writeSource(map_path, 0)) return false;
+        for (const auto& [first_gid, tileset] : tileset_data_) {
+            if (!writeSource(tileset->value("file_path", std::string()), first_gid)) return false;
+        }
+
+        writer.write(map_size_);
+        writer.write(tile_size_);
+
+        writer.write(static_cast<std::uint32_t>(textures.size()));
+        for (const auto& texture : textures) {
+            writer.writeString(makeRelativePath(texture, map_path));
+        }
+        writer.write(static_cast<std::uint32_t>(palette_gids.size()));
+        writer.writeBytes(palette_writer.getBuffer().data(), palette_writer.getBuffer().size());
+        writer.write(blueprint_count);
+        writer.writeBytes(blueprint_writer.getBuffer().data(), blueprint_writer.getBuffer().size());
+        writer.write(layer_count);
+        writer.writeBytes(layer_writer.getBuffer().data(), layer_writer.getBuffer().size());
+
+        // 5. 文件头（块数据区紧跟在元数据之后）、元数据、块数据区
+        cooked::BinaryWriter file_writer;
+        file_writer.writeBytes(cooked::MAGIC, sizeof(cooked::MAGIC));
+        file_writer.write(cooked::VERSION);
+        file_writer.write(static_cast<std::uint64_t>(cooked::HEADER_SIZE + writer.getBuffer().size()));
+        file_writer.writeBytes(writer.getBuffer().data(), writer.getBuffer().size());
+        file_writer.writeBytes(chunk_writer.getBuffer().data(), chunk_writer.getBuffer().size());
+
+        const auto cooked_path = output_path.empty() ? cooked::getCookedPath(map_path) : output_path;
+        if (!file_writer.saveToFile(cooked_path)) {
+            spdlog::error("烘焙关卡写入失败: {}", cooked_path);
+            return false;
+        }
+        spdlog::info("关卡烘焙完成: {} -> {} ({} 字节，{} 个图层，{} 种瓦片，{} 个纹理)", map_path, cooked_path,
+            file_writer.getBuffer().size(), layer_count, palette_gids.size(), textures.size());
+        return true;
+    }
+
+    bool LevelLoader::prepareCookedLevel(const std::string& map_path)
+    {
+        const auto cooked_path = cooked::getCookedPath(map_path);
+        std::error_code error_code;
+        if (!std::filesystem::exists(cooked_path, error_code)) {
+            return false;
+        }
+        // 1. 文件头：校验魔数和版本，得到块数据区的偏移，元数据一次读入（块数据区按需读取）
+        auto header = cooked::readFileRange(cooked_path, 0, cooked::HEADER_SIZE);
+        if (!header) {
+            spdlog::warn("无法读取烘焙关卡 '{}'，改为解析 JSON。", cooked_path);
+            return false;
+        }
+        cooked::BinaryReader header_reader(header->data(), header->size());
+        const auto* magic = header_reader.readBytes(sizeof(cooked::MAGIC));
+        if (!magic || std::memcmp(magic, cooked::MAGIC, sizeof(cooked::MAGIC)) != 0 || header_reader.read<std::uint32_t>() != cooked::VERSION) {
+            spdlog::warn("烘焙关卡 '{}' 格式或版本不符，改为解析 JSON。", cooked_path);
+            return false;
+        }
+        const auto chunk_data_offset = header_reader.read<std::uint64_t>();
+        auto buffer = chunk_data_offset >= cooked::HEADER_SIZE
+            ? cooked::readFileRange(cooked_path, cooked::HEADER_SIZE, chunk_data_offset - cooked::HEADER_SIZE) : std::nullopt;
+        if (!buffer) {
+            spdlog::warn("烘焙关卡 '{}' 数据不完整，改为解析 JSON。", cooked_path);
+            return false;
+        }
+        cooked::BinaryReader reader(buffer->data(), buffer->size());
+
+        // 2. 源文件校验：任一源文件内容改变（或不存在）则视为过期
+        std::vector<std::pair<int, std::string>> tilesets;
+        auto source_count = reader.readCount(sizeof(std::uint32_t));
+        for (std::uint32_t i = 0; i < source_count && reader.ok(); ++i) {
+            auto source_path = resolvePath(reader.readString(), map_path);   // 与 JSON 加载得到的路径（纹理ID、动画键）一致
+            auto first_gid = reader.read<std::int32_t>();
+            auto hash = reader.read<std::uint64_t>();
+            if (!reader.ok()) break;
+            if (cooked::hashFile(source_path) != hash) {
+                spdlog::info("烘焙关卡 '{}' 已过期（源文件 '{}' 已修改或不存在），改为解析 JSON。", cooked_path, source_path);
+                return false;
+            }
+            if (first_gid > 0) tilesets.emplace_back(first_gid, std::move(source_path));
+        }
+
+        // 3. 地图信息
+        auto map_size = reader.read<glm::ivec2>();
+        auto tile_size = reader.read<glm::ivec2>();
+
+        // 4. 纹理清单
+        std::vector<std::string> textures(reader.readCount(sizeof(std::uint32_t)));
+        for (auto& texture : textures) {
+            texture = resolvePath(reader.readString(), map_path);
+        }
+
+        // 5. 瓦片调色板
+        std::vector<engine::component::TileInfo> palette;
+        auto palette_count = reader.readCount(sizeof(std::uint32_t));
+        palette.reserve(palette_count);
+        for (std::uint32_t i = 0; i < palette_count && reader.ok(); ++i) {
+            auto texture_index = reader.read<std::uint32_t>();
+            auto has_rect = reader.read<std::uint8_t>() != 0;
+            auto source_rect = reader.read<SDL_FRect>();
+            auto type = static_cast<engine::component::TileType>(reader.read<std::uint8_t>());
+            auto [profile_data, profile_size] = reader.readBlob();
+            const std::string texture_id = texture_index < textures.size() ? textures[texture_index] : std::string();
+            auto sprite = has_rect ? engine::render::Sprite(texture_id, source_rect) : engine::render::Sprite(texture_id);
+            std::shared_ptr<const engine::component::TileHeightProfile> height_profile;
+            if (profile_size > 0) {     // 同一调色板项的所有瓦片共享同一份高度表
+                height_profile = std::make_shared<const engine::component::TileHeightProfile>(profile_data, profile_data + profile_size);
+            }
+            palette.emplace_back(std::move(sprite), type, std::move(height_profile));
+        }
+
+        // 6. 预制体蓝图（CBOR 在此处解码，确保数据损坏时不会修改加载器）
+        struct Blueprint {
+            int gid = 0;                        ///< @brief 全局 ID
+            int first_gid = 0;                  ///< @brief 所属图块集的 firstgid
+            std::uint32_t palette_index = 0;    ///< @brief 瓦片信息的调色板下标
+            nlohmann::json tile_json;           ///< @brief 瓦片json（没有条目时为 null）
+        };
+        std::vector<Blueprint> blueprints(reader.readCount(3 * sizeof(std::int32_t)));
+        // 7. 图层：先全部读取校验，数据完整后再转换为预处理图层
+        struct CookedLayer {
+            cooked::LayerKind kind = cooked::LayerKind::IMAGE;  ///< @brief 图层类型
+            std::string name;                                   ///< @brief 图层名称
+            std::uint32_t texture_index = cooked::NO_INDEX;     ///< @brief 图片图层：纹理下标
+            glm::vec2 offset = glm::vec2(0.0f);                 ///< @brief 图片图层：偏移
+            glm::vec2 scroll_factor = glm::vec2(1.0f);          ///< @brief 图片图层：视差因子
+            glm::bvec2 repeat = glm::bvec2(false);              ///< @brief 图片图层：是否重复
+            std::uint8_t index_width = 0;                       ///< @brief 瓦片图层：调色板下标宽度（字节）
+            /// @brief 瓦片图层：块目录 (块坐标, 块数据在块数据区中的偏移)
+            std::vector<std::pair<glm::ivec2, std::uint64_t>> chunks;
+            nlohmann::json objects;                             ///< @brief 对象图层：图层json
+        };
+        std::vector<CookedLayer> layers;
+        try {
+            for (auto& blueprint : blueprints) {
+                blueprint.gid = reader.read<std::int32_t>();
+                blueprint.first_gid = reader.read<std::int32_t>();
+                blueprint.palette_index = reader.read<std::uint32_t>();
+                auto [data, size] = reader.readBlob();
+                if (size > 0) blueprint.tile_json = nlohmann::json::from_cbor(data, data + size);
+            }
+
+            layers.resize(reader.readCount(sizeof(std::uint8_t) + sizeof(std::uint32_t)));
+            for (auto& layer : layers) {
+                layer.kind = reader.read<cooked::LayerKind>();
+                layer.name = reader.readString();
+                switch (layer.kind) {
+                case cooked::LayerKind::IMAGE:
+                    layer.texture_index = reader.read<std::uint32_t>();
+                    layer.offset = reader.read<glm::vec2>();
+                    layer.scroll_factor = reader.read<glm::vec2>();
+                    layer.repeat.x = reader.read<std::uint8_t>() != 0;
+                    layer.repeat.y = reader.read<std::uint8_t>() != 0;
+                    break;
+                case cooked::LayerKind::TILE: {
+                    layer.index_width = reader.read<std::uint8_t>();
+                    if (layer.index_width != 2 && layer.index_width != 4) {
+                        reader.setFailed();
+                        break;
+                    }
+                    layer.chunks.resize(reader.readCount(2 * sizeof(std::int32_t) + sizeof(std::uint64_t)));
+                    for (auto& [chunk_coord, offset] : layer.chunks) {
+                        chunk_coord.x = reader.read<std::int32_t>();
+                        chunk_coord.y = reader.read<std::int32_t>();
+                        offset = reader.read<std::uint64_t>();
+                    }
+                    break;
+                }
+                case cooked::LayerKind::OBJECT: {
+                    auto [data, size] = reader.readBlob();
+                    if (data) layer.objects = nlohmann::json::from_cbor(data, data + size);
+                    break;
+                }
+                default:
+                    reader.setFailed();     // 未知图层类型
+                    break;
+                }
+                if (!reader.ok()) break;
+            }
+        }
+        catch (const nlohmann::json::exception& e) {
+            spdlog::warn("烘焙关卡 '{}' 中的 CBOR 数据损坏: {}，改为解析 JSON。", cooked_path, e.what());
+            return false;
+        }
+        if (!reader.ok()) {
+            spdlog::warn("烘焙关卡 '{}' 数据不完整，改为解析 JSON。", cooked_path);
+            return false;
+        }
+
+        // 8. 块数据区：瓦片块总数超过常驻预算时流式加载（只保留块目录），否则整体读入
+        std::size_t chunk_total = 0;
+        std::uint64_t chunk_data_size = 0;
+        for (const auto& layer : layers) {
+            if (layer.kind != cooked::LayerKind::TILE) continue;
+            chunk_total += layer.chunks.size();
+            const std::uint64_t chunk_bytes = static_cast<std::uint64_t>(engine::component::TileChunkMap::CHUNK_AREA) * layer.index_width;
+            for (const auto& [chunk_coord, offset] : layer.chunks) {
+                if (offset > std::numeric_limits<std::uint64_t>::max() - chunk_data_offset - chunk_bytes) {
+                    spdlog::warn("烘焙关卡 '{}' 块目录损坏，改为解析 JSON。", cooked_path);
+                    return false;
+                }
+                chunk_data_size = std::max(chunk_data_size, offset + chunk_bytes);
+            }
+        }
+        const bool streaming = streaming_settings_.chunk_budget > 0 && chunk_total > streaming_settings_.chunk_budget;
+        std::vector<std::uint8_t> chunk_data;
+        if (!streaming && chunk_data_size > 0) {
+            auto data = cooked::readFileRange(cooked_path, chunk_data_offset, chunk_data_size);
+            if (!data) {
+                spdlog::warn("烘焙关卡 '{}' 块数据不完整，改为解析 JSON。", cooked_path);
+                return false;
+            }
+            chunk_data = std::move(*data);
+        }
+
+        // --- 数据校验完成，开始构建 ---
+        map_path_ = map_path;
+        map_size_ = map_size;
+        tile_size_ = tile_size;
+
+        // 烘焙关卡中 tileset 只保留文件路径（动画库的键需要）和对象引用的瓦片json
+        std::map<int, nlohmann::json> cooked_tilesets;
+        for (const auto& [first_gid, tileset_path] : tilesets) {
+            cooked_tilesets[first_gid]["file_path"] = tileset_path;
+        }
+        std::vector<std::size_t> tile_json_indices(blueprints.size(), 0);
+        int max_gid = 0;
+        for (std::size_t i = 0; i < blueprints.size(); ++i) {
+            auto& blueprint = blueprints[i];
+            max_gid = std::max(max_gid, blueprint.gid);
+            if (blueprint.tile_json.is_null()) continue;
+            auto& tiles = cooked_tilesets[blueprint.first_gid]["tiles"];
+            tile_json_indices[i] = tiles.size();
+            tiles.push_back(std::move(blueprint.tile_json));
+        }
+        for (auto& [first_gid, tileset] : cooked_tilesets) {
+            tileset_data_[first_gid] = std::make_shared<const nlohmann::json>(std::move(tileset));
+        }
+        // 所有瓦片json添加完毕后再取地址（之后 tileset_data_ 不再修改）
+        if (tile_table_.size() < static_cast<std::size_t>(max_gid) + 1) tile_table_.resize(static_cast<std::size_t>(max_gid) + 1);
+        for (std::size_t i = 0; i < blueprints.size(); ++i) {
+            const auto& blueprint = blueprints[i];
+            if (blueprint.gid <= 0 || blueprint.first_gid <= 0) continue;
+            auto& entry = tile_table_[blueprint.gid];
+            entry.first_gid = blueprint.first_gid;
+            entry.tile_info = blueprint.palette_index < palette.size() ? palette[blueprint.palette_index] : engine::component::TileInfo();
+            entry.tile_json = blueprint.tile_json.is_null() ? nullptr : &(*tileset_data_.at(blueprint.first_gid))["tiles"][tile_json_indices[i]];
+        }
+
+        // 资源清单：纹理直接使用文件中的清单，音效来自对象引用的瓦片
+        for (const auto& texture_id : textures) {
+            resource_manifest_.addTexture(texture_id);
+        }
+        for (const auto& blueprint : blueprints) {
+            if (const auto* entry = findTileEntry(blueprint.gid); entry) collectSounds(entry->tile_json);
+        }
+
+        // 转换为预处理图层（瓦片图层直接从块数据区读取调色板下标；流式加载时块全部标记为未载入）。
+        // 各图层互不依赖，由线程池并行转换，结果按文件中的图层顺序存放
+        prepared_layers_.resize(layers.size());
+        engine::utils::ThreadPool::getInstance().parallelFor(layers.size(), [&](std::size_t layer_index) {
+            auto& layer = layers[layer_index];
+            auto& prepared = prepared_layers_[layer_index];
+            prepared.kind = layer.kind;
+            prepared.name = std::move(layer.name);
+            switch (layer.kind) {
+            case cooked::LayerKind::IMAGE:
+                prepared.texture_id = layer.texture_index < textures.size() ? textures[layer.texture_index] : std::string();
+                prepared.offset = layer.offset;
+                prepared.scroll_factor = layer.scroll_factor;
+                prepared.repeat = layer.repeat;
+                break;
+            case cooked::LayerKind::TILE: {
+                // 图层共用文件中的调色板（调色板下标0为空瓦片，与 TileChunkMap 一致）
+                for (std::size_t i = 1; i < palette.size(); ++i) {
+                    prepared.tiles.addPaletteEntry(palette[i]);
+                }
+                if (streaming) {
+                    if (streaming_settings_.unloaded_solid) {
+                        prepared.tiles.setUnloadedTile(engine::component::TileInfo(engine::render::Sprite(), engine::component::TileType::SOLID));
+                    }
+                    prepared.index_width = layer.index_width;
+                    prepared.chunk_directory.reserve(layer.chunks.size());
+                    for (const auto& [chunk_coord, offset] : layer.chunks) {
+                        prepared.tiles.unloadChunk(chunk_coord);
+                        prepared.chunk_directory.emplace_back(chunk_coord, chunk_data_offset + offset);
+                    }
+                    break;
+                }
+                for (const auto& [chunk_coord, offset] : layer.chunks) {
+                    const auto* indices = chunk_data.data() + offset;
+                    const glm::ivec2 chunk_origin = chunk_coord * engine::component::TileChunkMap::CHUNK_SIZE;
+                    for (int i = 0; i < engine::component::TileChunkMap::CHUNK_AREA; ++i) {
+                        std::uint32_t index = 0;
+                        if (layer.index_width == 2) {
+                            std::uint16_t index16 = 0;
+                            std::memcpy(&index16, indices + i * 2, sizeof(index16));
+                            index = index16;
+                        }
+                        else {
+                            std::memcpy(&index, indices + i * 4, sizeof(index));
+                        }
+                        if (index == 0) continue;
+                        prepared.tiles.setTile(chunk_origin + glm::ivec2(i % engine::component::TileChunkMap::CHUNK_SIZE,
+                            i / engine::component::TileChunkMap::CHUNK_SIZE), index);
+                    }
+                }
+                break;
+            }
+            case cooked::LayerKind::OBJECT:
+                prepared.layer_json = std::move(layer.objects);
+                break;
+            }
+        });
+
+        // 预制体：对象引用的gid都在蓝图中，并行解析
+        std::vector<int> prefab_gids;
+        prefab_gids.reserve(blueprints.size());
+        for (const auto& blueprint : blueprints) {
+            prefab_gids.push_back(blueprint.gid);
+        }
+        prepareObjectPrefabs(prefab_gids);
+
+        cooked_path_ = streaming ? cooked_path : std::string();
+        if (streaming) {
+            spdlog::info("已读取烘焙关卡: {}（{} 个瓦片块超过常驻预算 {}，流式加载）", cooked_path, chunk_total, streaming_settings_.chunk_budget);
+        }
+        else {
+            spdlog::info("已读取烘焙关卡: {}", cooked_path);
+        }
+        return true;
+    }
+
+    bool LevelLoader::parseMap(const std::string& map_path, nlohmann::json& json_data)
+    {
+        // 1. 一次读入整个 JSON 文件
+        auto buffer = cooked::readFile(map_path);
+        if (!buffer) {
+            spdlog::error("无法打开关卡文件: {}", map_path);
+            return false;
+        }
+
+        // 2. 解析 JSON 数据（瓦片图层的 data 数组直接写入 gid 缓冲区，见 tile_data.h）
         try {
-            file >> json_data;
+            json_data = tile_data::parseMap(buffer->data(), buffer->size());
         }
         catch (const nlohmann::json::parse_error& e) {
             spdlog::error("解析 JSON 数据失败: {}", e.what());
@@ -42,7 +832,7 @@ namespace engine::scene {
         }
 
         // 3. 获取基本地图信息 (名称、地图尺寸、瓦片尺寸)
-        map_path_ = level_path;
+        map_path_ = map_path;
         map_size_ = glm::ivec2(json_data.value("width", 0), json_data.value("height", 0));
         tile_size_ = glm::ivec2(json_data.value("tilewidth", 0), json_data.value("tileheight", 0));
 
@@ -60,96 +850,101 @@ namespace engine::scene {
             }
         }
 
-        // 5. 加载图层数据
-        if (!json_data.contains("layers") || !json_data["layers"].is_array()) {       // 地图文件中必须有 layers 数组
-            spdlog::error("地图文件 '{}' 中缺少或无效的 'layers' 数组。", level_path);
+        // 5. 地图文件中必须有 layers 数组
+        if (!json_data.contains("layers") || !json_data["layers"].is_array()) {
+            spdlog::error("地图文件 '{}' 中缺少或无效的 'layers' 数组。", map_path);
             return false;
         }
-        for (const auto& layer_json : json_data["layers"]) {
-            // 获取各图层对象中的类型（type）字段
-            std::string layer_type = layer_json.value("type", "none");
-            if (!layer_json.value("visible", true)) {
-                spdlog::info("图层 '{}' 不可见，跳过加载。", layer_json.value("name", "Unnamed"));
-                continue;
-            }
-
-            // 根据图层类型决定加载方法
-            if (layer_type == "imagelayer") {
-                loadImageLayer(layer_json, scene);
-            }
-            else if (layer_type == "tilelayer") {
-                loadTileLayer(layer_json, scene);
-            }
-            else if (layer_type == "objectgroup") {
-                loadObjectLayer(layer_json, scene);
-            }
-            else {
-                spdlog::warn("不支持的图层类型: {}", layer_type);
-            }
-        }
-
-        spdlog::info("关卡加载完成: {}", level_path);
         return true;
     }
 
-    void LevelLoader::loadImageLayer(const nlohmann::json& layer_json, Scene& scene) {
+    void LevelLoader::prepareImageLayer(const nlohmann::json& layer_json) {
         // 获取纹理相对路径 （会自动处理'\/'符号）
         const std::string& image_path = layer_json.value("image", "");
         if (image_path.empty()) {
             spdlog::error("图层 '{}' 缺少 'image' 属性。", layer_json.value("name", "Unnamed"));
             return;
         }
-        auto texture_id = resolvePath(image_path, map_path_);
+        PreparedLayer layer;
+        layer.kind = cooked::LayerKind::IMAGE;
+        layer.texture_id = resolvePath(image_path, map_path_);
 
         // 获取图层偏移量（json中没有则代表未设置，给默认值即可）
-        const glm::vec2 offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+        layer.offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
 
         // 获取视差因子及重复标志
-        const glm::vec2 scroll_factor = glm::vec2(layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f));
-        const glm::bvec2 repeat = glm::bvec2(layer_json.value("repeatx", false), layer_json.value("repeaty", false));
+        layer.scroll_factor = glm::vec2(layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f));
+        layer.repeat = glm::bvec2(layer_json.value("repeatx", false), layer_json.value("repeaty", false));
 
         // 获取图层名称
-        const std::string& layer_name = layer_json.value("name", "Unnamed");
+        layer.name = layer_json.value("name", "Unnamed");
 
         /*  可用类似方法获取其它各种属性，这里我们暂时用不上 */
 
-        // 创建游戏对象
-        auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
-        // 依次添加Transform，Parallax组件
-        game_object->addComponent<engine::component::TransformComponent>(offset);
-        game_object->addComponent<engine::component::ParallaxComponent>(texture_id, scroll_factor, repeat);
-        // 添加到场景中
-        scene.addGameObject(std::move(game_object));
-        spdlog::info("加载图层: '{}' 完成", layer_name);
+        prepared_layers_.push_back(std::move(layer));
     }
 
-    void LevelLoader::loadTileLayer(const nlohmann::json& layer_json, Scene& scene)
+    bool LevelLoader::prepareTileLayer(const nlohmann::json& layer_json, PreparedLayer& layer, std::vector<std::uint8_t>& used_gids)
     {
-        if (!layer_json.contains("data") || !layer_json["data"].is_array()) {
-            spdlog::error("图层 '{}' 缺少 'data' 属性。", layer_json.value("name", "Unnamed"));
-            return;
-        }
-        // 准备 TileInfo Vector (瓦片数量 = 地图宽度 * 地图高度)
-        std::vector<engine::component::TileInfo> tiles;
-        tiles.reserve(map_size_.x * map_size_.y);
+        layer.kind = cooked::LayerKind::TILE;
+        layer.name = layer_json.value("name", "Unnamed");
 
-        // 获取图层数据 (瓦片 ID 列表)
-        const auto& data = layer_json["data"];
+        // 根据gid从瓦片表获取瓦片信息，每种瓦片只加入调色板一次，瓦片按块存储（空瓦片不占内存）
+        std::vector<std::uint32_t> palette_indices(tile_table_.size(), 0);     // gid -> 调色板下标（0表示尚未加入）
+        bool decoded = forEachLayerTile(layer_json, [&](glm::ivec2 pos, std::uint32_t tile_gid) {
+            auto gid = static_cast<int>(tile_gid);
+            if (!findTileEntry(gid)) {
+                getTileInfoByGid(gid);      // 输出无效gid的错误日志，按空瓦片处理
+                return;
+            }
+            auto& palette_index = palette_indices[gid];
+            if (palette_index == 0) palette_index = layer.tiles.addPaletteEntry(tile_table_[gid].tile_info);
+            layer.tiles.setTile(pos, palette_index);
+            if (static_cast<std::size_t>(gid) < used_gids.size()) used_gids[gid] = 1;
+        });
+        return decoded;
+    }
 
-        // 根据gid获取必要信息，并依次填充 TileInfo Vector
-        for (const auto& gid : data) {
-            tiles.push_back(getTileInfoByGid(gid));
+    void LevelLoader::prepareObjectLayer(nlohmann::json&& layer_json, std::vector<std::uint8_t>& object_gids)
+    {
+        if (layer_json.contains("objects") && layer_json["objects"].is_array()) {
+            for (const auto& object : layer_json["objects"]) {
+                auto gid = object.value("gid", 0);
+                if (gid > 0 && static_cast<std::size_t>(gid) < object_gids.size()) object_gids[gid] = 1;
+            }
         }
+        PreparedLayer layer;
+        layer.kind = cooked::LayerKind::OBJECT;
+        layer.name = layer_json.value("name", "Unnamed");
+        layer.layer_json = std::move(layer_json);      // 对象需要场景才能创建，留到构建阶段
+        prepared_layers_.push_back(std::move(layer));
+    }
 
-        // 获取图层名称
-        const std::string& layer_name = layer_json.value("name", "Unnamed");
-        // 创建游戏对象
-        auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
-        // 添加Tilelayer组件
-        game_object->addComponent<engine::component::TileLayerComponent>(tile_size_, map_size_, std::move(tiles));
-        // 添加到场景中
-        scene.addGameObject(std::move(game_object));
-        spdlog::info("加载瓦片图层: '{}' 完成", layer_name);
+    void LevelLoader::prepareObjectPrefabs(const std::vector<int>& gids)
+    {
+        // 每个任务只写入自己gid的瓦片表项，瓦片表和图块集数据此时只读
+        engine::utils::ThreadPool::getInstance().parallelFor(gids.size(), [&](std::size_t i) {
+            const auto gid = gids[i];
+            if (!findTileEntry(gid)) return;    // 无效gid，创建对象时报告错误
+            auto& entry = tile_table_[gid];
+            entry.prefab = createObjectPrefab(gid, entry);
+            entry.prefab_resolved = true;
+        });
+    }
+
+    void LevelLoader::collectSounds(const nlohmann::json* tile_json)
+    {
+        if (!tile_json) return;
+        auto sound_string = getTileProperty<std::string>(*tile_json, "sound");
+        if (!sound_string) return;
+        try {
+            for (const auto& [sound_id, sound_path] : parseSounds(nlohmann::json::parse(sound_string.value()))) {
+                resource_manifest_.addSound(sound_path);
+            }
+        }
+        catch (const nlohmann::json::parse_error&) {
+            // 错误在创建预制体时报告
+        }
     }
 
     void LevelLoader::loadObjectLayer(const nlohmann::json& layer_json, Scene& scene)
@@ -160,243 +955,292 @@ namespace engine::scene {
         }
         // 获取对象数据
         const auto& objects = layer_json["objects"];
-        // 遍历对象数据
+        // 按需生成时，生成器通过工厂函数持有加载器（因此加载器必须由 shared_ptr 持有）；否则立即创建所有对象
+        std::shared_ptr<LevelLoader> self;
+        if (spawn_on_demand_) {
+            self = weak_from_this().lock();
+            if (!self) spdlog::error("关卡 '{}' 启用了按需生成，但加载器不是由 std::shared_ptr 持有，所有对象将立即创建。", map_path_);
+        }
+        auto& spawner = scene.getObjectSpawner();
+        if (self) {
+            spawner.setFactory([self](std::uint32_t source_index, Scene& target_scene) {
+                return self->createObject(self->spawn_sources_[source_index], target_scene);
+            });
+        }
+
+        // 遍历对象数据（createObject 也在游戏进行中按需生成时调用，逐个对象的日志只用 trace 级别，汇总在这里输出）
+        std::size_t streamed_count = 0;
+        std::size_t created_count = 0;
         for (const auto& object : objects) {
-            // 获取对象gid
+            // 图片对象（敌人、道具、装饰物）登记为生成记录，相机接近时才创建；
+            // 自定义形状（触发器、固体区域）、始终活跃的对象和声明为立即创建的对象（场景按名称查找）立即创建
             auto gid = object.value("gid", 0);
-            if (gid == 0) {     // 如果gid为0 (即不存在)，则代表自己绘制的形状
-                // 非矩形对象会有额外标识（目前不考虑）
-                if (object.value("point", false)) {             // 如果是点对象
-                    continue;       // TODO: 点对象的处理方式
-                }
-                else if (object.value("ellipse", false)) {    // 如果是椭圆对象
-                    continue;       // TODO: 椭圆对象的处理方式
-                }
-                else if (object.value("polygon", false)) {    // 如果是多边形对象
-                    continue;       // TODO: 多边形对象的处理方式
+            auto level_order = next_level_order_++;
+            if (self && gid != 0 && !immediate_object_names_.contains(object.value("name", "")) &&
+                !getObjectProperty<bool>(object, "always_active").value_or(false)) {
+                auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
+                // Tiled 图片对象的坐标是左下角，转换为左上角
+                auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f) - dst_size.y);
+                auto persistent = getObjectProperty<bool>(object, "persistent").value_or(false);
+                spawner.addRecord(engine::utils::Rect{ position, dst_size }, static_cast<std::uint32_t>(spawn_sources_.size()), level_order, persistent);
+                spawn_sources_.push_back(object);
+                ++streamed_count;
+                continue;
+            }
+            if (auto game_object = createObject(object, scene); game_object) {
+                game_object->setLevelOrder(level_order);
+                scene.addGameObject(std::move(game_object));
+                ++created_count;
+            }
+        }
+        spdlog::info("加载对象图层: '{}' 完成（立即创建 {} 个对象，{} 个对象登记为按需生成）",
+            layer_json.value("name", "Unnamed"), created_count, streamed_count);
+    }
+
+    std::unique_ptr<engine::object::GameObject> LevelLoader::createObject(const nlohmann::json& object, Scene& scene)
+    {
+        // 获取对象gid
+        auto gid = object.value("gid", 0);
+        if (gid == 0) {     // 如果gid为0 (即不存在)，则代表自己绘制的形状
+            // 获取Transform相关信息 （自定义形状的坐标针对左上角）
+            auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f));
+            auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
+            auto rotation = object.value("rotation", 0.0f);
+
+            // --- 根据形状创建碰撞器 (非矩形对象会有额外标识) ---
+            std::unique_ptr<engine::physics::Collider> collider;
+            std::string shape_name = "矩形";
+            if (object.value("point", false)) {             // 如果是点对象
+                return nullptr;     // TODO: 点对象的处理方式
+            }
+            else if (object.value("ellipse", false)) {    // 如果是椭圆对象：宽高相等为圆形，否则近似为胶囊
+                if (dst_size.x == dst_size.y) {
+                    collider = std::make_unique<engine::physics::CircleCollider>(dst_size.x / 2.0f);
                 }
-                // 没有这些标识则默认是矩形对象
                 else {
-                    // --- 创建游戏对象并添加TransfromComponent ---
-                    const std::string& object_name = object.value("name", "Unnamed");
-                    auto game_object = std::make_unique<engine::object::GameObject>(object_name);
-                    // 获取Transform相关信息 （自定义形状的坐标针对左上角）
-                    auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f));
-                    auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
-                    auto rotation = object.value("rotation", 0.0f);
-                    // 添加TransformComponent，缩放为设定为1.0f
-                    game_object->addComponent<engine::component::TransformComponent>(position, glm::vec2(1.0f), rotation);
-
-                    // --- 添加碰撞组件和物理组件 ---
-                        // 碰撞盒大小与dst_size相同 
-                    auto collider = std::make_unique<engine::physics::AABBCollider>(dst_size);
-                    auto* cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
-                    // 自定义形状通常是trigger类型，除非显示指定 （因此默认为真）
-                    cc->setTrigger(object.value("trigger", true));
-                    // 添加物理组件，不受重力影响
-                    game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
-
-                    // 获取标签信息并设置
-                    if (auto tag = getTileProperty<std::string>(object, "tag"); tag) {  // 如果有标签
-                        game_object->setTag(tag.value());
-                    }
-                    // 添加到场景
-                    scene.addGameObject(std::move(game_object));
-                    spdlog::info("加载对象: '{}' 完成 (类型: 自定义形状)", object_name);
+                    collider = std::make_unique<engine::physics::CapsuleCollider>(dst_size);
                 }
+                shape_name = "椭圆";
             }
-            else {        // 如果gid存在，则按照图片解析流程
-                // --- 根据gid获取必要信息，每个gid对应一个游戏对象 ---
-                auto tile_info = getTileInfoByGid(gid);
-                if (tile_info.sprite.getTextureId().empty()) {
-                    spdlog::error("gid为 {} 的瓦片没有图像纹理。", gid);
-                    continue;
+            else if (object.contains("polygon") && object["polygon"].is_array()) {    // 如果是多边形对象
+                // 多边形顶点相对于对象坐标，可能为负。调整为相对于包围盒左上角，同时移动对象位置
+                std::vector<glm::vec2> points;
+                points.reserve(object["polygon"].size());
+                auto min_point = glm::vec2(std::numeric_limits<float>::max());
+                for (const auto& point : object["polygon"]) {
+                    points.emplace_back(point.value("x", 0.0f), point.value("y", 0.0f));
+                    min_point = glm::min(min_point, points.back());
                 }
-                // 获取Transform相关信息
-                auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f));
-                auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
-                position = glm::vec2(position.x, position.y - dst_size.y);  // 实际position需要进行调整(左下角到左上角)
-
-                auto rotation = object.value("rotation", 0.0f);
-                auto src_size_opt = tile_info.sprite.getSourceRect();
-                if (!src_size_opt) {        // 正常情况下，所有瓦片的Sprite都设置了源矩形，没有代表某处出错
-                    spdlog::error("gid为 {} 的瓦片没有源矩形。", gid);
-                    continue;
+                if (points.size() < 3) {
+                    spdlog::error("多边形对象 '{}' 的顶点数量不足。", object.value("name", "Unnamed"));
+                    return nullptr;
                 }
-                auto src_size = glm::vec2(src_size_opt->w, src_size_opt->h);    // 成员变量除了 value().w 外，也可以这样获取
-                auto scale = dst_size / src_size;
-
-                // 获取对象名称
-                const std::string& object_name = object.value("name", "Unnamed");
-
-                // 创建游戏对象并添加组件
-                auto game_object = std::make_unique<engine::object::GameObject>(object_name);
-                game_object->addComponent<engine::component::TransformComponent>(position, scale, rotation);
-                game_object->addComponent<engine::component::SpriteComponent>(std::move(tile_info.sprite), scene.getContext().getResourceManager());
-
-                // 获取瓦片json信息      1. 必然存在，因为getTileInfoByGid(gid)函数已经顺利执行
-                                    // 2. 这里再获取json，实际上检索了两次，未来可以优化
-                auto tile_json = getTileJsonByGid(gid);
-
-                // 获取碰信息：如果是SOLID类型，则添加物理组件，且图片源矩形区域就是碰撞盒大小
-                if (tile_info.type == engine::component::TileType::SOLID) {
-                    auto collider = std::make_unique<engine::physics::AABBCollider>(src_size);
-                    game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
-                    // 物理组件不受重力影响
-                    game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
-                    // 设置标签方便物理引擎检索
-                    game_object->setTag("solid");
-                }
-                // 如果非SOLID类型，检查自定义碰撞盒是否存在
-                else if (auto rect = getColliderRect(tile_json); rect) {
-                    // 如果有，添加碰撞组件
-                    auto collider = std::make_unique<engine::physics::AABBCollider>(rect->size);
-                    auto* cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
-                    cc->setOffset(rect->position);  // 自定义碰撞盒的坐标是相对于图片坐标，也就是针对Transform的偏移量
-                    // 和物理组件（默认不受重力影响）
-                    game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), false);
-                }
-
-                // 获取标签信息并设置
-                auto tag = getTileProperty<std::string>(tile_json, "tag");
-                if (tag) {
-                    game_object->setTag(tag.value());
-                }
-                // 如果是危险瓦片，且没有手动设置标签，则自动设置标签为 "hazard"
-                else if (tile_info.type == engine::component::TileType::HAZARD) {
-                    game_object->setTag("hazard");
-                }
-
-                // 获取重力信息并设置
-                auto gravity = getTileProperty<bool>(tile_json, "gravity");
-                if (gravity) {
-                    auto pc = game_object->getComponent<engine::component::PhysicsComponent>();
-                    if (pc) {
-                        pc->setUseGravity(gravity.value());
-                    }
-                    else {
-                        spdlog::warn("对象 '{}' 在设置重力信息时没有物理组件，请检查地图设置。", object_name);
-                        game_object->addComponent<engine::component::PhysicsComponent>(&scene.getContext().getPhysicsEngine(), gravity.value());
-                    }
+                for (auto& point : points) {
+                    point -= min_point;
                 }
+                position += min_point;
+                collider = std::make_unique<engine::physics::PolygonCollider>(points);
+                shape_name = "多边形";
+            }
+            // 没有这些标识则默认是矩形对象，碰撞盒大小与dst_size相同 
+            else {
+                collider = std::make_unique<engine::physics::AABBCollider>(dst_size);
+            }
 
-                // 获取动画信息并设置
-                auto anim_string = getTileProperty<std::string>(tile_json, "animation");
-                if (anim_string) {
-                    // 解析string为JSON对象
-                    nlohmann::json anim_json;
-                    try {
-                        anim_json = nlohmann::json::parse(anim_string.value());
-                    }
-                    catch (const nlohmann::json::parse_error& e) {
-                        spdlog::error("解析动画 JSON 字符串失败: {}", e.what());
-                        continue;  // 跳过此对象
-                    }
-                    // 添加AnimationComponent
-                    auto* ac = game_object->addComponent<engine::component::AnimationComponent>();
-                    // 添加动画到 AnimationComponent
-                    addAnimation(anim_json, ac, src_size);
-                }
-
-                // 获取音效信息并设置
-                auto sound_string = getTileProperty<std::string>(tile_json, "sound");
-                if (sound_string) {
-                    // 解析string为JSON对象
-                    nlohmann::json sound_json;
-                    try {
-                        sound_json = nlohmann::json::parse(sound_string.value());
-                    }
-                    catch (const nlohmann::json::parse_error& e) {
-                        spdlog::error("解析音效 JSON 字符串失败: {}", e.what());
-                        continue;  // 跳过此对象
-                    }
-                    // 添加AudioComponent
-                    auto* audio_component = game_object->addComponent<engine::component::AudioComponent>(&scene.getContext().getAudioPlayer(),
-                        &scene.getContext().getCamera());
-                    // 添加音效到 AudioComponent
-                    addSound(sound_json, audio_component);
+            // --- 创建游戏对象并添加TransfromComponent ---
+            const std::string& object_name = object.value("name", "Unnamed");
+            auto game_object = std::make_unique<engine::object::GameObject>(object_name);
+            // 添加TransformComponent，缩放为设定为1.0f
+            game_object->addComponent<engine::component::TransformComponent>(position, glm::vec2(1.0f), rotation);
+
+            // --- 添加碰撞组件和物理组件 ---
+            auto* cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+            // 自定义形状通常是trigger类型，除非显示指定 （因此默认为真）
+            cc->setTrigger(object.value("trigger", true));
+            // 添加物理组件，不受重力影响
+            game_object->addComponent<engine::component::PhysicsComponent>(false);
+
+            // 获取标签信息并设置
+            if (auto tag = getTileProperty<std::string>(object, "tag"); tag) {  // 如果有标签
+                game_object->setTag(tag.value());
+            }
+            // 始终活跃的对象不会因远离相机而休眠（如关底触发器）
+            if (getTileProperty<bool>(object, "always_active").value_or(false)) {
+                game_object->setAlwaysActive(true);
+            }
+            spdlog::trace("加载对象: '{}' 完成 (类型: 自定义形状-{})", object_name, shape_name);
+            return game_object;
+        }
+        else {        // 如果gid存在，则按照图片解析流程
+            // --- 根据gid获取预制体（同一gid的瓦片json只解析一次），每个对象从预制体克隆组件 ---
+            const auto* prefab = getObjectPrefab(gid, scene);
+            if (!prefab) return nullptr;    // 错误已在创建预制体时记录
+
+            // 获取Transform相关信息
+            auto position = glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f));
+            auto dst_size = glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f));
+            position = glm::vec2(position.x, position.y - dst_size.y);  // 实际position需要进行调整(左下角到左上角)
+
+            auto rotation = object.value("rotation", 0.0f);
+            const auto& src_size = prefab->src_size;
+            auto scale = dst_size / src_size;
+
+            // 获取对象名称
+            const std::string& object_name = object.value("name", "Unnamed");
+
+            // 创建游戏对象并添加组件
+            auto game_object = std::make_unique<engine::object::GameObject>(object_name);
+            game_object->addComponent<engine::component::TransformComponent>(position, scale, rotation);
+            game_object->addComponent<engine::component::SpriteComponent>(engine::render::Sprite(prefab->tile_info.sprite), scene.getContext().getResourceManager());
+
+            // 获取碰信息：如果是SOLID类型，则添加物理组件，且图片源矩形区域就是碰撞盒大小
+            if (prefab->tile_info.type == engine::component::TileType::SOLID) {
+                auto collider = std::make_unique<engine::physics::AABBCollider>(src_size);
+                game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+                // 物理组件不受重力影响
+                game_object->addComponent<engine::component::PhysicsComponent>(false);
+                // 设置标签方便物理引擎检索
+                game_object->setTag("solid");
+            }
+            // 如果非SOLID类型，检查自定义碰撞盒是否存在
+            else if (prefab->collider_rect) {
+                // 如果有，添加碰撞组件
+                auto collider = std::make_unique<engine::physics::AABBCollider>(prefab->collider_rect->size);
+                auto* cc = game_object->addComponent<engine::component::ColliderComponent>(std::move(collider));
+                cc->setOffset(prefab->collider_rect->position);  // 自定义碰撞盒的坐标是相对于图片坐标，也就是针对Transform的偏移量
+                // 和物理组件（默认不受重力影响）
+                game_object->addComponent<engine::component::PhysicsComponent>(false);
+            }
+
+            // 设置标签
+            if (prefab->tag) {
+                game_object->setTag(*prefab->tag);
+            }
+            // 如果是危险瓦片，且没有手动设置标签，则自动设置标签为 "hazard"
+            else if (prefab->tile_info.type == engine::component::TileType::HAZARD) {
+                game_object->setTag("hazard");
+            }
+
+            // 始终活跃标识：对象自身属性优先，其次是瓦片属性
+            if (getTileProperty<bool>(object, "always_active").value_or(prefab->always_active)) {
+                game_object->setAlwaysActive(true);
+            }
+
+            // 设置重力
+            if (prefab->gravity) {
+                auto pc = game_object->getComponent<engine::component::PhysicsComponent>();
+                if (pc) {
+                    pc->setUseGravity(*prefab->gravity);
                 }
+                else {
+                    spdlog::warn("对象 '{}' 在设置重力信息时没有物理组件，请检查地图设置。", object_name);
+                    game_object->addComponent<engine::component::PhysicsComponent>(*prefab->gravity);
+                }
+            }
 
-                // 获取生命值信息并设置
-                auto health = getTileProperty<int>(tile_json, "health");
-                if (health) {
-                    // 添加 HealthComponent
-                    game_object->addComponent<engine::component::HealthComponent>(health.value());
+            // 添加动画组件（引用共享动画集，不复制动画帧）
+            if (prefab->animations) {
+                game_object->addComponent<engine::component::AnimationComponent>(prefab->animations);
+            }
+
+            // 添加音效
+            if (prefab->has_sound) {
+                auto* audio_component = game_object->addComponent<engine::component::AudioComponent>(&scene.getContext().getAudioPlayer(),
+                    &scene.getContext().getCamera());
+                for (const auto& [sound_id, sound_path] : prefab->sounds) {
+                    audio_component->addSound(sound_id, sound_path);
                 }
+            }
 
-                // 添加到场景中
-                scene.addGameObject(std::move(game_object));
-                spdlog::info("加载对象: '{}' 完成", object_name);
+            // 添加生命值组件
+            if (prefab->health) {
+                game_object->addComponent<engine::component::HealthComponent>(*prefab->health);
             }
+
+            spdlog::trace("加载对象: '{}' 完成", object_name);
+            return game_object;
         }
+        return nullptr;
     }
 
-    void LevelLoader::addAnimation(const nlohmann::json& anim_json, engine::component::AnimationComponent* ac, const glm::vec2& sprite_size)
+    const LevelLoader::ObjectPrefab* LevelLoader::getObjectPrefab(int gid, Scene& scene)
     {
-        // 检查 anim_json 必须是一个对象，并且 ac 不能为 nullptr
-        if (!anim_json.is_object() || !ac) {
-            spdlog::error("无效的动画 JSON 或 AnimationComponent 指针。");
-            return;
+        if (!findTileEntry(gid)) {
+            spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
+            return nullptr;
         }
-        // 遍历动画 JSON 对象中的每个键值对（动画名称 : 动画信息）
-        for (const auto& anim : anim_json.items()) {
-            const std::string& anim_name = anim.key();
-            const auto& anim_info = anim.value();
-            if (!anim_info.is_object()) {
-                spdlog::warn("动画 '{}' 的信息无效或为空。", anim_name);
-                continue;
-            }
-            // 获取可能存在的动画帧信息
-            auto duration_ms = anim_info.value("duration", 100);        // 默认持续时间为100毫秒
-            auto duration = static_cast<float>(duration_ms) / 1000.0f;  // 转换为秒
-            auto row = anim_info.value("row", 0);                       // 默认行数为0
-            // 帧信息（数组）是必须存在的
-            if (!anim_info.contains("frames") || !anim_info["frames"].is_array()) {
-                spdlog::warn("动画 '{}' 缺少 'frames' 数组。", anim_name);
-                continue;
-            }
-            // 创建一个Animation对象 (默认为循环播放)
-            auto animation = std::make_unique<engine::render::Animation>(anim_name);
-
-            // 遍历数组并进行添加帧信息到animation对象
-            for (const auto& frame : anim_info["frames"]) {
-                if (!frame.is_number_integer()) {
-                    spdlog::warn("动画 {} 中 frames 数组格式错误！", anim_name);
-                    continue;;
-                }
-                auto column = frame.get<int>();
-                // 计算源矩形
-                SDL_FRect src_rect = {
-                    column * sprite_size.x,
-                    row * sprite_size.y,
-                    sprite_size.x,
-                    sprite_size.y
-                };
-                // 添加动画帧到 Animation
-                animation->addFrame(src_rect, duration);
+        auto& entry = tile_table_[gid];
+        if (!entry.prefab_resolved) {   // 失败时也记录为已尝试，同一gid的错误只报告一次
+            entry.prefab = createObjectPrefab(gid, entry);
+            entry.prefab_resolved = true;
+        }
+        // 动画集只在主线程注册到共享动画库；不同关卡引用同一图块集时直接复用已注册的动画集
+        auto* prefab = entry.prefab.get();
+        if (prefab && !prefab->animations && !prefab->animation_key.empty()) {
+            auto& animation_library = scene.getContext().getResourceManager().getAnimationLibrary();
+            prefab->animations = animation_library.getSet(prefab->animation_key);
+            if (!prefab->animations) {
+                prefab->animations = animation_library.addSet(prefab->animation_key, std::move(prefab->parsed_animations));
             }
-            // 将 Animation 对象添加到 AnimationComponent 中
-            ac->addAnimation(std::move(animation));
+            prefab->parsed_animations.clear();
         }
+        return prefab;
     }
 
-    void LevelLoader::addSound(const nlohmann::json& sound_json, engine::component::AudioComponent* audio_component)
+    std::unique_ptr<LevelLoader::ObjectPrefab> LevelLoader::createObjectPrefab(int gid, const TileEntry& entry)
     {
-        if (!sound_json.is_object() || !audio_component) {
-            spdlog::error("无效的音效 JSON 或 AudioComponent 指针。");
-            return;
+        auto prefab = std::make_unique<ObjectPrefab>();
+        prefab->tile_info = entry.tile_info;
+        if (prefab->tile_info.sprite.getTextureId().empty()) {
+            spdlog::error("gid为 {} 的瓦片没有图像纹理。", gid);
+            return nullptr;
         }
-        // 遍历音效 JSON 对象中的每个键值对（音效id : 音效路径）
-        for (const auto& sound : sound_json.items()) {
-            const std::string& sound_id = sound.key();
-            const std::string& sound_path = sound.value();
-            if (sound_id.empty() || sound_path.empty()) {
-                spdlog::warn("音效 '{}' 缺少必要信息。", sound_id);
-                continue;
+        auto src_size_opt = prefab->tile_info.sprite.getSourceRect();
+        if (!src_size_opt) {        // 正常情况下，所有瓦片的Sprite都设置了源矩形，没有代表某处出错
+            spdlog::error("gid为 {} 的瓦片没有源矩形。", gid);
+            return nullptr;
+        }
+        prefab->src_size = glm::vec2(src_size_opt->w, src_size_opt->h);
+
+        // 获取瓦片json信息（图块集中没有该瓦片的条目时，只有精灵信息）
+        const auto* tile_json = entry.tile_json;
+        if (!tile_json) return prefab;
+
+        prefab->collider_rect = getColliderRect(*tile_json);
+        prefab->tag = getTileProperty<std::string>(*tile_json, "tag");
+        prefab->gravity = getTileProperty<bool>(*tile_json, "gravity");
+        prefab->health = getTileProperty<int>(*tile_json, "health");
+        prefab->always_active = getTileProperty<bool>(*tile_json, "always_active").value_or(false);
+
+        // 解析动画属性（string -> JSON -> 动画集），键为 "图块集路径#局部id@帧宽x帧高"，首次创建对象时注册到共享动画库。
+        // 帧矩形按源矩形尺寸生成（单一图片图块集取决于地图瓦片尺寸），因此尺寸必须是键的一部分，
+        // 否则瓦片尺寸不同的两张地图会共用先加载的那张地图的帧
+        if (auto anim_string = getTileProperty<std::string>(*tile_json, "animation"); anim_string) {
+            const auto& tileset = *tileset_data_.at(entry.first_gid);
+            prefab->animation_key = tileset.value("file_path", std::string()) + "#" + std::to_string(gid - entry.first_gid) +
+                "@" + std::to_string(std::lround(prefab->src_size.x)) + "x" + std::to_string(std::lround(prefab->src_size.y));
+            try {
+                prefab->parsed_animations = parseAnimations(nlohmann::json::parse(anim_string.value()), prefab->src_size);
+            }
+            catch (const nlohmann::json::parse_error& e) {
+                spdlog::error("解析动画 JSON 字符串失败: {}", e.what());
+                return nullptr;     // 跳过使用此瓦片的对象
             }
-            // 添加音效到 AudioComponent
-            audio_component->addSound(sound_id, sound_path);
         }
+
+        // 解析音效属性
+        if (auto sound_string = getTileProperty<std::string>(*tile_json, "sound"); sound_string) {
+            try {
+                prefab->sounds = parseSounds(nlohmann::json::parse(sound_string.value()));
+                prefab->has_sound = true;
+            }
+            catch (const nlohmann::json::parse_error& e) {
+                spdlog::error("解析音效 JSON 字符串失败: {}", e.what());
+                return nullptr;     // 跳过使用此瓦片的对象
+            }
+        }
+        spdlog::trace("gid为 {} 的预制体创建完成。", gid);
+        return prefab;
     }
 
     std::optional<engine::utils::Rect> LevelLoader::getColliderRect(const nlohmann::json& tile_json)
@@ -467,142 +1311,230 @@ namespace engine::scene {
         return engine::component::TileType::NORMAL;
     }
 
-    engine::component::TileType LevelLoader::getTileTypeById(const nlohmann::json& tileset_json, int local_id)
+    std::shared_ptr<const std::vector<std::uint8_t>> LevelLoader::createHeightProfile(glm::vec2 source_size,
+        const nlohmann::json* tile_json, engine::component::TileType type)
     {
-        if (tileset_json.contains("tiles")) {
-            auto& tiles = tileset_json["tiles"];
-            for (auto& tile : tiles) {
-                if (tile.contains("id") && tile["id"] == local_id) {
-                    return getTileType(tile);
+        // 带有其他特性（SOLID、梯子等）的瓦片不需要高度表
+        if (engine::component::getTileTraits(type) & ~engine::component::tile_trait::SLOPE) {
+            return nullptr;
+        }
+
+        // 1. 查找瓦片碰撞多边形，并把坐标从图块集瓦片尺寸缩放到地图瓦片尺寸
+        std::vector<glm::vec2> polygon;
+        if (tile_json && tile_json->contains("objectgroup") && (*tile_json)["objectgroup"].contains("objects")) {
+            if (source_size.x <= 0.0f || source_size.y <= 0.0f) source_size = glm::vec2(tile_size_);
+            const glm::vec2 scale = glm::vec2(tile_size_) / source_size;
+            for (const auto& object : (*tile_json)["objectgroup"]["objects"]) {
+                if (!object.contains("polygon")) continue;
+                glm::vec2 origin = { object.value("x", 0.0f), object.value("y", 0.0f) };
+                for (const auto& point : object["polygon"]) {
+                    polygon.emplace_back((origin + glm::vec2(point.value("x", 0.0f), point.value("y", 0.0f))) * scale);
                 }
+                break;      // 只使用第一个多边形
             }
         }
-        return engine::component::TileType::NORMAL;
+
+        // 2. 没有多边形的旧版斜坡瓦片，使用内置多边形（左上角为原点，y轴向下）
+        if (polygon.empty()) {
+            auto w = static_cast<float>(tile_size_.x);
+            auto h = static_cast<float>(tile_size_.y);
+            switch (type) {
+            case engine::component::TileType::SLOPE_0_1: polygon = { {0.0f, h}, {w, 0.0f}, {w, h} }; break;
+            case engine::component::TileType::SLOPE_1_0: polygon = { {0.0f, 0.0f}, {w, h}, {0.0f, h} }; break;
+            case engine::component::TileType::SLOPE_0_2: polygon = { {0.0f, h}, {w, h * 0.5f}, {w, h} }; break;
+            case engine::component::TileType::SLOPE_2_1: polygon = { {0.0f, h * 0.5f}, {w, 0.0f}, {w, h}, {0.0f, h} }; break;
+            case engine::component::TileType::SLOPE_1_2: polygon = { {0.0f, 0.0f}, {w, h * 0.5f}, {w, h}, {0.0f, h} }; break;
+            case engine::component::TileType::SLOPE_2_0: polygon = { {0.0f, h * 0.5f}, {w, h}, {0.0f, h} }; break;
+            default: return nullptr;    // 普通瓦片，没有高度表
+            }
+        }
+
+        // 3. 光栅化
+        return std::make_shared<const std::vector<std::uint8_t>>(rasterizeHeightProfile(polygon));
     }
 
-    engine::component::TileInfo LevelLoader::getTileInfoByGid(int gid)
+    std::vector<std::uint8_t> LevelLoader::rasterizeHeightProfile(const std::vector<glm::vec2>& polygon) const
     {
-        if (gid == 0) {
-            return engine::component::TileInfo();
+        std::vector<std::uint8_t> heights(static_cast<size_t>(tile_size_.x), 0);
+        auto tile_height = static_cast<float>(tile_size_.y);
+        for (size_t column = 0; column < heights.size(); ++column) {
+            // 在像素列中心采样：与所有边求交，取最小的 y（即多边形顶边）
+            auto x = static_cast<float>(column) + 0.5f;
+            auto top = std::numeric_limits<float>::max();
+            for (size_t i = 0; i < polygon.size(); ++i) {
+                const auto& a = polygon[i];
+                const auto& b = polygon[(i + 1) % polygon.size()];
+                if (a.x == b.x || x < std::min(a.x, b.x) || x > std::max(a.x, b.x)) continue;
+                top = std::min(top, a.y + (x - a.x) * (b.y - a.y) / (b.x - a.x));
+            }
+            if (top == std::numeric_limits<float>::max()) continue;     // 该列不被多边形覆盖，高度为0
+            heights[column] = static_cast<std::uint8_t>(std::clamp(std::lround(tile_height - top), 0L, 255L));
         }
+        return heights;
+    }
 
-        // upper_bound：查找tileset_data_中键大于 gid 的第一个元素，返回迭代器
-        auto tileset_it = tileset_data_.upper_bound(gid);
-        if (tileset_it == tileset_data_.begin()) {
+    const LevelLoader::TileEntry* LevelLoader::findTileEntry(int gid) const
+    {
+        if (gid <= 0 || static_cast<std::size_t>(gid) >= tile_table_.size()) return nullptr;
+        const auto& entry = tile_table_[gid];
+        return entry.first_gid != 0 ? &entry : nullptr;
+    }
+
+    const engine::component::TileInfo& LevelLoader::getTileInfoByGid(int gid) const
+    {
+        static const engine::component::TileInfo empty_tile;
+        if (gid == 0) {
+            return empty_tile;
+        }
+        const auto* entry = findTileEntry(gid);
+        if (!entry) {
             spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
-            return engine::component::TileInfo();
+            return empty_tile;
         }
-        --tileset_it;  // 前移一个位置，这样就得到不大于gid的最近一个元素（我们需要的）
+        return entry->tile_info;
+    }
+
+    const nlohmann::json* LevelLoader::getTileJsonByGid(int gid) const
+    {
+        const auto* entry = findTileEntry(gid);
+        return entry ? entry->tile_json : nullptr;
+    }
 
-        const auto& tileset = tileset_it->second;
-        auto local_id = gid - tileset_it->first;        // 计算瓦片在图块集中的局部ID
-        const std::string file_path = tileset.value("file_path", "");       // 获取图块集文件路径
-        if (file_path.empty()) {
-            spdlog::error("Tileset 文件 '{}' 缺少 'file_path' 属性。", tileset_it->first);
-            return engine::component::TileInfo();
+    void LevelLoader::loadTileset(const std::string& tileset_path, int first_gid)
+    {
+        // 1. 文件未修改时直接使用缓存的图块集
+        auto write_time = TilesetCache::getWriteTime(tileset_path);
+        if (!write_time) {
+            spdlog::error("无法打开 Tileset 文件: {}", tileset_path);
+            return;
         }
-        // 图块集分为两种情况，需要分别考虑
-        if (tileset.contains("image")) {    // 这是单一图片的情况
-            // 获取图片路径
-            auto texture_id = resolvePath(tileset["image"].get<std::string>(), file_path);
-            // 计算瓦片在图片网格中的坐标
-            auto coordinate_x = local_id % tileset["columns"].get<int>();
-            auto coordinate_y = local_id / tileset["columns"].get<int>();
-            // 根据坐标确定源矩形
-            SDL_FRect texture_rect = {
-                static_cast<float>(coordinate_x * tile_size_.x),
-                static_cast<float>(coordinate_y * tile_size_.y),
-                static_cast<float>(tile_size_.x),
-                static_cast<float>(tile_size_.y)
-            };
-            engine::render::Sprite sprite{ texture_id, texture_rect };
-            auto tile_type = getTileTypeById(tileset, local_id);   // 获取瓦片类型（只有瓦片id，还没找具体瓦片json）
-            return engine::component::TileInfo(sprite, tile_type);
-        }
-        else {   // 这是多图片的情况
-            if (!tileset.contains("tiles")) {   // 没有tiles字段的话不符合数据格式要求，直接返回空的瓦片信息
-                spdlog::error("Tileset 文件 '{}' 缺少 'tiles' 属性。", tileset_it->first);
-                return engine::component::TileInfo();
-            }
-            // 遍历tiles数组，根据id查找对应的瓦片
-            const auto& tiles_json = tileset["tiles"];
-            for (const auto& tile_json : tiles_json) {
-                auto tile_id = tile_json.value("id", 0);
-                if (tile_id == local_id) {   // 找到对应的瓦片，进行后续操作
-                    if (!tile_json.contains("image")) {   // 没有image字段的话不符合数据格式要求，直接返回空的瓦片信息
-                        spdlog::error("Tileset 文件 '{}' 中瓦片 {} 缺少 'image' 属性。", tileset_it->first, tile_id);
-                        return engine::component::TileInfo();
-                    }
-                    // --- 接下来根据必要信息创建并返回 TileInfo ---
-                    // 获取图片路径
-                    auto texture_id = resolvePath(tile_json["image"].get<std::string>(), file_path);
-                    // 先确认图片尺寸
-                    auto image_width = tile_json.value("imagewidth", 0);
-                    auto image_height = tile_json.value("imageheight", 0);
-                    // 从json中获取源矩形信息
-                    SDL_FRect texture_rect = {      // tiled中源矩形信息只有设置了才会有值，没有就是默认值
-                        static_cast<float>(tile_json.value("x", 0)),
-                        static_cast<float>(tile_json.value("y", 0)),
-                        static_cast<float>(tile_json.value("width", image_width)),    // 如果未设置，则使用图片尺寸
-                        static_cast<float>(tile_json.value("height", image_height))
-                    };
-                    engine::render::Sprite sprite{ texture_id, texture_rect };
-                    auto tile_type = getTileType(tile_json);    // 获取瓦片类型（已经有具体瓦片json了）
-                    return engine::component::TileInfo(sprite, tile_type);
-                }
+        auto& cache = TilesetCache::getInstance();
+        auto tileset = cache.find(tileset_path, tile_size_, *write_time);
+        if (tileset) {
+            spdlog::info("Tileset 文件 '{}' 使用缓存，firstgid: {}", tileset_path, first_gid);
+        }
+        else {
+            // 2. 读取并解析文件，预处理后存入缓存
+            std::ifstream tileset_file(tileset_path);
+            if (!tileset_file.is_open()) {
+                spdlog::error("无法打开 Tileset 文件: {}", tileset_path);
+                return;
+            }
+
+            nlohmann::json ts_json;
+            try {
+                tileset_file >> ts_json;
             }
+            catch (const nlohmann::json::parse_error& e) {
+                spdlog::error("解析 Tileset JSON 文件 '{}' 失败: {} (at byte {})", tileset_path, e.what(), e.byte);
+                return;
+            }
+            ts_json["file_path"] = tileset_path;    // 将文件路径存储到json中，后续解析图片路径时需要
+            tileset = buildTileset(std::move(ts_json));
+            if (!tileset) return;
+            cache.insert(tileset_path, tile_size_, *write_time, tileset);
+            spdlog::info("Tileset 文件 '{}' 加载完成，firstgid: {}", tileset_path, first_gid);
+        }
+
+        // 3. 按 firstgid 填入瓦片表（瓦片json指针指向缓存的数据，由 tileset_data_ 保持其生命周期）
+        tileset_data_[first_gid] = std::shared_ptr<const nlohmann::json>(tileset, &tileset->json);
+        auto end_gid = static_cast<std::size_t>(first_gid) + tileset->tiles.size();
+        if (tile_table_.size() < end_gid) tile_table_.resize(end_gid);
+        for (std::size_t local_id = 0; local_id < tileset->tiles.size(); ++local_id) {
+            const auto& tile = tileset->tiles[local_id];
+            if (!tile.valid) continue;      // id空缺，保持为无效表项
+            auto& entry = tile_table_[first_gid + local_id];
+            entry.tile_info = tile.tile_info;
+            entry.tile_json = tile.tile_json;
+            entry.first_gid = first_gid;
         }
-        // 如果能走到这里，说明查找失败，返回空的瓦片信息
-        spdlog::error("图块集 '{}' 中未找到gid为 {} 的瓦片。", tileset_it->first, gid);
-        return engine::component::TileInfo();
     }
 
-    std::optional<nlohmann::json> LevelLoader::getTileJsonByGid(int gid) const
+    std::shared_ptr<const TilesetData> LevelLoader::buildTileset(nlohmann::json&& tileset_json)
     {
-        // 1. 查找tileset_data_中键小于等于gid的最近元素
-        auto tileset_it = tileset_data_.upper_bound(gid);
-        if (tileset_it == tileset_data_.begin()) {
-            spdlog::error("gid为 {} 的瓦片未找到图块集。", gid);
-            return std::nullopt;
+        auto data = std::make_shared<TilesetData>();
+        data->json = std::move(tileset_json);
+        const auto& tileset = data->json;     // 之后不再修改json，瓦片可以引用其中的数据
+        const std::string file_path = tileset.value("file_path", "");
+        const auto* tiles_json = tileset.contains("tiles") && tileset["tiles"].is_array() ? &tileset["tiles"] : nullptr;
+        const bool single_image = tileset.contains("image");
+        if (!single_image && !tiles_json) {     // 多图片图块集没有tiles字段的话不符合数据格式要求
+            spdlog::error("Tileset 文件 '{}' 缺少 'tiles' 属性。", file_path);
+            return nullptr;
         }
-        --tileset_it;
-        // 2. 获取图块集json对象
-        const auto& tileset = tileset_it->second;
-        auto local_id = gid - tileset_it->first;        // 计算瓦片在图块集中的局部ID
-        if (!tileset.contains("tiles")) {   // 没有tiles字段的话不符合数据格式要求，直接返回空
-            spdlog::error("Tileset 文件 '{}' 缺少 'tiles' 属性。", tileset_it->first);
-            return std::nullopt;
+
+        // 1. 确定局部id的范围：单一图片为瓦片数量，多图片为最大id + 1（删除过瓦片的图块集id不连续）
+        int tile_count = 0;
+        if (single_image) {
+            tile_count = tileset.value("tilecount", 0);
         }
-        // 3. 遍历tiles数组，根据id查找对应的瓦片并返回瓦片json
-        const auto& tiles_json = tileset["tiles"];
-        for (const auto& tile_json : tiles_json) {
-            auto tile_id = tile_json.value("id", 0);
-            if (tile_id == local_id) {   // 找到对应的瓦片，返回瓦片json
-                return std::make_optional<nlohmann::json>(tile_json);
+        else {
+            for (const auto& tile_json : *tiles_json) {
+                tile_count = std::max(tile_count, tile_json.value("id", 0) + 1);
             }
         }
-        return std::nullopt;
-    }
+        if (tile_count <= 0) return data;
+        data->tiles.resize(static_cast<std::size_t>(tile_count));
 
-    void LevelLoader::loadTileset(const std::string& tileset_path, int first_gid)
-    {
-        std::ifstream tileset_file(tileset_path);
-        if (!tileset_file.is_open()) {
-            spdlog::error("无法打开 Tileset 文件: {}", tileset_path);
-            return;
+        // 2. 记录每个局部id的瓦片json（tiles 数组只遍历一次）
+        if (tiles_json) {
+            for (const auto& tile_json : *tiles_json) {
+                auto local_id = tile_json.value("id", -1);
+                if (local_id < 0 || local_id >= tile_count) continue;
+                data->tiles[local_id].tile_json = &tile_json;
+            }
         }
 
-        nlohmann::json ts_json;
-        try {
-            tileset_file >> ts_json;
+        // 3. 解析每个瓦片的精灵和类型（纹理路径只解析一次）
+        if (single_image) {
+            auto texture_id = resolvePath(tileset["image"].get<std::string>(), file_path);
+            auto columns = std::max(tileset.value("columns", 1), 1);
+            for (int local_id = 0; local_id < tile_count; ++local_id) {
+                auto& tile = data->tiles[local_id];
+                // 计算瓦片在图片网格中的坐标，并确定源矩形
+                SDL_FRect texture_rect = {
+                    static_cast<float>((local_id % columns) * tile_size_.x),
+                    static_cast<float>((local_id / columns) * tile_size_.y),
+                    static_cast<float>(tile_size_.x),
+                    static_cast<float>(tile_size_.y)
+                };
+                auto tile_type = tile.tile_json ? getTileType(*tile.tile_json) : engine::component::TileType::NORMAL;
+                auto height_profile = createHeightProfile(
+                    glm::vec2(tileset.value("tilewidth", tile_size_.x), tileset.value("tileheight", tile_size_.y)), tile.tile_json, tile_type);
+                tile.tile_info = engine::component::TileInfo(engine::render::Sprite{ texture_id, texture_rect }, tile_type, std::move(height_profile));
+                tile.valid = true;
+            }
         }
-        catch (const nlohmann::json::parse_error& e) {
-            spdlog::error("解析 Tileset JSON 文件 '{}' 失败: {} (at byte {})", tileset_path, e.what(), e.byte);
-            return;
+        else {
+            for (int local_id = 0; local_id < tile_count; ++local_id) {
+                auto& tile = data->tiles[local_id];
+                if (!tile.tile_json) continue;      // id空缺，保持为无效瓦片
+                const auto& tile_json = *tile.tile_json;
+                if (!tile_json.contains("image")) {   // 没有image字段的话不符合数据格式要求，保持为无效瓦片
+                    spdlog::error("Tileset 文件 '{}' 中瓦片 {} 缺少 'image' 属性。", file_path, local_id);
+                    tile.tile_json = nullptr;
+                    continue;
+                }
+                // 获取图片路径
+                auto texture_id = resolvePath(tile_json["image"].get<std::string>(), file_path);
+                // 先确认图片尺寸
+                auto image_width = tile_json.value("imagewidth", 0);
+                auto image_height = tile_json.value("imageheight", 0);
+                // 从json中获取源矩形信息
+                SDL_FRect texture_rect = {      // tiled中源矩形信息只有设置了才会有值，没有就是默认值
+                    static_cast<float>(tile_json.value("x", 0)),
+                    static_cast<float>(tile_json.value("y", 0)),
+                    static_cast<float>(tile_json.value("width", image_width)),    // 如果未设置，则使用图片尺寸
+                    static_cast<float>(tile_json.value("height", image_height))
+                };
+                // 碰撞多边形的坐标相对于该瓦片自己的图片
+                auto tile_type = getTileType(tile_json);
+                auto height_profile = createHeightProfile(glm::vec2(image_width, image_height), &tile_json, tile_type);
+                tile.tile_info = engine::component::TileInfo(engine::render::Sprite{ texture_id, texture_rect }, tile_type, std::move(height_profile));
+                tile.valid = true;
+            }
         }
-        ts_json["file_path"] = tileset_path;    // 将文件路径存储到json中，后续解析图片路径时需要
-        tileset_data_[first_gid] = std::move(ts_json);
-        spdlog::info("Tileset 文件 '{}' 加载完成，firstgid: {}", tileset_path, first_gid);
+        return data;
     }
 
     std::string LevelLoader::resolvePath(const std::string& relative_path, const std::string& file_path)
@@ -621,4 +1553,18 @@ namespace engine::scene {
         }
     }
 
+    std::string LevelLoader::makeRelativePath(const std::string& path, const std::string& file_path)
+    {
+        // 两侧都先转为规范的绝对路径，再做词法上的相对化（weakly_canonical 不要求路径存在）
+        std::error_code ec;
+        auto map_dir = std::filesystem::weakly_canonical(std::filesystem::absolute(file_path, ec).parent_path(), ec);
+        auto full_path = std::filesystem::weakly_canonical(std::filesystem::absolute(path, ec), ec);
+        if (ec) {
+            spdlog::warn("无法转换路径 '{}': {}", path, ec.message());
+            return path;
+        }
+        auto relative = full_path.lexically_relative(map_dir);
+        return relative.empty() ? path : relative.generic_string();
+    }
+
 } // namespace engine::scene
\ No newline at end of file
@@ -3,30 +3,69 @@
 #include <glm/vec2.hpp>
 #include <nlohmann/json.hpp>
 #include <map>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
 #include <optional>
+#include <unordered_set>
 #include "../utils/math.h"
+#include "../resource/resource_manifest.h"
+#include "level_streamer.h"
+
+namespace engine::object {
+    class GameObject;
+}
 
 namespace engine::component {
-    class AnimationComponent;
-    class AudioComponent;
     struct TileInfo;
     enum class TileType;
 }
 
 namespace engine::scene {
     class Scene;
+    struct TilesetData;
 
     /**
      * @brief 负责从 Tiled JSON 文件 (.tmj) 加载关卡数据到 Scene 中。
+     *
+     * 启用按需生成（setSpawnOnDemand，要求加载器由 std::shared_ptr 持有）时，对象图层中的图片对象不会立即创建，
+     * 而是登记到场景的 ObjectSpawner，相机接近时再由加载器创建（生成器持有加载器直到场景清理）；
+     * 场景初始化时需要按名称查找的对象（如玩家）应通过 addImmediateObjectName 声明，始终立即创建。默认所有对象立即创建。
+     * 加载图块集时即把每个瓦片解析为按 gid 直接索引的瓦片表（纹理路径、源矩形、类型、高度表），
+     * 解码瓦片图层时每个瓦片只需一次数组访问。预处理好的图块集保存在进程级的 TilesetCache 中，
+     * 各关卡共享，切换关卡时只需解析地图文件本身。
+     * 瓦片图层按块稀疏存储（见 TileChunkMap），支持 Tiled 无限地图（图层数据在 chunks 中）。
+     * 地图旁存在与源文件一致的烘焙关卡 (.g3lvl，见 cooked_level.h) 时优先加载烘焙文件，否则解析 JSON。
+     * 加载分为两个阶段：prepareLevel 只解析文件，不访问场景和渲染资源，可在后台线程执行（见 LevelLoadTask）；
+     * buildLevel 在主线程创建游戏对象。loadLevel 依次执行两者。
+     * 烘焙关卡的瓦片块总数超过流式加载预算时只读入块目录，构建时为场景创建 LevelStreamer，由相机位置驱动按块读入。
      */
-    class LevelLoader final {
+    class LevelLoader final : public std::enable_shared_from_this<LevelLoader> {
         std::string map_path_;      ///< @brief 地图路径（拼接路径时需要）
         glm::ivec2 map_size_;       ///< @brief 地图尺寸(瓦片数量)
         glm::ivec2 tile_size_;      ///< @brief 瓦片尺寸(像素)
-        std::map<int, nlohmann::json> tileset_data_;    ///< @brief firstgid -> 瓦片集数据
+        std::map<int, std::shared_ptr<const nlohmann::json>> tileset_data_;    ///< @brief firstgid -> 瓦片集数据（JSON 关卡中与图块集缓存共享）
+        std::vector<nlohmann::json> spawn_sources_;     ///< @brief 按需生成的对象json（生成记录的来源下标指向这里）
+
+        struct ObjectPrefab;    ///< @brief 预制体（在cpp中定义）
+        struct TileEntry;       ///< @brief 瓦片表项（在cpp中定义）
+        std::vector<TileEntry> tile_table_;             ///< @brief gid -> 瓦片表项（加载图块集时构建，下标即gid）
+
+        struct PreparedLayer;   ///< @brief 预处理图层（在cpp中定义）
+        std::vector<PreparedLayer> prepared_layers_;    ///< @brief 解析阶段生成、等待构建的图层
+        engine::resource::ResourceManifest resource_manifest_;  ///< @brief 关卡用到的纹理和音效
+        bool prepared_ = false;                         ///< @brief 是否已成功解析、尚未构建
+        LevelStreamingSettings streaming_settings_;     ///< @brief 流式加载设置（解析前设置）
+        std::string cooked_path_;                       ///< @brief 需要流式加载时的烘焙关卡路径（否则为空）
+        bool spawn_on_demand_ = false;                  ///< @brief 是否按需生成对象图层中的图片对象（构建前设置）
+        std::unordered_set<std::string> immediate_object_names_;   ///< @brief 按需生成时仍然立即创建的对象名称
+        std::uint32_t next_level_order_ = 0;            ///< @brief 构建时分配给下一个图层或对象的关卡顺序
 
     public:
-        LevelLoader() = default;
+        // 构造/析构函数定义在cpp中（预制体在那里是完整类型）
+        LevelLoader();
+        ~LevelLoader();
 
         /**
          * @brief 加载关卡数据到指定的 Scene 对象中。
@@ -36,25 +75,93 @@ namespace engine::scene {
          */
         [[nodiscard]] bool loadLevel(const std::string& map_path, Scene& scene);
 
+        /**
+         * @brief 解析阶段：解析关卡文件（烘焙文件或 JSON），生成待构建的图层和资源清单。
+         * @details 不访问场景、上下文和资源管理器，可在后台线程调用。
+         * @param map_path Tiled JSON 地图文件的路径。
+         * @return bool 是否解析成功。
+         */
+        [[nodiscard]] bool prepareLevel(const std::string& map_path);
+
+        /**
+         * @brief 构建阶段：载入资源清单中尚未载入的资源，并为解析好的图层创建游戏对象（必须在主线程调用）。
+         * @param scene 要加载数据的目标 Scene 对象。
+         * @return bool 是否构建成功（没有成功解析时返回 false）。
+         */
+        [[nodiscard]] bool buildLevel(Scene& scene);
+
+        /// @brief 设置流式加载设置（须在 prepareLevel 之前调用）
+        void setStreamingSettings(const LevelStreamingSettings& settings) { streaming_settings_ = settings; }
+
+        /// @brief 设置是否按需生成对象图层中的图片对象（须在 buildLevel 之前调用；加载器必须由 std::shared_ptr 持有）
+        void setSpawnOnDemand(bool spawn_on_demand) { spawn_on_demand_ = spawn_on_demand; }
+
+        /// @brief 声明一个必须立即创建的对象名称（场景初始化时按名称查找的对象，须在 buildLevel 之前调用）
+        void addImmediateObjectName(const std::string& name) { immediate_object_names_.insert(name); }
+
+        const engine::resource::ResourceManifest& getResourceManifest() const { return resource_manifest_; }  ///< @brief 获取资源清单（解析后有效）
+
+        /**
+         * @brief 将 Tiled JSON 地图烘焙为二进制关卡文件 (.g3lvl)，不需要场景。
+         * @param map_path Tiled JSON 地图文件的路径。
+         * @param output_path 输出路径，为空则写到地图旁（扩展名替换为 .g3lvl）。
+         * @return bool 是否烘焙成功。
+         */
+        [[nodiscard]] bool cookLevel(const std::string& map_path, const std::string& output_path = "");
+
     private:
-        void loadImageLayer(const nlohmann::json& layer_json, Scene& scene);    ///< @brief 加载图片图层
-        void loadTileLayer(const nlohmann::json& layer_json, Scene& scene);     ///< @brief 加载瓦片图层
+        /**
+         * @brief 解析地图 JSON 文件并加载其引用的所有 tileset（加载 JSON 关卡和烘焙关卡共用）。
+         * @param map_path Tiled JSON 地图文件的路径。
+         * @param json_data 输出：地图json数据（已检查 layers 数组存在）
+         * @return bool 是否解析成功。
+         */
+        bool parseMap(const std::string& map_path, nlohmann::json& json_data);
+
+        /**
+         * @brief 尝试从地图对应的烘焙关卡文件解析关卡。
+         * @details 文件不存在、版本不符、源文件已修改或数据损坏时返回 false，且不会修改加载器状态。
+         * @param map_path Tiled JSON 地图文件的路径（烘焙文件在其旁边）。
+         * @return bool 是否从烘焙文件解析成功。
+         */
+        bool prepareCookedLevel(const std::string& map_path);
+
+
+        void prepareImageLayer(const nlohmann::json& layer_json);               ///< @brief 解析图片图层
+        /**
+         * @brief 解码瓦片图层到预处理图层（各图层互不依赖，由线程池并行调用）。
+         * @param layer_json 瓦片图层json
+         * @param layer 输出：预处理图层
+         * @param used_gids 输出：标记用到的gid（每个调用各自一份）
+         * @return bool 是否解码成功
+         */
+        bool prepareTileLayer(const nlohmann::json& layer_json, PreparedLayer& layer, std::vector<std::uint8_t>& used_gids);
+        /// @brief 保存对象图层json，留到构建阶段创建对象（object_gids 中标记对象引用的gid）
+        void prepareObjectLayer(nlohmann::json&& layer_json, std::vector<std::uint8_t>& object_gids);
+        /// @brief 由线程池并行解析这些gid的预制体（动画集留到主线程注册）
+        void prepareObjectPrefabs(const std::vector<int>& gids);
+        /// @brief 将瓦片 sound 属性中的音效路径加入资源清单
+        void collectSounds(const nlohmann::json* tile_json);
         void loadObjectLayer(const nlohmann::json& layer_json, Scene& scene);   ///< @brief 加载对象图层
 
         /**
-         * @brief 添加动画到指定的 AnimationComponent。
-         * @param anim_json 动画json数据（自定义）
-         * @param ac AnimationComponent 指针（动画添加到此组件）
-         * @param sprite_size 每一帧动画的尺寸
+         * @brief 根据对象图层中的一个对象创建游戏对象（不添加到场景）。
+         * @param object 对象json数据
+         * @param scene 目标场景（提供上下文）
+         * @return 创建的游戏对象，失败或不支持的对象返回空指针
          */
-        void addAnimation(const nlohmann::json& anim_json, engine::component::AnimationComponent* ac, const glm::vec2& sprite_size);
+        std::unique_ptr<engine::object::GameObject> createObject(const nlohmann::json& object, Scene& scene);
 
         /**
-         * @brief 添加音效到指定的 AudioComponent。
-         * @param sound_json 音效json数据（自定义）
-         * @param audio_component AudioComponent 指针（音效添加到此组件）
+         * @brief 获取gid对应的预制体，首次查询时解析瓦片json并缓存到瓦片表中。
+         * @param gid 全局 ID
+         * @param scene 目标场景（提供资源管理器）
+         * @return 预制体指针，瓦片无法创建对象（缺少纹理、属性json格式错误等）时返回空指针
          */
-        void addSound(const nlohmann::json& sound_json, engine::component::AudioComponent* audio_component);
+        const ObjectPrefab* getObjectPrefab(int gid, Scene& scene);
+
+        /// @brief 解析瓦片表项对应的瓦片json，创建预制体（不访问动画库，可在工作线程调用；失败返回空指针）
+        std::unique_ptr<ObjectPrefab> createObjectPrefab(int gid, const TileEntry& entry);
 
         /**
          * @brief 获取瓦片属性
@@ -77,6 +184,22 @@ namespace engine::scene {
             return std::nullopt;
         }
 
+        /**
+         * @brief 获取对象属性：对象自身的属性优先，其次是其瓦片（gid）的属性
+         * @tparam T 属性类型
+         * @param object_json 对象json数据
+         * @param property_name 属性名称
+         * @return 属性值，如果属性不存在则返回 std::nullopt
+         */
+        template<typename T>
+        std::optional<T> getObjectProperty(const nlohmann::json& object_json, const std::string& property_name) {
+            if (auto value = getTileProperty<T>(object_json, property_name); value) return value;
+            auto gid = object_json.value("gid", 0);
+            if (gid == 0) return std::nullopt;
+            auto tile_json = getTileJsonByGid(gid);
+            return tile_json ? getTileProperty<T>(*tile_json, property_name) : std::nullopt;
+        }
+
         /**
          * @brief 获取瓦片碰撞器矩形
          * @param tile_json 瓦片json数据
@@ -92,34 +215,71 @@ namespace engine::scene {
         engine::component::TileType getTileType(const nlohmann::json& tile_json);
 
         /**
-         * @brief 根据（单一图片）图块集中的id获取瓦片类型
-         * @param tileset_json 图块集json数据
-         * @param local_id 图块集中的id
-         * @return 瓦片类型
+         * @brief 创建图块集中瓦片的高度表（构建瓦片表时每个瓦片调用一次）。
+         * @details 优先使用瓦片碰撞多边形（Tiled 碰撞编辑器中的 polygon 对象），
+         *          没有多边形的旧版 SLOPE_* 瓦片则使用对应的内置多边形。
+         * @param source_size 多边形坐标所在的瓦片尺寸（单一图片图块集为 tilewidth/tileheight，多图片图块集为该瓦片的图片尺寸）
+         * @param tile_json 瓦片json数据（图块集中没有该瓦片的条目时为空指针）
+         * @param type 瓦片类型
+         * @return 高度表，不是斜坡瓦片则返回空指针
+         */
+        std::shared_ptr<const std::vector<std::uint8_t>> createHeightProfile(glm::vec2 source_size,
+            const nlohmann::json* tile_json, engine::component::TileType type);
+
+        /**
+         * @brief 将多边形光栅化为高度表（每个像素列取多边形顶边，转换为距瓦片底部的高度）。
+         * @param polygon 多边形顶点（瓦片左上角为原点，已缩放到地图瓦片尺寸）
+         * @return 高度表，长度为地图瓦片宽度
+         */
+        std::vector<std::uint8_t> rasterizeHeightProfile(const std::vector<glm::vec2>& polygon) const;
+
+        /**
+         * @brief 解码瓦片图层的数据，对每个非空瓦片调用 func(glm::ivec2 pos, std::uint32_t gid)。
+         * @details 支持有限地图的 data 和无限地图的 chunks（块位置可以为负）。模板只在cpp中实例化。
+         * @param layer_json 瓦片图层json
+         * @param func 回调
+         * @return bool 是否解码成功
          */
-        engine::component::TileType getTileTypeById(const nlohmann::json& tileset_json, int local_id);
+        template<typename Func>
+        bool forEachLayerTile(const nlohmann::json& layer_json, Func&& func);
+
+        /// @brief 获取地图的瓦片数量（地图宽度 * 地图高度）
+        std::size_t getTileCount() const {
+            return static_cast<std::size_t>(std::max(map_size_.x, 0)) * static_cast<std::size_t>(std::max(map_size_.y, 0));
+        }
+
+        /// @brief 根据全局 ID 查找瓦片表项（一次数组访问），不存在时返回空指针
+        const TileEntry* findTileEntry(int gid) const;
 
         /**
          * @brief 根据全局 ID 获取瓦片信息。
          * @param gid 全局 ID。
-         * @return engine::component::TileInfo 瓦片信息。
+         * @return engine::component::TileInfo 瓦片信息（gid为0或无效时为空瓦片）。
          */
-        engine::component::TileInfo getTileInfoByGid(int gid);
+        const engine::component::TileInfo& getTileInfoByGid(int gid) const;
 
         /**
          * @brief 根据全局 ID 获取瓦片json对象 (用于对象层获取瓦片信息)
          * @param gid 全局 ID
-         * @return 瓦片json对象
+         * @return 指向图块集数据中瓦片json对象的指针（不拷贝），未找到时返回空指针
          */
-        std::optional<nlohmann::json> getTileJsonByGid(int gid) const;
+        const nlohmann::json* getTileJsonByGid(int gid) const;
 
         /**
-         * @brief 加载 Tiled tileset 文件 (.tsj)。
+         * @brief 加载 Tiled tileset 文件 (.tsj)，并构建其瓦片表项。
+         * @details 优先使用图块集缓存（文件未修改时不再读取和解析），否则解析后存入缓存。
          * @param tileset_path Tileset 文件路径。
          * @param first_gid 此 tileset 的第一个全局 ID。
          */
         void loadTileset(const std::string& tileset_path, int first_gid);
 
+        /**
+         * @brief 为图块集的每个瓦片解析纹理路径、源矩形、类型和高度表（结果与 firstgid 无关，可被各关卡共享）。
+         * @param tileset_json 图块集json数据（含 file_path 字段，移入返回的图块集中）
+         * @return 预处理好的图块集，格式错误时返回空指针
+         */
+        std::shared_ptr<const TilesetData> buildTileset(nlohmann::json&& tileset_json);
+
         /**
          * @brief 解析图片路径，合并地图路径和相对路径。例如：
          * 1. 文件路径："assets/maps/level1.tmj"
@@ -130,6 +290,15 @@ namespace engine::scene {
          * @return std::string 解析后的完整路径。
          */
         std::string resolvePath(const std::string& relative_path, const std::string& file_path);
+
+        /**
+         * @brief resolvePath 的逆操作：把路径转换为相对于文件所在目录的路径（使用 '/' 分隔）。
+         *        烘焙文件中的路径都以此形式保存，使其不依赖于机器和检出目录。
+         * @param path 要转换的路径（绝对或相对于工作目录）
+         * @param file_path 文件路径
+         * @return std::string 相对路径；无法转换（如位于不同盘符）时返回原路径。
+         */
+        std::string makeRelativePath(const std::string& path, const std::string& file_path);
     };
 
 } // namespace engine::scene
\ No newline at end of file
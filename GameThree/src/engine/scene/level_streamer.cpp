@@ -0,0 +1,247 @@
+#include "level_streamer.h"
+#include "../component/tilelayer_component.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+    namespace {
+        constexpr float VELOCITY_SMOOTHING = 0.2f;      ///< 相机速度的指数平滑系数（每帧取新速度的比例）
+    }
+
+    LevelStreamer::LevelStreamer(std::string file_path, glm::ivec2 tile_size, const LevelStreamingSettings& settings)
+        : file_path_(std::move(file_path)),
+        chunk_pixel_size_(glm::max(tile_size, glm::ivec2(1)) * engine::component::TileChunkMap::CHUNK_SIZE),
+        settings_(settings) {
+        worker_ = std::thread(&LevelStreamer::run, this);
+        spdlog::trace("关卡流式加载器已启动: {}", file_path_);
+    }
+
+    LevelStreamer::~LevelStreamer() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_one();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void LevelStreamer::addLayer(engine::component::TileLayerComponent* layer, std::uint8_t index_width,
+        const std::vector<std::pair<glm::ivec2, std::uint64_t>>& chunk_directory) {
+        if (!layer) return;
+        auto& stream_layer = layers_.emplace_back();
+        stream_layer.layer = layer;
+        stream_layer.index_width = index_width;
+        stream_layer.chunk_offsets.reserve(chunk_directory.size());
+        for (const auto& [chunk_coord, offset] : chunk_directory) {
+            stream_layer.chunk_offsets[engine::component::TileChunkMap::packKey(chunk_coord)] = offset;
+        }
+    }
+
+    void LevelStreamer::update(const engine::utils::Rect& view, float delta_time) {
+        using engine::component::TileChunkMap;
+        if (layers_.empty()) return;
+
+        // 1. 装入工作线程读好的块，并撤回上一帧尚未开始读取的请求（本帧按新的相机位置重新排序提交）
+        installCompleted();
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto& request : requests_) {
+                layers_[request.layer_index].pending.erase(TileChunkMap::packKey(request.chunk_coord));
+                --pending_count_;
+            }
+            requests_.clear();
+        }
+
+        // 2. 估计相机速度（指数平滑，避免单帧抖动）
+        if (!first_update_ && delta_time > 0.0f) {
+            auto velocity = (view.position - last_camera_position_) / delta_time;
+            camera_velocity_ = glm::mix(camera_velocity_, velocity, VELOCITY_SMOOTHING);
+        }
+        last_camera_position_ = view.position;
+
+        // 3. 预取范围：视口向四周扩展 margin，再沿相机速度方向扩展 速度 * 前瞻时间
+        const auto lookahead = camera_velocity_ * settings_.lookahead;
+        const glm::vec2 range_min = view.position - settings_.margin + glm::min(lookahead, glm::vec2(0.0f));
+        const glm::vec2 range_max = view.position + view.size + settings_.margin + glm::max(lookahead, glm::vec2(0.0f));
+        const glm::vec2 chunk_size = glm::vec2(chunk_pixel_size_);
+        const glm::ivec2 chunk_min = glm::ivec2(glm::floor(range_min / chunk_size));
+        const glm::ivec2 chunk_max = glm::ivec2(glm::floor(range_max / chunk_size));
+        const glm::vec2 center = view.position + view.size * 0.5f;
+        const glm::ivec2 view_min = glm::ivec2(glm::floor(view.position / chunk_size));
+        const glm::ivec2 view_max = glm::ivec2(glm::floor((view.position + view.size) / chunk_size));
+
+        // 4. 收集范围内尚未载入的块：视口内的块在前，再按到相机中心的距离由近到远排序
+        std::vector<ChunkRequest> wanted;
+        for (std::uint32_t layer_index = 0; layer_index < layers_.size(); ++layer_index) {
+            const auto& stream_layer = layers_[layer_index];
+            for (int chunk_y = chunk_min.y; chunk_y <= chunk_max.y; ++chunk_y) {
+                for (int chunk_x = chunk_min.x; chunk_x <= chunk_max.x; ++chunk_x) {
+                    const auto key = TileChunkMap::packKey({ chunk_x, chunk_y });
+                    auto it = stream_layer.chunk_offsets.find(key);
+                    if (it == stream_layer.chunk_offsets.end()) continue;
+                    if (stream_layer.resident.contains(key) || stream_layer.pending.contains(key)) continue;
+                    const glm::vec2 chunk_center = (glm::vec2(chunk_x, chunk_y) + 0.5f) * chunk_size;
+                    const bool in_view = chunk_x >= view_min.x && chunk_x <= view_max.x && chunk_y >= view_min.y && chunk_y <= view_max.y;
+                    wanted.push_back({ layer_index, { chunk_x, chunk_y }, it->second, stream_layer.index_width,
+                        glm::length(chunk_center - center), in_view });
+                }
+            }
+        }
+        std::sort(wanted.begin(), wanted.end(), [](const auto& a, const auto& b) {
+            return a.in_view != b.in_view ? a.in_view : a.distance < b.distance;
+        });
+
+        // 5. 预算：先回收范围之外最远的块，仍然不够时只提交最近的块；视口内的块总是提交（否则画面和碰撞会一直有空洞）
+        const auto budget = settings_.chunk_budget;
+        if (resident_count_ + pending_count_ + wanted.size() > budget) {
+            evictOutside(chunk_min, chunk_max, center, wanted.size());
+        }
+        const auto used = resident_count_ + pending_count_;
+        const auto available = budget > used ? budget - used : 0;
+        const auto in_view_count = static_cast<std::size_t>(std::count_if(wanted.begin(), wanted.end(), [](const auto& request) { return request.in_view; }));
+        const auto submit_count = std::min(wanted.size(), std::max(available, in_view_count));
+        const bool over_budget = submit_count < wanted.size() || used + submit_count > budget;
+        if (over_budget && !over_budget_) {
+            spdlog::warn("关卡流式加载：常驻块预算 {} 不足以覆盖预取范围（常驻 {}，读取中 {}，范围内还需 {} 个），"
+                "舍弃 {} 个预取块，超出预算载入 {} 个视口内的块。请增大 chunk_budget 或减小预取范围。",
+                budget, resident_count_, pending_count_, wanted.size(), wanted.size() - submit_count,
+                submit_count > available ? submit_count - available : 0);
+        }
+        else if (!over_budget && over_budget_) {
+            spdlog::info("关卡流式加载：预取范围重新回到预算 {} 之内。", budget);
+        }
+        over_budget_ = over_budget;
+        wanted.resize(submit_count);
+
+        // 6. 首次更新时同步读入（开局视口内不能有空洞），之后交给工作线程
+        if (first_update_) {
+            first_update_ = false;
+            std::ifstream file(file_path_, std::ios::binary);
+            for (const auto& request : wanted) {
+                installChunk(request.layer_index, request.chunk_coord, readChunk(file, request));
+            }
+            spdlog::info("关卡流式加载：首次同步载入 {} 个块（视口 ({}, {}) 处）。", wanted.size(), view.position.x, view.position.y);
+            return;
+        }
+        if (wanted.empty()) return;
+        {
+            std::lock_guard lock(mutex_);
+            requests_.assign(wanted.rbegin(), wanted.rend());   // 工作线程从末尾（最近的块）开始读取
+            for (const auto& request : wanted) {
+                layers_[request.layer_index].pending.insert(TileChunkMap::packKey(request.chunk_coord));
+            }
+            pending_count_ += wanted.size();
+        }
+        condition_.notify_one();
+    }
+
+    void LevelStreamer::run() {
+        std::ifstream file(file_path_, std::ios::binary);
+        if (!file.is_open()) {
+            spdlog::error("关卡流式加载：无法打开烘焙关卡 '{}'。", file_path_);
+        }
+        while (true) {
+            ChunkRequest request;
+            {
+                std::unique_lock lock(mutex_);
+                condition_.wait(lock, [this]() { return stopping_ || !requests_.empty(); });
+                if (stopping_) return;
+                request = requests_.back();
+                requests_.pop_back();
+            }
+            LoadedChunk loaded{ request.layer_index, request.chunk_coord, readChunk(file, request) };
+            std::lock_guard lock(mutex_);
+            completed_.push_back(std::move(loaded));
+        }
+    }
+
+    void LevelStreamer::installCompleted() {
+        std::vector<LoadedChunk> completed;
+        {
+            std::lock_guard lock(mutex_);
+            completed.swap(completed_);
+        }
+        for (const auto& loaded : completed) {
+            layers_[loaded.layer_index].pending.erase(engine::component::TileChunkMap::packKey(loaded.chunk_coord));
+            --pending_count_;
+            installChunk(loaded.layer_index, loaded.chunk_coord, loaded.indices);
+        }
+    }
+
+    std::vector<std::uint32_t> LevelStreamer::readChunk(std::ifstream& file, const ChunkRequest& request) {
+        constexpr auto area = static_cast<std::size_t>(engine::component::TileChunkMap::CHUNK_AREA);
+        std::vector<std::uint8_t> bytes(area * request.index_width);
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(request.offset));
+        if (!file || !file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            return {};
+        }
+        std::vector<std::uint32_t> indices(area);
+        for (std::size_t i = 0; i < area; ++i) {
+            if (request.index_width == 2) {
+                std::uint16_t index16 = 0;
+                std::memcpy(&index16, bytes.data() + i * 2, sizeof(index16));
+                indices[i] = index16;
+            }
+            else {
+                std::memcpy(&indices[i], bytes.data() + i * 4, sizeof(std::uint32_t));
+            }
+        }
+        return indices;
+    }
+
+    void LevelStreamer::installChunk(std::uint32_t layer_index, glm::ivec2 chunk_coord, const std::vector<std::uint32_t>& indices) {
+        auto& stream_layer = layers_[layer_index];
+        const auto key = engine::component::TileChunkMap::packKey(chunk_coord);
+        if (indices.empty()) {      // 文件被截断或修改，之后不再请求该块
+            spdlog::error("关卡流式加载：读取块 ({}, {}) 失败: {}", chunk_coord.x, chunk_coord.y, file_path_);
+            stream_layer.chunk_offsets.erase(key);
+            return;
+        }
+        if (!stream_layer.resident.insert(key).second) return;
+        stream_layer.layer->loadChunk(chunk_coord, indices.data());
+        ++resident_count_;
+    }
+
+    void LevelStreamer::evictOutside(glm::ivec2 range_min, glm::ivec2 range_max, glm::vec2 center, std::size_t needed) {
+        using engine::component::TileChunkMap;
+        struct Candidate {
+            std::uint32_t layer_index;
+            std::uint64_t key;
+            float distance;
+        };
+        std::vector<Candidate> candidates;
+        const glm::vec2 chunk_size = glm::vec2(chunk_pixel_size_);
+        for (std::uint32_t layer_index = 0; layer_index < layers_.size(); ++layer_index) {
+            for (auto key : layers_[layer_index].resident) {
+                const auto chunk_coord = TileChunkMap::unpackKey(key);
+                if (chunk_coord.x >= range_min.x && chunk_coord.x <= range_max.x &&
+                    chunk_coord.y >= range_min.y && chunk_coord.y <= range_max.y) continue;
+                const glm::vec2 chunk_center = (glm::vec2(chunk_coord) + 0.5f) * chunk_size;
+                candidates.push_back({ layer_index, key, glm::length(chunk_center - center) });
+            }
+        }
+        // 离相机最远（通常在相机身后）的块最先回收
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.distance > b.distance; });
+        std::size_t evicted = 0;
+        for (const auto& candidate : candidates) {
+            if (resident_count_ + pending_count_ + needed <= settings_.chunk_budget) break;
+            auto& stream_layer = layers_[candidate.layer_index];
+            stream_layer.resident.erase(candidate.key);
+            stream_layer.layer->unloadChunk(TileChunkMap::unpackKey(candidate.key));
+            --resident_count_;
+            ++evicted;
+        }
+        if (evicted > 0) {
+            spdlog::trace("关卡流式加载：回收 {} 个块（常驻 {} 个）。", evicted, resident_count_);
+        }
+    }
+
+} // namespace engine::scene
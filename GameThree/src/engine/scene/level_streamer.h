@@ -0,0 +1,141 @@
+#pragma once
+#include "../utils/math.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::component {
+    class TileLayerComponent;
+}
+
+namespace engine::scene {
+
+    /**
+     * @brief 关卡流式加载设置（来自配置文件，由场景管理器保存）。
+     */
+    struct LevelStreamingSettings {
+        std::size_t chunk_budget = 4096;    ///< @brief 常驻瓦片块数量上限（所有图层合计）；关卡块总数不超过时整体载入，0 表示禁用流式加载
+        float margin = 512.0f;              ///< @brief 预取范围：视口向四周扩展的距离（像素）
+        float lookahead = 0.5f;             ///< @brief 预取前瞻时间（秒）：预取范围沿相机速度方向再扩展 速度 * 前瞻时间
+        bool unloaded_solid = false;        ///< @brief 未载入的块视为实心瓦片（true）或空瓦片（false）
+    };
+
+    /**
+     * @brief 关卡流式加载器：相机接近时从烘焙关卡文件读入瓦片块，远离且超出预算时回收。
+     *
+     * 加载烘焙关卡时只读入元数据和块目录（块坐标 -> 块数据在文件中的偏移），瓦片图层中的块全部记为未载入。
+     * 每帧根据相机视口、预取范围和相机速度计算需要的块，按距离由近到远交给后台线程读取；
+     * 主线程取回读好的块装入瓦片图层（物理引擎随之刷新该块的瓦片特性）。
+     * 常驻块超过预算时，先回收预取范围之外、离相机最远的块；视口内的块总是载入（必要时临时超出预算并给出警告）。
+     * 首次更新时同步读入预取范围内的块，避免开局出现空洞，因此场景应在相机移到起始位置（如玩家处）之后才开始更新。
+     */
+    class LevelStreamer final {
+        /// @brief 流式加载的瓦片图层
+        struct StreamLayer {
+            engine::component::TileLayerComponent* layer = nullptr;         ///< @brief 瓦片图层组件（非拥有）
+            std::uint8_t index_width = 2;                                   ///< @brief 调色板下标宽度（字节）
+            std::unordered_map<std::uint64_t, std::uint64_t> chunk_offsets; ///< @brief 块坐标键 -> 块数据的文件偏移
+            std::unordered_set<std::uint64_t> resident;                     ///< @brief 已载入的块
+            std::unordered_set<std::uint64_t> pending;                      ///< @brief 已提交读取、尚未装入的块
+        };
+
+        /// @brief 读取请求（主线程提交，工作线程处理）
+        struct ChunkRequest {
+            std::uint32_t layer_index = 0;      ///< @brief 图层下标
+            glm::ivec2 chunk_coord = { 0, 0 };  ///< @brief 块坐标
+            std::uint64_t offset = 0;           ///< @brief 块数据的文件偏移
+            std::uint8_t index_width = 2;       ///< @brief 调色板下标宽度（字节）
+            float distance = 0.0f;              ///< @brief 块中心到相机中心的距离（排序用）
+            bool in_view = false;               ///< @brief 块是否与视口相交（这些块优先，且不受预算限制）
+        };
+
+        /// @brief 读好的块（工作线程写入，主线程装入）
+        struct LoadedChunk {
+            std::uint32_t layer_index = 0;      ///< @brief 图层下标
+            glm::ivec2 chunk_coord = { 0, 0 };  ///< @brief 块坐标
+            std::vector<std::uint32_t> indices; ///< @brief 调色板下标数组（读取失败时为空）
+        };
+
+        std::string file_path_;                 ///< @brief 烘焙关卡文件路径
+        glm::ivec2 chunk_pixel_size_;           ///< @brief 块的像素尺寸
+        LevelStreamingSettings settings_;       ///< @brief 流式加载设置
+        std::vector<StreamLayer> layers_;       ///< @brief 流式加载的瓦片图层
+        std::size_t resident_count_ = 0;        ///< @brief 常驻块数量（所有图层合计）
+        std::size_t pending_count_ = 0;         ///< @brief 读取中的块数量（所有图层合计）
+
+        glm::vec2 last_camera_position_ = glm::vec2(0.0f);  ///< @brief 上一帧相机位置（估计速度用）
+        glm::vec2 camera_velocity_ = glm::vec2(0.0f);       ///< @brief 平滑后的相机速度（像素/秒）
+        bool first_update_ = true;                          ///< @brief 是否尚未更新过
+        bool over_budget_ = false;                          ///< @brief 预算是否不足以覆盖预取范围（状态变化时才输出日志）
+
+        std::mutex mutex_;                              ///< @brief 保护下面的请求队列和结果
+        std::condition_variable condition_;             ///< @brief 通知工作线程有新请求或需要退出
+        std::vector<ChunkRequest> requests_;            ///< @brief 待读取的请求（按距离由远到近，工作线程从末尾取）
+        std::vector<LoadedChunk> completed_;            ///< @brief 已读好、待装入的块
+        bool stopping_ = false;                         ///< @brief 工作线程是否需要退出
+        std::thread worker_;                            ///< @brief 工作线程（最后声明，确保其他成员先初始化）
+
+    public:
+        /**
+         * @brief 创建流式加载器并启动工作线程（之后通过 addLayer 登记图层）。
+         * @param file_path 烘焙关卡文件路径
+         * @param tile_size 瓦片尺寸（像素）
+         * @param settings 流式加载设置
+         */
+        LevelStreamer(std::string file_path, glm::ivec2 tile_size, const LevelStreamingSettings& settings);
+        ~LevelStreamer();   ///< @brief 停止并等待工作线程结束
+
+        // 禁止拷贝和移动
+        LevelStreamer(const LevelStreamer&) = delete;
+        LevelStreamer& operator=(const LevelStreamer&) = delete;
+        LevelStreamer(LevelStreamer&&) = delete;
+        LevelStreamer& operator=(LevelStreamer&&) = delete;
+
+        /**
+         * @brief 登记一个流式加载的瓦片图层（目录中的块应已在图层的瓦片数据中标记为未载入）。
+         * @param layer 瓦片图层组件（生命周期须长于流式加载器，场景清理时先销毁流式加载器）
+         * @param index_width 调色板下标宽度（2 或 4 字节）
+         * @param chunk_directory 块目录 (块坐标, 块数据的文件偏移)
+         */
+        void addLayer(engine::component::TileLayerComponent* layer, std::uint8_t index_width,
+            const std::vector<std::pair<glm::ivec2, std::uint64_t>>& chunk_directory);
+
+        /**
+         * @brief 更新流式加载状态（每帧在物理模拟之前调用一次）。
+         * @param view 当前视口的世界矩形
+         * @param delta_time 帧间隔（秒，用于估计相机速度）
+         */
+        void update(const engine::utils::Rect& view, float delta_time);
+
+        std::size_t getResidentCount() const { return resident_count_; }   ///< @brief 获取常驻块数量
+        std::size_t getPendingCount() const { return pending_count_; }     ///< @brief 获取读取中的块数量
+
+    private:
+        void run();             ///< @brief 工作线程入口
+        void installCompleted();///< @brief 装入工作线程读好的块（主线程）
+
+        /**
+         * @brief 从文件读取一个块并转换为 32 位调色板下标（工作线程和首次同步加载共用）。
+         * @param file 已打开的烘焙关卡文件
+         * @param request 读取请求
+         * @return 调色板下标数组，读取失败时为空
+         */
+        static std::vector<std::uint32_t> readChunk(std::ifstream& file, const ChunkRequest& request);
+
+        /// @brief 装入一个块（indices 为空表示读取失败，之后不再请求该块）
+        void installChunk(std::uint32_t layer_index, glm::ivec2 chunk_coord, const std::vector<std::uint32_t>& indices);
+
+        /// @brief 回收预取范围之外、离相机最远的块，直到常驻块加上 needed 个新块不超过预算
+        void evictOutside(glm::ivec2 range_min, glm::ivec2 range_max, glm::vec2 center, std::size_t needed);
+    };
+
+} // namespace engine::scene
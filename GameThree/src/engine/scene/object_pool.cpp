@@ -0,0 +1,87 @@
+#include "object_pool.h"
+#include "../object/game_object.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+    ObjectPool::~ObjectPool()
+    {
+        clear();
+    }
+
+    void ObjectPool::registerType(const std::string& key, Factory factory, std::size_t prewarm_count)
+    {
+        if (!factory) {
+            spdlog::warn("ObjectPool: 类型 '{}' 的工厂函数为空，忽略注册。", key);
+            return;
+        }
+        auto& bucket = buckets_[key];
+        bucket.factory = std::move(factory);
+        bucket.idle.reserve(prewarm_count);
+        for (std::size_t i = 0; i < prewarm_count; ++i) {
+            auto game_object = create(key, bucket);
+            if (!game_object) break;
+            bucket.idle.push_back(std::move(game_object));
+        }
+        spdlog::debug("ObjectPool: 注册类型 '{}'，预创建 {} 个实例。", key, bucket.idle.size());
+    }
+
+    std::unique_ptr<engine::object::GameObject> ObjectPool::acquire(const std::string& key)
+    {
+        auto it = buckets_.find(key);
+        if (it == buckets_.end()) {
+            spdlog::warn("ObjectPool: 未注册的类型 '{}'。", key);
+            return nullptr;
+        }
+        auto& bucket = it->second;
+        if (bucket.idle.empty()) {
+            spdlog::debug("ObjectPool: 类型 '{}' 没有空闲实例，新建第 {} 个。", key, bucket.created + 1);
+            return create(key, bucket);
+        }
+        auto game_object = std::move(bucket.idle.back());
+        bucket.idle.pop_back();
+        return game_object;
+    }
+
+    void ObjectPool::release(std::unique_ptr<engine::object::GameObject>&& game_object)
+    {
+        if (!game_object) return;
+        auto it = buckets_.find(game_object->getPoolKey());
+        if (it == buckets_.end()) {
+            // 类型已被注销（例如池已清理），直接按普通对象销毁
+            game_object->clean();
+            return;
+        }
+        game_object->setNeedRemove(false);      // 重置删除标记，下次取出即可直接使用
+        it->second.idle.push_back(std::move(game_object));
+    }
+
+    void ObjectPool::clear()
+    {
+        for (auto& [key, bucket] : buckets_) {
+            for (auto& game_object : bucket.idle) {
+                if (game_object) game_object->clean();
+            }
+        }
+        buckets_.clear();
+    }
+
+    std::size_t ObjectPool::getIdleCount(const std::string& key) const
+    {
+        auto it = buckets_.find(key);
+        return it != buckets_.end() ? it->second.idle.size() : 0;
+    }
+
+    std::unique_ptr<engine::object::GameObject> ObjectPool::create(const std::string& key, Bucket& bucket)
+    {
+        auto game_object = bucket.factory();
+        if (!game_object) {
+            spdlog::error("ObjectPool: 类型 '{}' 的工厂函数返回空对象。", key);
+            return nullptr;
+        }
+        game_object->setPoolKey(key);
+        ++bucket.created;
+        return game_object;
+    }
+
+} // namespace engine::scene
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::object {
+    class GameObject;
+}
+
+namespace engine::scene {
+
+    /**
+     * @brief 游戏对象回收池，用于频繁生成、很快消失的对象（特效、子弹等）。
+     *
+     * 每种对象类型注册一个工厂函数，并可以预先创建若干实例。
+     * acquire() 取出一个空闲实例（没有空闲实例时调用工厂新建），调用方重设状态后添加到场景；
+     * 对象被标记删除后，场景不会销毁它，而是调用 release() 放回池中等待下一次使用。
+     *
+     * 池中对象保留全部组件，不会调用 clean()。因此只适合组件不向外部系统注册的对象
+     * （例如只有 Transform / Sprite / Animation 的特效），带物理组件的对象不应放入池中。
+     */
+    class ObjectPool final {
+    public:
+        /// @brief 工厂函数：创建一个完整的（已添加所有组件的）游戏对象
+        using Factory = std::function<std::unique_ptr<engine::object::GameObject>()>;
+
+    private:
+        /// @brief 一种对象类型的池
+        struct Bucket {
+            Factory factory;                                                    ///< @brief 工厂函数
+            std::vector<std::unique_ptr<engine::object::GameObject>> idle;      ///< @brief 空闲实例
+            std::size_t created = 0;                                            ///< @brief 已创建的实例总数
+        };
+        std::unordered_map<std::string, Bucket> buckets_;   ///< @brief 池键 -> 对象池
+
+    public:
+        ObjectPool() = default;
+        ~ObjectPool();
+
+        // 禁止拷贝和移动
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&&) = delete;
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        /**
+         * @brief 注册一种对象类型，并预先创建实例。
+         * @param key 池键（同时作为对象的池标识）
+         * @param factory 工厂函数
+         * @param prewarm_count 预先创建的实例数量
+         */
+        void registerType(const std::string& key, Factory factory, std::size_t prewarm_count = 0);
+
+        /// @brief 是否已注册指定类型
+        bool hasType(const std::string& key) const { return buckets_.contains(key); }
+
+        /**
+         * @brief 取出一个实例（没有空闲实例时新建）。调用方负责重设状态并添加到场景。
+         * @param key 池键
+         * @return 游戏对象，类型未注册或工厂失败时返回空指针
+         */
+        std::unique_ptr<engine::object::GameObject> acquire(const std::string& key);
+
+        /**
+         * @brief 放回一个实例（由场景在移除池对象时调用）。
+         * @param game_object 游戏对象（必须是本池创建的）
+         */
+        void release(std::unique_ptr<engine::object::GameObject>&& game_object);
+
+        /// @brief 清理并销毁所有空闲实例，注销所有类型
+        void clear();
+
+        /// @brief 获取指定类型的空闲实例数量
+        std::size_t getIdleCount(const std::string& key) const;
+
+    private:
+        std::unique_ptr<engine::object::GameObject> create(const std::string& key, Bucket& bucket);  ///< @brief 通过工厂新建实例并打上池标识
+    };
+
+} // namespace engine::scene
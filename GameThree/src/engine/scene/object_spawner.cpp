@@ -0,0 +1,111 @@
+#include "object_spawner.h"
+#include "scene.h"
+#include "../object/game_object.h"
+#include "../object/handle_table.h"
+#include "../core/context.h"
+#include "../physics/collision.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+
+    namespace {
+        /// @brief 将矩形向四周扩展 margin
+        engine::utils::Rect expandRect(const engine::utils::Rect& rect, float margin) {
+            return { rect.position - glm::vec2(margin), rect.size + glm::vec2(2.0f * margin) };
+        }
+    }
+
+    void ObjectSpawner::addRecord(const engine::utils::Rect& bounds, std::uint32_t source_index, std::uint32_t level_order, bool persistent)
+    {
+        SpawnRecord record;
+        record.bounds = bounds;
+        record.source_index = source_index;
+        record.level_order = level_order;
+        record.flags = persistent ? PERSISTENT : 0;
+        records_.push_back(record);
+        max_width_ = std::max(max_width_, bounds.size.x);
+        sorted_ = false;
+    }
+
+    void ObjectSpawner::update(Scene& scene, const engine::utils::Rect& view, float spawn_margin, float despawn_margin)
+    {
+        if (records_.empty() || !factory_) return;
+        if (!sorted_) sortRecords();
+
+        const auto& handle_table = scene.getContext().getHandleTable();
+
+        // 1. 检查已生成的对象：被销毁的记为死亡，远离的非持久对象回收
+        const bool despawn_enabled = despawn_margin >= 0.0f;
+        const auto despawn_region = expandRect(view, std::max(despawn_margin, spawn_margin));
+        for (std::size_t i = 0; i < live_records_.size();) {
+            auto& record = records_[live_records_[i]];
+            auto* game_object = handle_table.resolve(record.handle);
+            bool keep = true;
+            if (!game_object || game_object->isNeedRemove()) {
+                // 不是生成器移除的，说明被游戏逻辑销毁了（敌人被消灭、道具被拾取），之后不再生成
+                record.flags |= DEAD;
+                keep = false;
+            }
+            else if (despawn_enabled && !(record.flags & PERSISTENT) &&
+                !engine::physics::collision::checkRectOverlap(record.bounds, despawn_region)) {
+                scene.safeRemoveGameObject(game_object);
+                keep = false;
+            }
+
+            if (keep) {
+                ++i;
+            }
+            else {
+                record.handle = {};
+                live_records_[i] = live_records_.back();
+                live_records_.pop_back();
+            }
+        }
+
+        // 2. 生成进入生成范围的记录 (先二分查找 x 范围，再检查 y)
+        const auto spawn_region = expandRect(view, spawn_margin);
+        const auto left = spawn_region.position.x - max_width_;
+        const auto right = spawn_region.position.x + spawn_region.size.x;
+        auto it = std::lower_bound(records_.begin(), records_.end(), left,
+            [](const SpawnRecord& record, float x) { return record.bounds.position.x < x; });
+        for (; it != records_.end() && it->bounds.position.x < right; ++it) {
+            if (it->handle || (it->flags & DEAD)) continue;
+            if (!engine::physics::collision::checkRectOverlap(it->bounds, spawn_region)) continue;
+
+            auto game_object = factory_(it->source_index, scene);
+            if (!game_object) {
+                it->flags |= DEAD;      // 创建失败（错误已由工厂记录），不再重试
+                continue;
+            }
+            auto* ptr = game_object.get();
+            ptr->setLevelOrder(it->level_order);
+            scene.insertGameObject(std::move(game_object)); // 此时场景尚未开始遍历对象容器，可以直接插入（按关卡顺序，保持渲染顺序）
+            it->handle = ptr->getHandle();
+            live_records_.push_back(static_cast<std::uint32_t>(it - records_.begin()));
+            scene.onGameObjectSpawned(*ptr);
+        }
+    }
+
+    void ObjectSpawner::clear()
+    {
+        records_.clear();
+        live_records_.clear();
+        factory_ = nullptr;     // 释放工厂函数持有的资源（如关卡加载器）
+        max_width_ = 0.0f;
+        sorted_ = true;
+    }
+
+    void ObjectSpawner::sortRecords()
+    {
+        std::stable_sort(records_.begin(), records_.end(),
+            [](const SpawnRecord& a, const SpawnRecord& b) { return a.bounds.position.x < b.bounds.position.x; });
+        live_records_.clear();
+        for (std::size_t i = 0; i < records_.size(); ++i) {
+            if (records_[i].handle) live_records_.push_back(static_cast<std::uint32_t>(i));
+        }
+        sorted_ = true;
+        spdlog::trace("ObjectSpawner: {} 条生成记录已排序。", records_.size());
+    }
+
+} // namespace engine::scene
@@ -0,0 +1,89 @@
+#pragma once
+#include "../utils/math.h"
+#include "../object/object_handle.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine::object {
+    class GameObject;
+}
+
+namespace engine::scene {
+    class Scene;
+
+    /**
+     * @brief 对象生成器：相机接近时才创建关卡对象，远离时回收。
+     *
+     * 关卡加载时只登记紧凑的生成记录（包围盒、来源下标、标志），记录按 x 坐标排序，
+     * 每帧二分查找生成范围内的记录并通过工厂函数创建对象；超出回收范围的非持久对象被移除，之后可再次生成。
+     * 被游戏逻辑销毁的对象（被消灭的敌人、被拾取的道具）记为已死亡，不再生成。
+     */
+    class ObjectSpawner final {
+    public:
+        /// @brief 工厂函数：根据来源下标创建游戏对象（失败返回空指针）
+        using Factory = std::function<std::unique_ptr<engine::object::GameObject>(std::uint32_t source_index, Scene& scene)>;
+
+    private:
+        /// @brief 生成记录标志位
+        enum SpawnFlag : std::uint8_t {
+            PERSISTENT = 1 << 0,    ///< @brief 持久：生成后不再回收
+            DEAD = 1 << 1,          ///< @brief 已死亡：对象已被游戏逻辑销毁，不再生成
+        };
+
+        /// @brief 生成记录
+        struct SpawnRecord {
+            engine::utils::Rect bounds;             ///< @brief 生成位置的世界包围盒
+            std::uint32_t source_index = 0;         ///< @brief 来源下标（传给工厂函数）
+            std::uint32_t level_order = 0;          ///< @brief 关卡顺序（生成的对象按它插入场景，保持图层渲染顺序）
+            std::uint8_t flags = 0;                 ///< @brief SpawnFlag 组合
+            engine::object::ObjectHandle handle;    ///< @brief 已生成对象的句柄（未生成时为空）
+        };
+
+        Factory factory_;                           ///< @brief 创建对象的工厂函数
+        std::vector<SpawnRecord> records_;          ///< @brief 生成记录（按 bounds.position.x 升序）
+        std::vector<std::uint32_t> live_records_;   ///< @brief 已生成对象的记录下标
+        float max_width_ = 0.0f;                    ///< @brief 记录包围盒的最大宽度（二分查找时向左扩展，避免漏掉跨越左边界的记录）
+        bool sorted_ = true;                        ///< @brief 记录是否已排序（登记新记录后置为 false）
+
+    public:
+        ObjectSpawner() = default;
+
+        // 禁止拷贝和移动
+        ObjectSpawner(const ObjectSpawner&) = delete;
+        ObjectSpawner& operator=(const ObjectSpawner&) = delete;
+        ObjectSpawner(ObjectSpawner&&) = delete;
+        ObjectSpawner& operator=(ObjectSpawner&&) = delete;
+
+        void setFactory(Factory factory) { factory_ = std::move(factory); }    ///< @brief 设置工厂函数
+
+        /**
+         * @brief 登记一条生成记录。
+         * @param bounds 生成位置的世界包围盒
+         * @param source_index 来源下标（生成时传给工厂函数）
+         * @param level_order 对象在关卡中的顺序（见 GameObject::getLevelOrder）
+         * @param persistent 是否持久（生成后不再因远离而回收）
+         */
+        void addRecord(const engine::utils::Rect& bounds, std::uint32_t source_index, std::uint32_t level_order, bool persistent);
+
+        /**
+         * @brief 更新生成状态（每帧在对象更新之前调用一次）。
+         * @param scene 目标场景
+         * @param view 当前视口的世界矩形
+         * @param spawn_margin 生成范围：视口向四周扩展的距离
+         * @param despawn_margin 回收范围：视口向四周扩展的距离（负数表示不回收；小于生成范围时按生成范围处理）
+         */
+        void update(Scene& scene, const engine::utils::Rect& view, float spawn_margin, float despawn_margin);
+
+        void clear();   ///< @brief 清空所有记录和工厂函数（场景清理时调用）
+
+        std::size_t getRecordCount() const { return records_.size(); }     ///< @brief 获取记录数量
+        std::size_t getLiveCount() const { return live_records_.size(); }  ///< @brief 获取当前已生成的对象数量
+
+    private:
+        void sortRecords();     ///< @brief 按 x 坐标排序记录，并重建已生成记录的下标
+    };
+
+} // namespace engine::scene
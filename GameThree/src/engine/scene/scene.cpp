@@ -1,12 +1,25 @@
 #include "scene.h"
 #include "scene_manager.h"
+#include "object_pool.h"
+#include "object_spawner.h"
+#include "level_streamer.h"
 #include "../object/game_object.h"
+#include "../object/archetype_registry.h"
+#include "../object/object_arena.h"
+#include "../object/object_index.h"
+#include "../object/handle_table.h"
+#include "../component/transform_component.h"
+#include "../component/animation_component.h"
+#include "../component/sprite_component.h"
+#include "../component/collider_component.h"
+#include "../physics/collision.h"
 #include "../core/context.h"
 #include "../core/game_state.h"
 #include "../physics/physics_engine.h"
 #include "../render/camera.h"
 #include "../ui/ui_manager.h"
-#include <algorithm> // for std::remove_if
+#include <algorithm> // for std::remove_if, std::rotate
+#include <optional>
 #include <spdlog/spdlog.h>
 
 namespace engine::scene {
@@ -16,6 +29,11 @@ namespace engine::scene {
         context_(context),
         scene_manager_(scene_manager),
         ui_manager_(std::make_unique<engine::ui::UIManager>()),
+        object_arena_(std::make_unique<engine::object::ObjectArena>()),
+        archetype_registry_(std::make_unique<engine::object::ArchetypeRegistry>()),
+        object_index_(std::make_unique<engine::object::ObjectIndex>()),
+        object_pool_(std::make_unique<engine::scene::ObjectPool>()),
+        object_spawner_(std::make_unique<engine::scene::ObjectSpawner>()),
         is_initialized_(false) {
         spdlog::trace("场景 '{}' 构造完成。", scene_name_);
     }
@@ -30,26 +48,41 @@ namespace engine::scene {
     void Scene::update(float delta_time) {
         if (!is_initialized_) return;
 
+        // 先统一移除上一帧（输入、更新、碰撞处理中）标记删除的对象，避免它们再参与物理模拟。每帧只压缩一次对象容器
+        removeMarkedGameObjects();
+
+        // 生成相机接近的关卡对象，回收远离的对象
+        const auto& camera = context_.getCamera();
+        object_spawner_->update(*this, engine::utils::Rect{ camera.getPosition(), camera.getViewportSize() },
+            scene_manager_.getSpawnMargin(), scene_manager_.getDespawnMargin());
+
+        // 读入相机接近的瓦片块，回收远离的块（在物理模拟之前，保证碰撞检测用到的块已载入）
+        if (level_streamer_) {
+            level_streamer_->update(engine::utils::Rect{ camera.getPosition(), camera.getViewportSize() }, delta_time);
+        }
+
+        // 判定本帧的休眠对象（远离活动区域的对象跳过更新和物理模拟）
+        updateActivity();
+
         // 只有游戏进行中，才需要更新物理引擎和相机
         if (context_.getGameState().isPlaying()) {
-            context_.getPhysicsEngine().update(delta_time);
+            context_.getPhysicsEngine().update(delta_time, *archetype_registry_);
             context_.getCamera().update(delta_time);
         }
 
-        // 更新所有游戏对象，并删除需要移除的对象
-        for (auto it = game_objects_.begin(); it != game_objects_.end();) {
-            if (*it && !(*it)->isNeedRemove()) {    // 正常更新游戏对象
-                (*it)->update(delta_time, context_);
-                ++it;
-            }
-            else {
-                if (*it) {      // 安全删除需要移除的对象
-                    (*it)->clean();
-                }
-                it = game_objects_.erase(it);   // 删除需要移除的对象，智能指针自动管理内存
+        // 更新所有游戏对象（跳过已标记删除的对象，它们在下一帧开始时统一移除；休眠对象也跳过）
+        for (auto& game_object : game_objects_) {
+            if (game_object && !game_object->isNeedRemove() && !game_object->isDormant()) {
+                game_object->update(delta_time, context_);
             }
         }
 
+        // 批量推进所有动画：只访问含动画和精灵组件的原型，两者都在原型数组中连续存放，逐行调用
+        archetype_registry_->each<engine::component::AnimationComponent, engine::component::SpriteComponent>(
+            [delta_time](auto& animation, auto& sprite) {
+                if (!animation.getOwner()->isDormant()) animation.advance(delta_time, sprite);
+            });
+
         // 更新UI管理器
         ui_manager_->update(delta_time, context_);
 
@@ -58,9 +91,9 @@ namespace engine::scene {
 
     void Scene::render() {
         if (!is_initialized_) return;
-        // 渲染所有游戏对象
+        // 渲染所有游戏对象（已标记删除的对象不再渲染）
         for (const auto& obj : game_objects_) {
-            if (obj) obj->render(context_);
+            if (obj && !obj->isNeedRemove()) obj->render(context_);
         }
 
         // 渲染UI管理器
@@ -73,16 +106,10 @@ namespace engine::scene {
         // 处理UI管理器输入
         if (ui_manager_->handleInput(context_)) return;   // 如果输入事件被UI处理则返回，不再处理游戏对象输入
 
-        // 遍历所有游戏对象，并删除需要移除的对象
-        for (auto it = game_objects_.begin(); it != game_objects_.end();) {
-            if (*it && !(*it)->isNeedRemove()) {
-                (*it)->handleInput(context_);
-                ++it;
-            }
-            else {
-                // 安全删除需要移除的对象
-                if (*it) (*it)->clean();
-                it = game_objects_.erase(it);
+        // 遍历所有游戏对象（已标记删除的对象跳过，由 update 统一移除；休眠对象也跳过）
+        for (auto& game_object : game_objects_) {
+            if (game_object && !game_object->isNeedRemove() && !game_object->isDormant()) {
+                game_object->handleInput(context_);
             }
         }
     }
@@ -90,20 +117,60 @@ namespace engine::scene {
     void Scene::clean() {
         if (!is_initialized_) return;
 
+        level_streamer_.reset();        // 先停止流式加载（它引用瓦片图层组件）
         for (const auto& obj : game_objects_) {
             if (obj) obj->clean();
         }
+        object_spawner_->clear();       // 先释放生成记录（及其持有的关卡加载器）
         game_objects_.clear();
+        pending_additions_.clear();
+        activity_anchor_ = {};
+        object_pool_->clear();
+        archetype_registry_->clear();
+        object_index_->clear();
+        object_arena_->release();       // 所有对象都已销毁，一次性归还场景内存
 
         is_initialized_ = false;        // 清理完成后，设置场景为未初始化
         spdlog::trace("场景 '{}' 清理完成。", scene_name_);
     }
 
+    void Scene::setLevelStreamer(std::unique_ptr<engine::scene::LevelStreamer>&& level_streamer) {
+        level_streamer_ = std::move(level_streamer);
+    }
+
     void Scene::addGameObject(std::unique_ptr<engine::object::GameObject>&& game_object) {
-        if (game_object) game_objects_.push_back(std::move(game_object));
+        if (game_object) {
+            archetype_registry_->add(game_object.get());
+            object_index_->add(game_object.get());
+            context_.getHandleTable().registerObject(game_object.get());   // 发放句柄，供跨帧引用
+            game_objects_.push_back(std::move(game_object));
+        }
         else spdlog::warn("尝试向场景 '{}' 添加空游戏对象。", scene_name_);
     }
 
+    void Scene::insertGameObject(std::unique_ptr<engine::object::GameObject>&& game_object)
+    {
+        if (!game_object) {
+            spdlog::warn("尝试向场景 '{}' 添加空游戏对象。", scene_name_);
+            return;
+        }
+        // 找到插入位置：最后一个关卡顺序不大于它的对象之后；没有这样的对象时放在第一个关卡对象之前
+        const auto level_order = game_object->getLevelOrder();
+        auto last = std::find_if(game_objects_.rbegin(), game_objects_.rend(),
+            [level_order](const auto& obj) { return obj && obj->getLevelOrder() <= level_order; });
+        auto position = last != game_objects_.rend() ? last.base() :
+            std::find_if(game_objects_.begin(), game_objects_.end(),
+                [](const auto& obj) { return obj && obj->getLevelOrder() != engine::object::GameObject::NO_LEVEL_ORDER; });
+        const auto index = position - game_objects_.begin();
+
+        // 先按常规方式添加（登记索引和句柄），再把新对象从末尾移到插入位置
+        const auto size = game_objects_.size();
+        addGameObject(std::move(game_object));
+        if (game_objects_.size() > size) {
+            std::rotate(game_objects_.begin() + index, game_objects_.end() - 1, game_objects_.end());
+        }
+    }
+
     void Scene::safeAddGameObject(std::unique_ptr<engine::object::GameObject>&& game_object)
     {
         if (game_object) pending_additions_.push_back(std::move(game_object));
@@ -124,7 +191,7 @@ namespace engine::scene {
             });
 
         if (it != game_objects_.end()) {
-            (*it)->clean();             // 因为传入的是指针，因此只可能有一个元素被移除，不需要遍历it到末尾
+            retireGameObject(std::move(*it));   // 因为传入的是指针，因此只可能有一个元素被移除，不需要遍历it到末尾
             game_objects_.erase(it, game_objects_.end());   // 删除从it到末尾的元素（最后一个元素）
             spdlog::trace("从场景 '{}' 中移除游戏对象。", scene_name_);
         }
@@ -140,13 +207,87 @@ namespace engine::scene {
 
     engine::object::GameObject* Scene::findGameObjectByName(const std::string& name) const
     {
-        // 找到第一个符合条件的游戏对象就返回
-        for (const auto& obj : game_objects_) {
-            if (obj && obj->getName() == name) {
-                return obj.get();
+        // 从未驻留过的名称不可能属于任何对象，不必驻留新字符串
+        auto name_id = engine::utils::findStringId(name);
+        if (name_id == engine::utils::INVALID_STRING_ID) return nullptr;
+        return findGameObjectByName(name_id);
+    }
+
+    engine::object::GameObject* Scene::findGameObjectByName(engine::utils::StringId name_id) const
+    {
+        return object_index_->findByName(name_id);
+    }
+
+    engine::object::GameObject* Scene::findGameObjectByTag(engine::utils::StringId tag_id) const
+    {
+        return object_index_->findByTag(tag_id);
+    }
+
+    void Scene::removeMarkedGameObjects()
+    {
+        // 原地压缩：保留的对象依次前移（保持原有顺序，即渲染顺序），标记删除的对象就地回收。
+        // 整个过程 O(n)，不会因为同一帧删除多个对象而反复搬移容器元素。
+        auto write = game_objects_.begin();
+        for (auto read = game_objects_.begin(); read != game_objects_.end(); ++read) {
+            if (*read && !(*read)->isNeedRemove()) {
+                if (write != read) *write = std::move(*read);
+                ++write;
+            }
+            else {
+                retireGameObject(std::move(*read));     // 池对象放回对象池，其他对象清理后销毁
+            }
+        }
+        game_objects_.erase(write, game_objects_.end());
+    }
+
+    void Scene::updateActivity()
+    {
+        auto margin = scene_manager_.getActivityMargin();
+        if (margin < 0.0f) {        // 禁用休眠：唤醒所有对象
+            for (auto& game_object : game_objects_) {
+                if (game_object) game_object->setDormant(false);
+            }
+            return;
+        }
+
+        // 活动区域：相机视口向四周扩展 margin
+        const auto& camera = context_.getCamera();
+        const auto viewport_size = camera.getViewportSize();
+        const auto region_size = viewport_size + glm::vec2(2.0f * margin);
+        const engine::utils::Rect camera_region{ camera.getPosition() - glm::vec2(margin), region_size };
+        // 额外的活动区域：以活动中心对象为中心、与相机区域同样大小
+        std::optional<engine::utils::Rect> anchor_region;
+        if (auto* anchor = context_.getHandleTable().resolve(activity_anchor_); anchor) {
+            if (auto* anchor_transform = anchor->getComponent<engine::component::TransformComponent>(); anchor_transform) {
+                anchor_region = engine::utils::Rect{ anchor_transform->getPosition() - region_size / 2.0f, region_size };
             }
         }
-        return nullptr;
+
+        // 按原型遍历变换组件（连续存放）；没有变换组件的对象（如瓦片图层）没有位置，不会被访问，始终活跃
+        archetype_registry_->each<engine::component::TransformComponent>([&](engine::component::TransformComponent& transform) {
+            auto* game_object = transform.getOwner();
+            if (!game_object || game_object->isAlwaysActive()) return;
+            // 有碰撞器时使用包围盒，否则使用对象位置
+            auto* collider = game_object->getComponent<engine::component::ColliderComponent>();
+            auto bounds = collider ? collider->getWorldAABB() : engine::utils::Rect{ transform.getPosition(), glm::vec2(0.0f) };
+            bool active = engine::physics::collision::checkRectOverlap(bounds, camera_region) ||
+                (anchor_region && engine::physics::collision::checkRectOverlap(bounds, *anchor_region));
+            game_object->setDormant(!active);
+        });
+    }
+
+    void Scene::retireGameObject(std::unique_ptr<engine::object::GameObject>&& game_object)
+    {
+        if (!game_object) return;
+        if (game_object->isPooled()) {
+            archetype_registry_->remove(game_object.get());     // 空闲的池对象不参与遍历，也不能被查找到
+            object_index_->remove(game_object.get());
+            context_.getHandleTable().unregisterObject(game_object.get());  // 旧句柄失效，再次取出时发放新句柄
+            object_pool_->release(std::move(game_object));
+            return;
+        }
+        game_object->clean();
+        game_object.reset();
     }
 
     void Scene::processPendingAdditions()
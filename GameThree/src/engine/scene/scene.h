@@ -2,6 +2,8 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include "../utils/string_id.h"
+#include "../object/object_handle.h"
 
 namespace engine::core {
     class Context;
@@ -11,12 +13,22 @@ namespace engine::ui {
     class UIManager;
 }
 
+namespace engine::resource {
+    class ResourceManifest;
+}
+
 namespace engine::object {
     class GameObject;
+    class ArchetypeRegistry;
+    class ObjectArena;
+    class ObjectIndex;
 }
 
 namespace engine::scene {
     class SceneManager;
+    class ObjectPool;
+    class ObjectSpawner;
+    class LevelStreamer;
 
     /**
      * @brief 场景基类，负责管理场景中的游戏对象和场景生命周期。
@@ -31,6 +43,14 @@ namespace engine::scene {
         engine::scene::SceneManager& scene_manager_;        ///< @brief 场景管理器引用（构造时传入）
         std::unique_ptr<engine::ui::UIManager> ui_manager_; ///< @brief UI管理器(初始化时自动创建)
 
+        std::unique_ptr<engine::object::ObjectArena> object_arena_;             ///< @brief 场景内存池，游戏对象和组件从这里分配（需声明在对象容器之前，保证最后析构）
+        std::unique_ptr<engine::object::ArchetypeRegistry> archetype_registry_; ///< @brief 原型注册表，按组件组合批量遍历对象（需声明在对象容器之前，保证最后析构）
+        std::unique_ptr<engine::object::ObjectIndex> object_index_;             ///< @brief 名称/标签索引
+        std::unique_ptr<engine::scene::ObjectPool> object_pool_;               ///< @brief 对象回收池（池对象被移除时放回这里而不是销毁）
+        std::unique_ptr<engine::scene::ObjectSpawner> object_spawner_;         ///< @brief 对象生成器（相机接近时创建关卡对象）
+        std::unique_ptr<engine::scene::LevelStreamer> level_streamer_;         ///< @brief 关卡流式加载器（相机接近时读入瓦片块，不需要流式加载时为空）
+        engine::object::ObjectHandle activity_anchor_;                          ///< @brief 活动区域的额外中心对象（如玩家），空句柄表示只以相机视口为活动区域
+
         bool is_initialized_ = false;                       ///< @brief 场景是否已初始化(非当前场景很可能未被删除，因此需要初始化标志避免重复初始化)
         std::vector<std::unique_ptr<engine::object::GameObject>> game_objects_;         ///< @brief 场景中的游戏对象
         std::vector<std::unique_ptr<engine::object::GameObject>> pending_additions_;    ///< @brief 待添加的游戏对象（延时添加）
@@ -61,9 +81,23 @@ namespace engine::scene {
         virtual void handleInput();                 ///< @brief 处理输入。
         virtual void clean();                       ///< @brief 清理场景。
 
+        /**
+         * @brief 声明场景用到的资源（纹理、音效、音乐、字体）。
+         * @details SceneManager 在 init 之前调用并预加载整个清单，场景激活后不应再有首次加载。
+         *          关卡中的资源由 LevelLoader 在构建关卡时按关卡清单预加载，这里只需列出场景自身的资源。
+         */
+        virtual void collectResources(engine::resource::ResourceManifest& /* manifest */) const {}
+
         /// @brief 直接向场景中添加一个游戏对象。（初始化时可用，游戏进行中不安全） （&&表示右值引用，与std::move搭配使用，避免拷贝）
         virtual void addGameObject(std::unique_ptr<engine::object::GameObject>&& game_object);
 
+        /**
+         * @brief 按关卡顺序向场景中插入一个游戏对象（对象生成器使用，与 addGameObject 一样只能在遍历对象之外调用）。
+         * @details 插在最后一个关卡顺序不大于它的对象之后，使按需生成的对象保持在关卡中的图层位置渲染，
+         *          而不是盖在之后的图层（如前景瓦片图层）之上。
+         */
+        void insertGameObject(std::unique_ptr<engine::object::GameObject>&& game_object);
+
         /// @brief 安全地添加游戏对象。（添加到pending_additions_中）
         virtual void safeAddGameObject(std::unique_ptr<engine::object::GameObject>&& game_object);
 
@@ -73,24 +107,50 @@ namespace engine::scene {
         /// @brief 安全地移除游戏对象。（设置need_remove_标记）
         virtual void safeRemoveGameObject(engine::object::GameObject* game_object_ptr);
 
+        /// @brief 由对象生成器创建的对象加入场景后调用。派生类可以在这里补充游戏逻辑（如添加AI组件）。
+        virtual void onGameObjectSpawned(engine::object::GameObject& /* game_object */) {}
+
         /// @brief 获取场景中的游戏对象容器。
         const std::vector<std::unique_ptr<engine::object::GameObject>>& getGameObjects() const { return game_objects_; }
 
-        /// @brief 根据名称查找游戏对象（返回找到的第一个对象）。
+        /// @brief 根据名称查找游戏对象（通过名称索引，返回找到的任意一个对象）。
         engine::object::GameObject* findGameObjectByName(const std::string& name) const;
+        /// @brief 根据名称ID查找游戏对象（通过名称索引，返回找到的任意一个对象）。
+        engine::object::GameObject* findGameObjectByName(engine::utils::StringId name_id) const;
+        /// @brief 根据标签ID查找游戏对象（通过标签索引，返回找到的任意一个对象）。
+        engine::object::GameObject* findGameObjectByTag(engine::utils::StringId tag_id) const;
 
         // getters and setters
         void setName(const std::string& name) { scene_name_ = name; }               ///< @brief 设置场景名称
         const std::string& getName() const { return scene_name_; }                  ///< @brief 获取场景名称
         void setInitialized(bool initialized) { is_initialized_ = initialized; }    ///< @brief 设置场景是否已初始化
         bool isInitialized() const { return is_initialized_; }                      ///< @brief 获取场景是否已初始化
+        void setActivityAnchor(engine::object::ObjectHandle anchor) { activity_anchor_ = anchor; }  ///< @brief 设置活动区域的额外中心对象
+        engine::object::ObjectHandle getActivityAnchor() const { return activity_anchor_; }         ///< @brief 获取活动区域的额外中心对象
+        /// @brief 设置关卡流式加载器（由 LevelLoader 在构建流式加载的关卡时设置）
+        void setLevelStreamer(std::unique_ptr<engine::scene::LevelStreamer>&& level_streamer);
+        engine::scene::LevelStreamer* getLevelStreamer() const { return level_streamer_.get(); }    ///< @brief 获取关卡流式加载器（可能为空）
 
         engine::core::Context& getContext() const { return context_; }                  ///< @brief 获取上下文引用
         engine::scene::SceneManager& getSceneManager() const { return scene_manager_; } ///< @brief 获取场景管理器引用
         std::vector<std::unique_ptr<engine::object::GameObject>>& getGameObjects() { return game_objects_; } ///< @brief 获取场景中的游戏对象
+        engine::object::ObjectArena& getObjectArena() const { return *object_arena_; }                     ///< @brief 获取场景内存池
+        engine::object::ObjectIndex& getObjectIndex() const { return *object_index_; }                     ///< @brief 获取名称/标签索引
+        engine::scene::ObjectPool& getObjectPool() const { return *object_pool_; }                         ///< @brief 获取对象回收池
+        engine::scene::ObjectSpawner& getObjectSpawner() const { return *object_spawner_; }                ///< @brief 获取对象生成器
+        engine::object::ArchetypeRegistry& getArchetypeRegistry() const { return *archetype_registry_; }   ///< @brief 获取原型注册表（用于 each<组件...>() 批量遍历）
 
     protected:
         void processPendingAdditions();     ///< @brief 处理待添加的游戏对象。（每轮更新的最后调用）
+        void removeMarkedGameObjects();     ///< @brief 一次性移除所有标记删除的游戏对象（保持剩余对象顺序，每帧在更新开始时调用一次）
+        /**
+         * @brief 更新所有游戏对象的休眠状态（每帧在物理模拟之前调用一次）。
+         * @details 活动区域为相机视口（以及活动中心对象周围同样大小的区域）向四周扩展 activity margin 后的矩形。
+         *          有变换组件、且包围盒完全位于活动区域之外的对象进入休眠；回到区域内时恢复，状态保持不变。
+         */
+        void updateActivity();
+        /// @brief 回收一个已从容器中取出的游戏对象：池对象放回对象池，其他对象清理后销毁
+        void retireGameObject(std::unique_ptr<engine::object::GameObject>&& game_object);
     };
 
 } // namespace engine::scene
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "scene_manager.h"
 #include "scene.h"
 #include "../core/context.h"
+#include "../object/object_arena.h"
+#include "../resource/resource_manager.h"
+#include "../resource/resource_manifest.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::scene {
@@ -26,6 +29,7 @@ namespace engine::scene {
         // 只更新栈顶（当前）场景
         Scene* current_scene = getCurrentScene();
         if (current_scene) {
+            engine::object::ObjectArena::Scope arena_scope(&current_scene->getObjectArena());  // 新建的游戏对象从场景内存池分配
             current_scene->update(delta_time);
         }
         // 执行可能的切换场景操作
@@ -45,6 +49,7 @@ namespace engine::scene {
         // 只考虑栈顶场景
         Scene* current_scene = getCurrentScene();
         if (current_scene) {
+            engine::object::ObjectArena::Scope arena_scope(&current_scene->getObjectArena());
             current_scene->handleInput();
         }
     }
@@ -86,6 +91,10 @@ namespace engine::scene {
             return;
         }
 
+        // 切换期间的加载属于准备工作；切换完成后监视新的栈顶场景（诊断模式下报告激活后加载）
+        auto& resource_manager = context_.getResourceManager();
+        resource_manager.stopWatchingLateLoads();
+
         switch (pending_action_) {
         case PendingAction::Pop:
             popScene();
@@ -101,6 +110,9 @@ namespace engine::scene {
         }
 
         pending_action_ = PendingAction::None;
+        if (Scene* current_scene = getCurrentScene(); current_scene) {
+            resource_manager.watchLateLoads(current_scene->getName());
+        }
     }
 
     void SceneManager::pushScene(std::unique_ptr<Scene>&& scene) {
@@ -110,10 +122,8 @@ namespace engine::scene {
         }
         spdlog::debug("正在将场景 '{}' 压入栈。", scene->getName());
 
-        // 初始化新场景
-        if (!scene->isInitialized()) { // 确保只初始化一次
-            scene->init();
-        }
+        // 预加载资源并初始化新场景
+        prepareScene(*scene);
 
         // 将新场景移入栈顶
         scene_stack_.push_back(std::move(scene));
@@ -148,13 +158,23 @@ namespace engine::scene {
             scene_stack_.pop_back();
         }
 
-        // 初始化新场景
-        if (!scene->isInitialized()) {
-            scene->init();
-        }
+        // 预加载资源并初始化新场景
+        prepareScene(*scene);
 
         // 将新场景压入栈顶
         scene_stack_.push_back(std::move(scene));
     }
 
+    void SceneManager::prepareScene(Scene& scene) {
+        if (scene.isInitialized()) return;      // 确保只初始化一次
+
+        // 先载入场景声明的全部资源，激活后的首次绘制/播放不再触发磁盘加载
+        engine::resource::ResourceManifest manifest;
+        scene.collectResources(manifest);
+        context_.getResourceManager().preload(manifest);
+
+        engine::object::ObjectArena::Scope arena_scope(&scene.getObjectArena());  // 关卡加载创建的对象从场景内存池分配
+        scene.init();
+    }
+
 } // namespace engine::scene
\ No newline at end of file
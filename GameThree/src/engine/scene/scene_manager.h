@@ -2,6 +2,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "level_streamer.h"
 
 // 前置声明
 namespace engine::core {
@@ -24,6 +25,10 @@ namespace engine::scene {
         enum class PendingAction { None, Push, Pop, Replace };  ///< @brief 待处理的动作
         PendingAction pending_action_ = PendingAction::None;    ///< @brief 待处理的动作
         std::unique_ptr<Scene> pending_scene_;                  ///< @brief 待处理场景
+        float activity_margin_ = 320.0f;                        ///< @brief 场景活动区域在视口四周扩展的距离（像素），负数表示禁用休眠
+        float spawn_margin_ = 160.0f;                           ///< @brief 对象生成范围在视口四周扩展的距离（像素）
+        float despawn_margin_ = 480.0f;                         ///< @brief 对象回收范围在视口四周扩展的距离（像素），负数表示不回收
+        LevelStreamingSettings level_streaming_settings_;       ///< @brief 关卡流式加载设置
 
     public:
         explicit SceneManager(engine::core::Context& context);
@@ -43,6 +48,16 @@ namespace engine::scene {
         // getters
         Scene* getCurrentScene() const;                                 ///< @brief 获取当前活动场景（栈顶场景）的指针。
         engine::core::Context& getContext() const { return context_; }  ///< @brief 获取引擎上下文引用。
+        float getActivityMargin() const { return activity_margin_; }    ///< @brief 获取活动区域扩展距离。
+        float getSpawnMargin() const { return spawn_margin_; }          ///< @brief 获取对象生成范围扩展距离。
+        float getDespawnMargin() const { return despawn_margin_; }      ///< @brief 获取对象回收范围扩展距离。
+        const LevelStreamingSettings& getLevelStreamingSettings() const { return level_streaming_settings_; }  ///< @brief 获取关卡流式加载设置。
+
+        // setters
+        void setActivityMargin(float margin) { activity_margin_ = margin; } ///< @brief 设置活动区域扩展距离（负数表示禁用休眠）。
+        void setSpawnMargin(float margin) { spawn_margin_ = margin; }       ///< @brief 设置对象生成范围扩展距离。
+        void setDespawnMargin(float margin) { despawn_margin_ = margin; }   ///< @brief 设置对象回收范围扩展距离（负数表示不回收）。
+        void setLevelStreamingSettings(const LevelStreamingSettings& settings) { level_streaming_settings_ = settings; }   ///< @brief 设置关卡流式加载设置。
 
         // 核心循环函数
         void update(float delta_time);
@@ -56,6 +71,7 @@ namespace engine::scene {
         void pushScene(std::unique_ptr<Scene>&& scene);         ///< @brief 将一个新场景压入栈顶，使其成为活动场景。
         void popScene();                                        ///< @brief 移除栈顶场景。
         void replaceScene(std::unique_ptr<Scene>&& scene);      ///< @brief 清理场景栈所有场景，将此场景设为栈顶场景。
+        void prepareScene(Scene& scene);                        ///< @brief 预加载场景的资源清单并初始化场景（尚未初始化时）。
 
     };
 
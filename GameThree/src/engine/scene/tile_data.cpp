@@ -0,0 +1,261 @@
+#include "tile_data.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+// 压缩格式依赖可选的第三方库，由项目定义 G3_WITH_ZLIB / G3_WITH_ZSTD 启用，未启用时对应格式的图层报告错误
+// （未压缩和 base64 格式不受影响）。定义与链接库必须同时设置：构建时传入 /p:G3WithZlib=true 或 /p:G3WithZstd=true，
+// GameThree.vcxproj 会一并加入定义和 zlib.lib / zstd.lib（头文件和库需在包含目录和库目录中）
+#ifdef G3_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef G3_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace engine::scene::tile_data {
+
+    namespace {
+        /**
+         * @brief 流式解析状态：记录当前是否位于瓦片图层（或块）的 "data" 数组中，并收集其中的 gid。
+         * @details nlohmann::json 的解析回调按文档顺序触发：键 -> 值（或 数组开始 ... 数组结束）。
+         *          只拦截 根对象.layers[i].data 和 根对象.layers[i].chunks[j].data，其他位置的 "data"
+         *          （如自定义属性中的同名成员）按普通 json 保留。回调的 depth 对容器开始事件为其外层深度，
+         *          因此某一深度的键只可能属于同一层的对象：根对象的键为1，图层对象的键为3，块对象的键为5。
+         */
+        class DataArrayCollector final {
+            enum class Key { Other, Layers, Chunks, Data };
+
+            static constexpr int ROOT_KEY_DEPTH = 1;    ///< @brief 根对象的键（layers 数组开始于此深度）
+            static constexpr int LAYER_KEY_DEPTH = 3;   ///< @brief 图层对象的键（data、chunks 数组开始于此深度）
+            static constexpr int CHUNK_KEY_DEPTH = 5;   ///< @brief 块对象的键（块的 data 数组开始于此深度）
+
+            std::vector<std::uint8_t> bytes_;       ///< @brief 当前数组的 gid（u32，本机字节序）
+            std::size_t capacity_hint_ = 0;         ///< @brief 上一个数组的大小（同一地图的图层通常一样大，用于预分配）
+            int array_depth_ = -1;                  ///< @brief 当前 data 数组的深度（-1 表示不在 data 数组中）
+            Key last_key_ = Key::Other;             ///< @brief 上一个事件为键时的键名（其他事件后重置）
+            bool in_layers_ = false;                ///< @brief 是否位于根对象的 layers 数组中
+            bool in_chunks_ = false;                ///< @brief 是否位于图层的 chunks 数组中
+            bool invalid_ = false;                  ///< @brief 当前数组中是否出现了非 gid 的值
+
+        public:
+            bool operator()(int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed) {
+                using event_t = nlohmann::json::parse_event_t;
+                const Key last_key = std::exchange(last_key_, Key::Other);
+
+                if (array_depth_ < 0) {
+                    if (event == event_t::key) {
+                        const auto& name = parsed.get_ref<const std::string&>();
+                        if (name == "data") last_key_ = Key::Data;
+                        else if (name == "layers") last_key_ = Key::Layers;
+                        else if (name == "chunks") last_key_ = Key::Chunks;
+                    }
+                    else if (event == event_t::array_start) {
+                        if (last_key == Key::Layers && depth == ROOT_KEY_DEPTH) {
+                            in_layers_ = true;
+                        }
+                        else if (last_key == Key::Chunks && depth == LAYER_KEY_DEPTH && in_layers_) {
+                            in_chunks_ = true;
+                        }
+                        else if (last_key == Key::Data && ((depth == LAYER_KEY_DEPTH && in_layers_) ||
+                                                           (depth == CHUNK_KEY_DEPTH && in_chunks_))) {
+                            array_depth_ = depth;
+                            invalid_ = false;
+                            bytes_.clear();
+                            bytes_.reserve(capacity_hint_);
+                        }
+                    }
+                    else if (event == event_t::array_end) {
+                        // layers / chunks 内部的数组都更深，因此在该深度结束的数组即为 layers / chunks 本身
+                        if (depth == ROOT_KEY_DEPTH) in_layers_ = false;
+                        else if (depth == LAYER_KEY_DEPTH) in_chunks_ = false;
+                    }
+                    return true;
+                }
+
+                // --- 位于 data 数组中 ---
+                if (event == event_t::array_end && depth == array_depth_) {
+                    array_depth_ = -1;
+                    if (invalid_) {
+                        spdlog::error("瓦片图层 data 数组中包含非 gid 的值。");
+                        parsed = nlohmann::json::array();
+                        return true;
+                    }
+                    capacity_hint_ = bytes_.size();
+                    parsed = nlohmann::json::binary(std::move(bytes_));     // 整个数组替换为一个二进制节点
+                    bytes_ = {};
+                    return true;
+                }
+                if (event == event_t::value && depth == array_depth_ + 1) {
+                    std::uint32_t gid = 0;
+                    if (parsed.is_number_unsigned()) gid = static_cast<std::uint32_t>(parsed.get<std::uint64_t>());
+                    else if (parsed.is_number_integer()) gid = static_cast<std::uint32_t>(parsed.get<std::int64_t>());
+                    else invalid_ = true;
+                    const auto* gid_bytes = reinterpret_cast<const std::uint8_t*>(&gid);
+                    bytes_.insert(bytes_.end(), gid_bytes, gid_bytes + sizeof(gid));
+                    return false;       // 不保留 json 节点
+                }
+                // 嵌套的对象或数组不是 Tiled 的 gid 数据
+                if (event == event_t::object_start || event == event_t::array_start) invalid_ = true;
+                return false;
+            }
+        };
+
+        /// @brief base64 字符 -> 6位值（无效字符为 0xFF）
+        constexpr std::array<std::uint8_t, 256> makeBase64Table() {
+            std::array<std::uint8_t, 256> table{};
+            table.fill(0xFF);
+            constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (std::size_t i = 0; i < alphabet.size(); ++i) {
+                table[static_cast<std::uint8_t>(alphabet[i])] = static_cast<std::uint8_t>(i);
+            }
+            return table;
+        }
+
+        /**
+         * @brief 解码 base64 文本（忽略空白，遇到 '=' 结束）。
+         * @param text base64 文本
+         * @param output 输出缓冲区
+         * @param capacity 输出缓冲区容量
+         * @return 解码出的字节数（超出容量的部分被丢弃），包含无效字符时返回 std::nullopt
+         */
+        std::optional<std::size_t> decodeBase64(std::string_view text, std::uint8_t* output, std::size_t capacity) {
+            static constexpr auto table = makeBase64Table();
+            std::uint32_t accumulator = 0;
+            int bits = 0;
+            std::size_t size = 0;
+            for (char c : text) {
+                if (c == '=') break;
+                if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+                auto value = table[static_cast<std::uint8_t>(c)];
+                if (value == 0xFF) return std::nullopt;
+                accumulator = (accumulator << 6) | value;
+                bits += 6;
+                if (bits >= 8) {
+                    bits -= 8;
+                    if (size < capacity) output[size] = static_cast<std::uint8_t>(accumulator >> bits);
+                    ++size;
+                }
+            }
+            return std::min(size, capacity);
+        }
+
+        /// @brief 解压数据到 output（容量为 capacity），返回解压出的字节数，失败返回 std::nullopt
+        std::optional<std::size_t> decompress(const std::string& compression, const std::vector<std::uint8_t>& input,
+            std::uint8_t* output, std::size_t capacity) {
+            if (compression == "zlib" || compression == "gzip") {
+#ifdef G3_WITH_ZLIB
+                z_stream stream{};
+                if (inflateInit2(&stream, 15 + 32) != Z_OK) return std::nullopt;   // 15 + 32：自动识别 zlib 和 gzip 头
+                stream.next_in = const_cast<Bytef*>(input.data());
+                stream.avail_in = static_cast<uInt>(input.size());
+                stream.next_out = output;
+                stream.avail_out = static_cast<uInt>(capacity);
+                auto result = inflate(&stream, Z_FINISH);
+                auto size = static_cast<std::size_t>(stream.total_out);
+                inflateEnd(&stream);
+                // 输出缓冲区已满（数据多于瓦片数量）时按截断处理
+                if (result != Z_STREAM_END && !(result == Z_BUF_ERROR && size == capacity)) return std::nullopt;
+                return size;
+#else
+                spdlog::error("未启用 zlib，无法解压 '{}' 压缩的瓦片图层。", compression);
+                return std::nullopt;
+#endif
+            }
+            if (compression == "zstd") {
+#ifdef G3_WITH_ZSTD
+                auto size = ZSTD_decompress(output, capacity, input.data(), input.size());
+                if (ZSTD_isError(size)) return std::nullopt;
+                return size;
+#else
+                spdlog::error("未启用 zstd，无法解压 zstd 压缩的瓦片图层。");
+                return std::nullopt;
+#endif
+            }
+            spdlog::error("不支持的瓦片图层压缩格式: {}", compression);
+            return std::nullopt;
+        }
+    }
+
+    nlohmann::json parseMap(const std::uint8_t* data, std::size_t size)
+    {
+        DataArrayCollector collector;
+        return nlohmann::json::parse(data, data + size, std::ref(collector));
+    }
+
+    bool decodeLayerData(const nlohmann::json& layer_json, std::size_t tile_count, std::vector<std::uint32_t>& gids)
+    {
+        return decodeChunkData(layer_json, layer_json, tile_count, gids);
+    }
+
+    bool decodeChunkData(const nlohmann::json& chunk_json, const nlohmann::json& layer_json, std::size_t tile_count,
+        std::vector<std::uint32_t>& gids)
+    {
+        const auto layer_name = layer_json.value("name", "Unnamed");
+        gids.assign(tile_count, 0);
+        if (!chunk_json.contains("data")) {
+            spdlog::error("图层 '{}' 缺少 'data' 属性。", layer_name);
+            return false;
+        }
+        const auto& data = chunk_json["data"];
+        std::size_t count = 0;      // 数据中的 gid 数量
+
+        if (data.is_binary()) {             // 1. 流式解析得到的 gid 缓冲区（本机字节序）
+            const auto& bytes = data.get_binary();
+            count = bytes.size() / sizeof(std::uint32_t);
+            std::memcpy(gids.data(), bytes.data(), std::min(count, tile_count) * sizeof(std::uint32_t));
+        }
+        else if (data.is_array()) {         // 2. 普通 json 数组（如未经 parseMap 解析的地图）
+            count = data.size();
+            for (std::size_t i = 0; i < std::min(count, tile_count); ++i) {
+                gids[i] = data[i].get<std::uint32_t>();
+            }
+        }
+        else if (data.is_string() && layer_json.value("encoding", std::string()) == "base64") {
+            // 3. base64（小端序 u32），未压缩时直接解码到 gid 缓冲区
+            const auto& text = data.get_ref<const std::string&>();
+            auto* output = reinterpret_cast<std::uint8_t*>(gids.data());
+            const auto capacity = tile_count * sizeof(std::uint32_t);
+            const auto compression = layer_json.value("compression", std::string());
+            std::optional<std::size_t> size;
+            if (compression.empty()) {
+                size = decodeBase64(text, output, capacity);
+            }
+            else {
+                std::vector<std::uint8_t> compressed(text.size() / 4 * 3 + 3);
+                if (auto compressed_size = decodeBase64(text, compressed.data(), compressed.size()); compressed_size) {
+                    compressed.resize(*compressed_size);
+                    size = decompress(compression, compressed, output, capacity);
+                }
+            }
+            if (!size) {
+                spdlog::error("图层 '{}' 的瓦片数据解码失败。", layer_name);
+                gids.assign(tile_count, 0);
+                return false;
+            }
+            count = *size / sizeof(std::uint32_t);
+            if constexpr (std::endian::native == std::endian::big) {
+                for (auto& gid : gids) {
+                    gid = (gid >> 24) | ((gid >> 8) & 0xFF00u) | ((gid << 8) & 0xFF0000u) | (gid << 24);
+                }
+            }
+        }
+        else {
+            spdlog::error("图层 '{}' 的 'data' 格式无效。", layer_name);
+            return false;
+        }
+
+        if (count != tile_count) {
+            spdlog::warn("图层 '{}' 的瓦片数量 ({}) 与地图或块尺寸 ({}) 不一致。", layer_name, count, tile_count);
+        }
+        return true;
+    }
+
+} // namespace engine::scene::tile_data
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+/**
+ * @brief Tiled 地图瓦片数据的流式解析与解码。
+ *
+ * 大地图的瓦片图层 data 数组有数百万个 gid，完整解析为 json DOM 时每个 gid 都是一个 json 节点。
+ * parseMap 使用解析回调在解析过程中把 data 数组中的整数直接写入 gid 缓冲区，
+ * 数组在 DOM 中替换为一个二进制节点（按本机字节序存放的 u32 gid），不为单个 gid 创建节点。
+ * decodeLayerData 统一解码三种 data 格式：流式解析的二进制节点、普通 json 数组、
+ * base64 字符串（可选 zlib/gzip/zstd 压缩，与 Tiled 的图层格式选项一致）。
+ */
+namespace engine::scene::tile_data {
+
+    /**
+     * @brief 解析地图 json，瓦片图层的 data 数组直接写入 gid 缓冲区。
+     * @param data json 文本
+     * @param size json 文本长度
+     * @return 地图json数据
+     * @throws nlohmann::json::parse_error 解析失败时抛出（与 json::parse 一致）
+     */
+    nlohmann::json parseMap(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * @brief 将瓦片图层的 data 解码到 gid 缓冲区。
+     * @details 缓冲区按瓦片数量预先分配；数据少于瓦片数量时剩余部分为0（空瓦片），多出的部分被忽略。
+     * @param layer_json 瓦片图层json（包含 data，以及可选的 encoding、compression）
+     * @param tile_count 图层的瓦片数量（地图宽度 * 地图高度）
+     * @param gids 输出：gid 缓冲区，长度为 tile_count
+     * @return bool 是否解码成功（失败时已输出错误日志）
+     */
+    bool decodeLayerData(const nlohmann::json& layer_json, std::size_t tile_count, std::vector<std::uint32_t>& gids);
+
+    /**
+     * @brief 将无限地图中一个块的 data 解码到 gid 缓冲区（编码和压缩方式由所属图层决定）。
+     * @param chunk_json 块json（包含 data）
+     * @param layer_json 所属瓦片图层json（提供 encoding、compression 和图层名称）
+     * @param tile_count 块的瓦片数量（块宽度 * 块高度）
+     * @param gids 输出：gid 缓冲区，长度为 tile_count
+     * @return bool 是否解码成功（失败时已输出错误日志）
+     */
+    bool decodeChunkData(const nlohmann::json& chunk_json, const nlohmann::json& layer_json, std::size_t tile_count,
+        std::vector<std::uint32_t>& gids);
+
+} // namespace engine::scene::tile_data
@@ -0,0 +1,52 @@
+#include "tileset_cache.h"
+#include <string>
+#include <system_error>
+
+namespace engine::scene {
+
+    TilesetCache& TilesetCache::getInstance()
+    {
+        static TilesetCache instance;
+        return instance;
+    }
+
+    std::optional<std::filesystem::file_time_type> TilesetCache::getWriteTime(const std::string& tileset_path)
+    {
+        std::error_code error;
+        auto write_time = std::filesystem::last_write_time(tileset_path, error);
+        if (error) return std::nullopt;
+        return write_time;
+    }
+
+    std::shared_ptr<const TilesetData> TilesetCache::find(const std::string& tileset_path, glm::ivec2 tile_size,
+        std::filesystem::file_time_type write_time)
+    {
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(makeKey(tileset_path, tile_size));
+        if (it == entries_.end()) return nullptr;
+        if (it->second.write_time != write_time) {     // 文件已修改，丢弃旧缓存
+            entries_.erase(it);
+            return nullptr;
+        }
+        return it->second.data;
+    }
+
+    void TilesetCache::insert(const std::string& tileset_path, glm::ivec2 tile_size,
+        std::filesystem::file_time_type write_time, std::shared_ptr<const TilesetData> data)
+    {
+        std::lock_guard lock(mutex_);
+        entries_[makeKey(tileset_path, tile_size)] = Entry{ write_time, std::move(data) };
+    }
+
+    void TilesetCache::clear()
+    {
+        std::lock_guard lock(mutex_);
+        entries_.clear();
+    }
+
+    std::string TilesetCache::makeKey(const std::string& tileset_path, glm::ivec2 tile_size)
+    {
+        return tileset_path + "|" + std::to_string(tile_size.x) + "x" + std::to_string(tile_size.y);
+    }
+
+} // namespace engine::scene
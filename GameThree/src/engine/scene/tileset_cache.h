@@ -0,0 +1,85 @@
+#pragma once
+#include "../component/tilelayer_component.h"
+#include <filesystem>
+#include <glm/vec2.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace engine::scene {
+
+    /**
+     * @brief 解析并预处理好的图块集（不可变，多个关卡加载器共享）。
+     */
+    struct TilesetData {
+        /// @brief 按局部id索引的瓦片
+        struct Tile {
+            engine::component::TileInfo tile_info;          ///< @brief 瓦片信息（纹理路径已解析、源矩形、类型、高度表）
+            const nlohmann::json* tile_json = nullptr;      ///< @brief 瓦片json（指向 json 中的数据，没有条目时为空）
+            bool valid = false;                             ///< @brief 该局部id是否存在
+        };
+
+        nlohmann::json json;        ///< @brief 图块集json数据（含 file_path 字段）
+        std::vector<Tile> tiles;    ///< @brief 局部id -> 瓦片
+    };
+
+    /**
+     * @brief 进程级图块集缓存：按规范路径、修改时间和地图瓦片尺寸缓存预处理好的图块集。
+     *
+     * 各关卡通常引用相同的图块集，切换关卡时只需解析地图文件本身。
+     * 文件被修改后（修改时间改变）旧的缓存项失效，下次加载时重新解析。
+     * 瓦片的源矩形和高度表依赖地图的瓦片尺寸，因此瓦片尺寸也是键的一部分。
+     * 所有方法都是线程安全的（后台加载线程和主线程都可能访问）。
+     */
+    class TilesetCache final {
+        /// @brief 缓存项
+        struct Entry {
+            std::filesystem::file_time_type write_time;     ///< @brief 缓存时文件的修改时间
+            std::shared_ptr<const TilesetData> data;        ///< @brief 预处理好的图块集
+        };
+
+        std::mutex mutex_;                                  ///< @brief 保护 entries_
+        std::map<std::string, Entry> entries_;              ///< @brief "路径|瓦片宽x瓦片高" -> 缓存项
+
+    public:
+        static TilesetCache& getInstance();     ///< @brief 获取进程级缓存实例
+
+        /// @brief 获取文件的修改时间，文件不存在时返回 std::nullopt
+        static std::optional<std::filesystem::file_time_type> getWriteTime(const std::string& tileset_path);
+
+        /**
+         * @brief 查找缓存的图块集。
+         * @param tileset_path 图块集文件的规范路径
+         * @param tile_size 地图瓦片尺寸
+         * @param write_time 文件当前的修改时间
+         * @return 缓存的图块集，未缓存或文件已修改时返回空指针
+         */
+        std::shared_ptr<const TilesetData> find(const std::string& tileset_path, glm::ivec2 tile_size,
+            std::filesystem::file_time_type write_time);
+
+        /**
+         * @brief 缓存图块集（覆盖同一键的旧缓存项）。
+         * @param write_time 解析前读取的修改时间（解析期间文件被修改时，下次查找会视为过期）
+         */
+        void insert(const std::string& tileset_path, glm::ivec2 tile_size,
+            std::filesystem::file_time_type write_time, std::shared_ptr<const TilesetData> data);
+
+        void clear();   ///< @brief 清空缓存（已加载的关卡仍持有各自引用的图块集）
+
+    private:
+        TilesetCache() = default;
+
+        // 禁止拷贝和移动
+        TilesetCache(const TilesetCache&) = delete;
+        TilesetCache& operator=(const TilesetCache&) = delete;
+        TilesetCache(TilesetCache&&) = delete;
+        TilesetCache& operator=(TilesetCache&&) = delete;
+
+        static std::string makeKey(const std::string& tileset_path, glm::ivec2 tile_size);
+    };
+
+} // namespace engine::scene
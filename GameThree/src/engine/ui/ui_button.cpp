@@ -1,5 +1,6 @@
 #include "ui_button.h"
 #include "state/ui_normal_state.h"
+#include "../resource/resource_manifest.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::ui {
@@ -20,8 +21,8 @@ namespace engine::ui {
         setState(std::make_unique<engine::ui::state::UINormalState>(this));
 
         // 设置默认音效
-        addSound("hover", "assets/audio/button_hover.wav");
-        addSound("pressed", "assets/audio/button_click.wav");
+        addSound("hover", HOVER_SOUND);
+        addSound("pressed", PRESSED_SOUND);
         spdlog::trace("UIButton 构造完成");
     }
 
@@ -30,4 +31,16 @@ namespace engine::ui {
         if (callback_) callback_();
     }
 
+    void UIButton::collectResources(engine::resource::ResourceManifest& manifest,
+        const std::string& normal_sprite_id,
+        const std::string& hover_sprite_id,
+        const std::string& pressed_sprite_id)
+    {
+        manifest.addTexture(normal_sprite_id);
+        manifest.addTexture(hover_sprite_id);
+        manifest.addTexture(pressed_sprite_id);
+        manifest.addSound(HOVER_SOUND);
+        manifest.addSound(PRESSED_SOUND);
+    }
+
 } // namespace engine::ui
\ No newline at end of file
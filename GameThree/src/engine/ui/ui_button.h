@@ -3,6 +3,10 @@
 #include <functional>
 #include <utility>
 
+namespace engine::resource {
+    class ResourceManifest;
+}
+
 namespace engine::ui {
 
     /**
@@ -17,6 +21,9 @@ namespace engine::ui {
         std::function<void()> callback_;        ///< @brief 可自定义的函数（函数包装器）
 
     public:
+        static constexpr const char* HOVER_SOUND = "assets/audio/button_hover.wav";     ///< @brief 默认的悬停音效
+        static constexpr const char* PRESSED_SOUND = "assets/audio/button_click.wav";   ///< @brief 默认的按下音效
+
         /**
          * @brief 构造函数
          * @param normal_sprite_id 正常状态的精灵ID
@@ -40,6 +47,12 @@ namespace engine::ui {
         void setCallback(std::function<void()> callback) { callback_ = std::move(callback); }   ///< @brief 设置点击回调函数
         std::function<void()> getCallback() const { return callback_; }                         ///< @brief 获取点击回调函数
 
+        /// @brief 把一个按钮三种状态的纹理和默认音效加入资源清单（供场景的 collectResources 使用）
+        static void collectResources(engine::resource::ResourceManifest& manifest,
+            const std::string& normal_sprite_id,
+            const std::string& hover_sprite_id,
+            const std::string& pressed_sprite_id);
+
     };
 
 } // namespace engine::ui
\ No newline at end of file
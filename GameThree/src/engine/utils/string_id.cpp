@@ -0,0 +1,62 @@
+#include "string_id.h"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <spdlog/spdlog.h>
+
+namespace engine::utils {
+
+    namespace {
+        /// @brief 字符串驻留表：字符串 -> ID，ID -> 字符串
+        struct StringTable {
+            std::shared_mutex mutex;                                ///< @brief 读多写少，查询使用共享锁
+            std::deque<std::string> strings;                        ///< @brief ID -> 字符串（deque 追加元素不会使已有元素地址失效）
+            std::unordered_map<std::string_view, StringId> ids;     ///< @brief 字符串 -> ID（键指向 strings 中的元素）
+
+            StringTable() {
+                strings.emplace_back();                             // 预先驻留空字符串，ID 为 EMPTY_STRING_ID
+                ids.emplace(strings.back(), EMPTY_STRING_ID);
+            }
+        };
+
+        /// @brief 获取驻留表（函数内静态变量，保证在其他静态变量初始化时也可以使用）
+        StringTable& getStringTable() {
+            static StringTable table;
+            return table;
+        }
+    }
+
+    StringId internString(std::string_view str)
+    {
+        auto& table = getStringTable();
+        {
+            std::shared_lock lock(table.mutex);
+            if (auto it = table.ids.find(str); it != table.ids.end()) return it->second;
+        }
+        std::unique_lock lock(table.mutex);
+        if (auto it = table.ids.find(str); it != table.ids.end()) return it->second;  // 加锁期间可能已被其他线程驻留
+        auto id = static_cast<StringId>(table.strings.size());
+        table.strings.emplace_back(str);
+        table.ids.emplace(table.strings.back(), id);
+        spdlog::trace("驻留字符串 '{}' -> {}", str, id);
+        return id;
+    }
+
+    StringId findStringId(std::string_view str)
+    {
+        auto& table = getStringTable();
+        std::shared_lock lock(table.mutex);
+        auto it = table.ids.find(str);
+        return it != table.ids.end() ? it->second : INVALID_STRING_ID;
+    }
+
+    const std::string& getInternedString(StringId id)
+    {
+        auto& table = getStringTable();
+        std::shared_lock lock(table.mutex);
+        if (id >= table.strings.size()) return table.strings.front();
+        return table.strings[id];
+    }
+
+} // namespace engine::utils
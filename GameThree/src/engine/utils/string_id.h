@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace engine::utils {
+
+    /**
+     * @brief 驻留字符串的ID。相同内容的字符串总是得到相同的ID，比较ID即比较字符串。
+     *
+     * 名称、标签等在加载时驻留一次，之后游戏逻辑只比较 32 位整数。
+     * ID 在进程内有效（驻留表只增不减），不要写入存档。
+     */
+    using StringId = std::uint32_t;
+
+    inline constexpr StringId EMPTY_STRING_ID = 0;              ///< @brief 空字符串的ID（预先驻留）
+    inline constexpr StringId INVALID_STRING_ID = UINT32_MAX;   ///< @brief 表示"未驻留"的ID（findStringId 查找失败时返回）
+
+    /**
+     * @brief 驻留字符串，返回其ID（线程安全）。
+     * @param str 字符串
+     * @return StringId 字符串ID，首次驻留时分配新ID
+     */
+    StringId internString(std::string_view str);
+
+    /**
+     * @brief 查找字符串的ID，不驻留新字符串（线程安全）。
+     * @param str 字符串
+     * @return StringId 字符串ID，字符串从未驻留过则返回 INVALID_STRING_ID
+     */
+    StringId findStringId(std::string_view str);
+
+    /**
+     * @brief 根据ID获取驻留的字符串（线程安全，每次调用加共享锁；频繁读取时应缓存返回的引用，如 GameObject 的名称）。
+     * @param id 字符串ID
+     * @return const std::string& 驻留的字符串（地址在进程内保持不变），无效ID返回空字符串
+     */
+    const std::string& getInternedString(StringId id);
+
+} // namespace engine::utils
@@ -0,0 +1,131 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <spdlog/spdlog.h>
+
+namespace engine::utils {
+
+    namespace {
+        /// @brief 一次 parallelFor 的共享状态（辅助任务可能在调用返回后才开始，因此由 shared_ptr 持有）
+        struct ParallelJob {
+            const std::function<void(std::size_t)>* func = nullptr;    ///< @brief 工作函数（只在还有未领取的下标时访问）
+            std::size_t count = 0;                                      ///< @brief 下标数量
+            std::atomic<std::size_t> next = 0;                          ///< @brief 下一个未领取的下标
+            std::atomic<std::size_t> remaining = 0;                     ///< @brief 尚未完成的下标数量
+            std::mutex mutex;                                           ///< @brief 保护 error 和完成通知
+            std::condition_variable done;                               ///< @brief 全部完成时通知调用线程
+            std::exception_ptr error;                                   ///< @brief 第一个异常
+
+            /// @brief 领取并执行下标，直到没有剩余
+            void work() {
+                for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed)) {
+                    try {
+                        (*func)(i);
+                    }
+                    catch (...) {
+                        std::lock_guard lock(mutex);
+                        if (!error) error = std::current_exception();
+                    }
+                    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        std::lock_guard lock(mutex);
+                        done.notify_all();
+                    }
+                }
+            }
+        };
+    }
+
+    ThreadPool& ThreadPool::getInstance() {
+        static ThreadPool instance(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        return instance;
+    }
+
+    ThreadPool::ThreadPool(std::size_t thread_count) {
+        workers_.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            workers_.emplace_back(&ThreadPool::run, this);
+        }
+        spdlog::trace("线程池已启动: {} 个工作线程。", thread_count);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+    void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& func) {
+        if (count == 0) return;
+        if (count == 1 || workers_.empty()) {   // 没有并行的必要，直接在调用线程执行
+            for (std::size_t i = 0; i < count; ++i) func(i);
+            return;
+        }
+
+        auto job = std::make_shared<ParallelJob>();
+        job->func = &func;
+        job->count = count;
+        job->remaining.store(count, std::memory_order_relaxed);
+
+        // 最多叫醒 count - 1 个工作线程，调用线程自己也领取下标
+        const auto helper_count = std::min(count - 1, workers_.size());
+        {
+            std::lock_guard lock(mutex_);
+            for (std::size_t i = 0; i < helper_count; ++i) {
+                tasks_.emplace_back([job]() { job->work(); });
+            }
+        }
+        condition_.notify_all();
+
+        job->work();
+        {
+            std::unique_lock lock(job->mutex);
+            job->done.wait(lock, [&job]() { return job->remaining.load(std::memory_order_acquire) == 0; });
+        }
+        if (job->error) std::rethrow_exception(job->error);
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        if (!task) return;
+        if (workers_.empty()) {
+            task();
+            return;
+        }
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.emplace_back([task = std::move(task)]() {
+                try {
+                    task();
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("线程池后台任务抛出异常: {}", e.what());
+                }
+                catch (...) {
+                    spdlog::error("线程池后台任务抛出未知异常。");
+                }
+            });
+        }
+        condition_.notify_one();
+    }
+
+    void ThreadPool::run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;     // stopping_ 且没有剩余任务
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+} // namespace engine::utils
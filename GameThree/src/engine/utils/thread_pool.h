@@ -0,0 +1,65 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::utils {
+
+    /**
+     * @brief 固定大小的线程池，用于把互相独立的批量工作（如关卡各图层的解码）分给多个线程。
+     *
+     * 调用 parallelFor 的线程也参与执行并等待全部完成，因此可以在工作线程中嵌套调用而不会死锁；
+     * submit 则只把任务放入队列，不等待其完成。
+     * 进程级实例在首次使用时创建，线程数为硬件线程数减一（调用线程补足）。
+     */
+    class ThreadPool final {
+        std::vector<std::thread> workers_;              ///< @brief 工作线程
+        std::mutex mutex_;                              ///< @brief 保护任务队列
+        std::condition_variable condition_;             ///< @brief 通知工作线程有新任务或需要退出
+        std::deque<std::function<void()>> tasks_;       ///< @brief 任务队列
+        bool stopping_ = false;                         ///< @brief 是否需要退出
+
+    public:
+        static ThreadPool& getInstance();   ///< @brief 获取进程级线程池
+
+        /**
+         * @brief 创建线程池并启动工作线程。
+         * @param thread_count 工作线程数量（0 表示所有工作都在调用线程上执行）
+         */
+        explicit ThreadPool(std::size_t thread_count);
+        ~ThreadPool();      ///< @brief 停止并等待工作线程结束（队列中剩余的任务会先执行完）
+
+        // 禁止拷贝和移动
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        /**
+         * @brief 对 [0, count) 中的每个下标调用 func(i)，分给工作线程和调用线程并行执行，全部完成后返回。
+         * @details 各下标的执行顺序不确定，func 必须只访问与下标对应的数据（或自行加锁）。
+         *          func 抛出异常时，其余下标仍会执行完，之后在调用线程重新抛出第一个异常。
+         * @param count 下标数量
+         * @param func 工作函数
+         */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& func);
+
+        /**
+         * @brief 提交一个后台任务后立即返回（如图片解码），任务在某个工作线程上执行。
+         * @details 没有工作线程时直接在调用线程执行。任务不应抛出异常（抛出的异常会被记录并丢弃），
+         *          也不应等待其他后台任务完成；任务访问的数据须在其完成前保持有效（通常由 shared_ptr 持有）。
+         * @param task 任务函数
+         */
+        void submit(std::function<void()> task);
+
+        std::size_t getThreadCount() const { return workers_.size(); }     ///< @brief 获取工作线程数量
+
+    private:
+        void run();     ///< @brief 工作线程入口
+    };
+
+} // namespace engine::utils
@@ -17,19 +17,32 @@ namespace game::component {
             return;
         }
 
-        // 获取并缓存必要的组件指针
-        transform_component_ = owner_->getComponent<engine::component::TransformComponent>();
-        physics_component_ = owner_->getComponent<engine::component::PhysicsComponent>();
-        sprite_component_ = owner_->getComponent<engine::component::SpriteComponent>();
-        animation_component_ = owner_->getComponent<engine::component::AnimationComponent>();
+        // 缓存音频组件指针（其余组件每次通过所有者获取）
         audio_component_ = owner_->getComponent<engine::component::AudioComponent>();
 
         // 检查是否所有必需的组件都存在(音频组件并非必须存在)
-        if (!transform_component_ || !physics_component_ || !sprite_component_ || !animation_component_) {
+        if (!owner_->hasComponent<engine::component::TransformComponent>() || !owner_->hasComponent<engine::component::PhysicsComponent>() ||
+            !owner_->hasComponent<engine::component::SpriteComponent>() || !owner_->hasComponent<engine::component::AnimationComponent>()) {
             spdlog::error("GameObject '{}' 上的 AIComponent 缺少必需的组件", owner_->getName());
         }
     }
 
+    engine::component::TransformComponent* AIComponent::getTransformComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::TransformComponent>() : nullptr;
+    }
+
+    engine::component::PhysicsComponent* AIComponent::getPhysicsComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::PhysicsComponent>() : nullptr;
+    }
+
+    engine::component::SpriteComponent* AIComponent::getSpriteComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::SpriteComponent>() : nullptr;
+    }
+
+    engine::component::AnimationComponent* AIComponent::getAnimationComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::AnimationComponent>() : nullptr;
+    }
+
     void AIComponent::update(float delta_time, engine::core::Context&) {
         // 将更新委托给当前的行为策略
         if (current_behavior_) {
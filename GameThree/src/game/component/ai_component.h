@@ -22,15 +22,14 @@ namespace game::component {
      */
     class AIComponent final : public engine::component::Component {
         friend class engine::object::GameObject;
+    public:
+        static constexpr engine::component::ComponentTypeId TYPE_ID = engine::component::component_type::FIRST_GAME + 1;  ///< @brief 固定的组件类型ID（游戏层组件在引擎组件之后）
+
     private:
         std::unique_ptr<ai::AIBehavior> current_behavior_ = nullptr; ///< @brief 当前 AI 行为策略
         /* 未来可添加一些敌人属性 */
 
-        // --- 缓存组件指针 ---
-        engine::component::TransformComponent* transform_component_ = nullptr;
-        engine::component::PhysicsComponent* physics_component_ = nullptr;
-        engine::component::SpriteComponent* sprite_component_ = nullptr;
-        engine::component::AnimationComponent* animation_component_ = nullptr;
+        // --- 缓存组件指针（变换、物理、精灵、动画组件紧密存储在原型中会被搬移，不缓存，每次通过所有者获取） ---
         engine::component::AudioComponent* audio_component_ = nullptr;
 
     public:
@@ -48,10 +47,10 @@ namespace game::component {
         bool isAlive() const;               ///< @brief 检查对象是否存活
 
         // --- Setters and Getters ---
-        engine::component::TransformComponent* getTransformComponent() const { return transform_component_; }
-        engine::component::PhysicsComponent* getPhysicsComponent() const { return physics_component_; }
-        engine::component::SpriteComponent* getSpriteComponent() const { return sprite_component_; }
-        engine::component::AnimationComponent* getAnimationComponent() const { return animation_component_; }
+        engine::component::TransformComponent* getTransformComponent() const;
+        engine::component::PhysicsComponent* getPhysicsComponent() const;
+        engine::component::SpriteComponent* getSpriteComponent() const;
+        engine::component::AnimationComponent* getAnimationComponent() const;
         engine::component::AudioComponent* getAudioComponent() const { return audio_component_; }
 
     private:
@@ -24,16 +24,12 @@ namespace game::component {
         }
 
         // 获取必要的组件
-        transform_component_ = owner_->getComponent<engine::component::TransformComponent>();
-        physics_component_ = owner_->getComponent<engine::component::PhysicsComponent>();
-        sprite_component_ = owner_->getComponent<engine::component::SpriteComponent>();
-        animation_component_ = owner_->getComponent<engine::component::AnimationComponent>();
         health_component_ = owner_->getComponent<engine::component::HealthComponent>();
         audio_component_ = owner_->getComponent<engine::component::AudioComponent>();
 
         // 检查必要组件是否存在
-        if (!transform_component_ || !physics_component_ || !sprite_component_ ||
-            !animation_component_ || !health_component_ || !audio_component_) {
+        if (!getTransformComponent() || !getPhysicsComponent() || !getSpriteComponent() ||
+            !getAnimationComponent() || !health_component_ || !audio_component_) {
             spdlog::error("Player 对象缺少必要组件！");
         }
 
@@ -87,9 +83,25 @@ namespace game::component {
 
     }
 
+    engine::component::TransformComponent* PlayerComponent::getTransformComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::TransformComponent>() : nullptr;
+    }
+
+    engine::component::SpriteComponent* PlayerComponent::getSpriteComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::SpriteComponent>() : nullptr;
+    }
+
+    engine::component::PhysicsComponent* PlayerComponent::getPhysicsComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::PhysicsComponent>() : nullptr;
+    }
+
+    engine::component::AnimationComponent* PlayerComponent::getAnimationComponent() const {
+        return owner_ ? owner_->getComponent<engine::component::AnimationComponent>() : nullptr;
+    }
+
     bool PlayerComponent::is_on_ground() const
     {
-        return coyote_timer_ <= coyote_time_ || physics_component_->hasCollidedBelow();
+        return coyote_timer_ <= coyote_time_ || getPhysicsComponent()->hasCollidedBelow();
     }
 
     void PlayerComponent::handleInput(engine::core::Context& context) {
@@ -105,7 +117,7 @@ namespace game::component {
         if (!current_state_) return;
 
         // 一旦离地，开始计时 Coyote Timer
-        if (!physics_component_->hasCollidedBelow()) {
+        if (!getPhysicsComponent()->hasCollidedBelow()) {
             coyote_timer_ += delta_time;
         }
         else {    // 如果碰撞到地面，重置 Coyote Timer
@@ -113,6 +125,7 @@ namespace game::component {
         }
 
         // 如果处于无敌状态，则进行闪烁
+        auto* sprite_component = getSpriteComponent();
         if (health_component_->isInvincible()) {
             flash_timer_ += delta_time;         // 闪烁计时器增加
             if (flash_timer_ >= 2 * flash_interval_) {
@@ -120,15 +133,15 @@ namespace game::component {
             }
             // 一半时间可见，一半时间不可见。
             if (flash_timer_ < flash_interval_) {
-                sprite_component_->setHidden(true);
+                sprite_component->setHidden(true);
             }
             else {
-                sprite_component_->setHidden(false);
+                sprite_component->setHidden(false);
             }
         }
         // 非无敌状态时确保精灵可见
-        else if (sprite_component_->isHidden()) {
-            sprite_component_->setHidden(false);
+        else if (sprite_component->isHidden()) {
+            sprite_component->setHidden(false);
         }
 
         auto next_state = current_state_->update(delta_time, context);
@@ -27,11 +27,11 @@ namespace game::component {
      */
     class PlayerComponent final : public engine::component::Component {
         friend class engine::object::GameObject;
+    public:
+        static constexpr engine::component::ComponentTypeId TYPE_ID = engine::component::component_type::FIRST_GAME + 0;  ///< @brief 固定的组件类型ID（游戏层组件在引擎组件之后）
+
     private:
-        engine::component::TransformComponent* transform_component_ = nullptr; // 指向 TransformComponent 的非拥有指针
-        engine::component::SpriteComponent* sprite_component_ = nullptr;
-        engine::component::PhysicsComponent* physics_component_ = nullptr;
-        engine::component::AnimationComponent* animation_component_ = nullptr;
+        // 变换、精灵、物理、动画组件紧密存储在原型中会被搬移，不缓存，每次通过所有者获取
         engine::component::HealthComponent* health_component_ = nullptr;
         engine::component::AudioComponent* audio_component_ = nullptr;
 
@@ -69,10 +69,10 @@ namespace game::component {
         bool takeDamage(int damage);        ///< @brief 试图造成伤害，返回是否成功
 
         // setters and getters
-        engine::component::TransformComponent* getTransformComponent() const { return transform_component_; }
-        engine::component::SpriteComponent* getSpriteComponent() const { return sprite_component_; }
-        engine::component::PhysicsComponent* getPhysicsComponent() const { return physics_component_; }
-        engine::component::AnimationComponent* getAnimationComponent() const { return animation_component_; }
+        engine::component::TransformComponent* getTransformComponent() const;
+        engine::component::SpriteComponent* getSpriteComponent() const;
+        engine::component::PhysicsComponent* getPhysicsComponent() const;
+        engine::component::AnimationComponent* getAnimationComponent() const;
         engine::component::HealthComponent* getHealthComponent() const { return health_component_; }
         engine::component::AudioComponent* getAudioComponent() const { return audio_component_; }
 
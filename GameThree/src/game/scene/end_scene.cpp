@@ -1,11 +1,12 @@
 #include "end_scene.h"
 #include "title_scene.h"
-#include "game_scene.h"
+#include "loading_scene.h"
 #include "../data/session_data.h"
 #include "../../engine/core/context.h"
 #include "../../engine/core/game_state.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/scene/scene_manager.h"
+#include "../../engine/resource/resource_manifest.h"
 #include "../../engine/ui/ui_manager.h"
 #include "../../engine/ui/ui_label.h"
 #include "../../engine/ui/ui_button.h"
@@ -39,6 +40,15 @@ namespace game::scene {
         spdlog::info("EndScene 初始化完成。");
     }
 
+    void EndScene::collectResources(engine::resource::ResourceManifest& manifest) const {
+        manifest.addFont("assets/fonts/VonwaonBitmap-16px.ttf", 48);     // 主文字
+        manifest.addFont("assets/fonts/VonwaonBitmap-16px.ttf", 24);     // 得分
+        for (const std::string name : { "Back", "Restart" }) {
+            const auto prefix = "assets/textures/UI/buttons/" + name;
+            engine::ui::UIButton::collectResources(manifest, prefix + "1.png", prefix + "2.png", prefix + "3.png");
+        }
+    }
+
     void EndScene::createUI() {
         auto window_size = context_.getGameState().getLogicalSize();
         if (!ui_manager_->init(window_size)) {
@@ -137,7 +147,7 @@ namespace game::scene {
         spdlog::info("重新开始按钮被点击。");
         // 重新开始游戏
         session_data_->reset();
-        scene_manager_.requestReplaceScene(std::make_unique<GameScene>(context_, scene_manager_, session_data_));
+        scene_manager_.requestReplaceScene(std::make_unique<LoadingScene>(context_, scene_manager_, session_data_));
     }
 
 } // namespace game::scene
\ No newline at end of file
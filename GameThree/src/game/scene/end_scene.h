@@ -54,6 +54,7 @@ namespace game::scene {
 
         // --- 核心循环方法 ---
         void init() override;
+        void collectResources(engine::resource::ResourceManifest& manifest) const override;  ///< @brief 声明场景用到的资源
 
         // 禁止拷贝和移动
         EndScene(const EndScene&) = delete;
@@ -1,10 +1,13 @@
 #include "game_scene.h"
 #include "menu_scene.h"
 #include "end_scene.h"
+#include "loading_scene.h"
 #include "../component/player_component.h"
 #include "../../engine/core/context.h"
 #include "../../engine/core/game_state.h"
 #include "../../engine/object/game_object.h"
+#include "../../engine/object/handle_table.h"
+#include "../../engine/object/object_index.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/component/sprite_component.h"
 #include "../../engine/component/physics_component.h"
@@ -15,9 +18,13 @@
 #include "../../engine/physics/physics_engine.h"
 #include "../../engine/scene/level_loader.h"
 #include "../../engine/scene/scene_manager.h"
+#include "../../engine/scene/object_pool.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/render/camera.h"
 #include "../../engine/render/animation.h"
+#include "../../engine/render/animation_library.h"
+#include "../../engine/resource/resource_manager.h"
+#include "../../engine/resource/resource_manifest.h"
 #include "../../engine/render/text_renderer.h"
 #include "../../engine/audio/audio_player.h"
 #include "../../engine/ui/ui_manager.h"
@@ -26,6 +33,7 @@
 #include "../../engine/ui/ui_image.h"
 #include "../../engine/ui/ui_button.h"
 #include "../../engine/utils/math.h"
+#include "../../engine/utils/string_id.h"
 #include "../component/ai_component.h"
 #include "../component/ai/patrol_behavior.h"
 #include "../component/ai/updown_behavior.h"
@@ -35,10 +43,39 @@
 
 namespace game::scene {
 
+    namespace {
+        // 游戏逻辑中用到的名称和标签（驻留一次，之后只比较ID）
+        const auto PLAYER_NAME = engine::utils::internString("player");
+        const auto EAGLE = engine::utils::internString("eagle");
+        const auto FROG = engine::utils::internString("frog");
+        const auto OPOSSUM = engine::utils::internString("opossum");
+        const auto WIN = engine::utils::internString("win");
+        const auto FRUIT = engine::utils::internString("fruit");
+        const auto GEM = engine::utils::internString("gem");
+        const auto ENEMY_TAG = engine::utils::internString("enemy");
+        const auto ITEM_TAG = engine::utils::internString("item");
+        const auto HAZARD_TAG = engine::utils::internString("hazard");
+        const auto NEXT_LEVEL_TAG = engine::utils::internString("next_level");
+
+        /// @brief 特效类型描述：贴图、帧尺寸和帧数
+        struct EffectDesc {
+            const char* tag;
+            const char* texture_path;
+            glm::vec2 frame_size;
+            int frame_count;
+        };
+        const EffectDesc EFFECTS[] = {
+            { "enemy", "assets/textures/FX/enemy-deadth.png", { 40.0f, 41.0f }, 5 },
+            { "item", "assets/textures/FX/item-feedback.png", { 32.0f, 32.0f }, 4 },
+        };
+    }
+
     GameScene::GameScene(engine::core::Context& context,
         engine::scene::SceneManager& scene_manager,
-        std::shared_ptr<game::data::SessionData> data)
-        : Scene("GameScene", context, scene_manager), game_session_data_(std::move(data)) {
+        std::shared_ptr<game::data::SessionData> data,
+        std::shared_ptr<engine::scene::LevelLoader> prepared_level_loader)
+        : Scene("GameScene", context, scene_manager), game_session_data_(std::move(data)),
+        prepared_level_loader_(std::move(prepared_level_loader)) {
         if (!game_session_data_) {      // 如果没有传入SessionData，则创建一个默认的
             game_session_data_ = std::make_shared<game::data::SessionData>();
             spdlog::info("未提供 SessionData，使用默认值。");
@@ -70,6 +107,7 @@ namespace game::scene {
             context_.getInputManager().setShouldQuit(true);
             return;
         }
+        registerEffectPools();
         if (!initUI()) {
             spdlog::error("UI初始化失败，无法继续。");
             context_.getInputManager().setShouldQuit(true);
@@ -83,14 +121,30 @@ namespace game::scene {
         spdlog::trace("GameScene 初始化完成。");
     }
 
+    void GameScene::collectResources(engine::resource::ResourceManifest& manifest) const {
+        // 已由加载场景解析好的关卡：连同关卡资源一起预加载（同步加载的关卡由 LevelLoader 在 init 中预加载）
+        if (prepared_level_loader_) {
+            manifest.merge(prepared_level_loader_->getResourceManifest());
+        }
+        manifest.addMusic("assets/audio/hurry_up_and_run.ogg");
+        manifest.addSound("assets/audio/punch2a.mp3");
+        manifest.addSound("assets/audio/poka01.mp3");
+        for (const auto& desc : EFFECTS) {
+            manifest.addTexture(desc.texture_path);
+        }
+        manifest.addTexture("assets/textures/UI/Heart.png");
+        manifest.addTexture("assets/textures/UI/Heart-bg.png");
+        manifest.addFont("assets/fonts/VonwaonBitmap-16px.ttf", 16);
+    }
+
     void GameScene::update(float delta_time) {
         Scene::update(delta_time);
         handleObjectCollisions();
         handleTileTriggers();
 
         // 玩家掉出地图下方则判断为失败
-        if (player_) {
-            auto pos = player_->getComponent<engine::component::TransformComponent>()->getPosition();
+        if (auto* player = getPlayer(); player) {
+            auto pos = player->getComponent<engine::component::TransformComponent>()->getPosition();
             auto world_rect = context_.getPhysicsEngine().getWorldBounds();
             // 多100像素冗余量
             if (world_rect && pos.y > world_rect->position.y + world_rect->size.y + 100.0f) {
@@ -117,12 +171,34 @@ namespace game::scene {
         Scene::clean();
     }
 
+    engine::object::GameObject* GameScene::getPlayer() const
+    {
+        return context_.getHandleTable().resolve(player_);
+    }
+
     bool GameScene::initLevel()
     {
-        // 加载关卡（level_loader通常加载完成后即可销毁，因此不存为成员变量）
-        engine::scene::LevelLoader level_loader;
-        auto level_path = game_session_data_->getMapPath();
-        if (!level_loader.loadLevel(level_path, *this)) {
+        // 加载关卡（由 shared_ptr 持有，对象生成器会保留加载器以便按需创建对象，场景清理时释放）
+        // 后台已解析好的关卡只需构建对象，否则同步加载
+        // 敌人、道具等图片对象按需生成；玩家和终点在初始化时按名称查找，必须立即创建
+        auto configure = [](engine::scene::LevelLoader& level_loader) {
+            level_loader.setSpawnOnDemand(true);
+            level_loader.addImmediateObjectName(engine::utils::getInternedString(PLAYER_NAME));
+            level_loader.addImmediateObjectName(engine::utils::getInternedString(WIN));
+        };
+        bool loaded = false;
+        if (prepared_level_loader_) {
+            auto level_loader = std::move(prepared_level_loader_);
+            configure(*level_loader);
+            loaded = level_loader->buildLevel(*this);
+        }
+        else {
+            auto level_loader = std::make_shared<engine::scene::LevelLoader>();
+            level_loader->setStreamingSettings(scene_manager_.getLevelStreamingSettings());
+            configure(*level_loader);
+            loaded = level_loader->loadLevel(game_session_data_->getMapPath(), *this);
+        }
+        if (!loaded) {
             spdlog::error("关卡加载失败");
             return false;
         }
@@ -144,33 +220,38 @@ namespace game::scene {
         // 设置相机边界
         auto world_size = main_layer->getComponent<engine::component::TileLayerComponent>()->getWorldSize();
         context_.getCamera().setLimitBounds(engine::utils::Rect(glm::vec2(0.0f), world_size));
-        context_.getCamera().setPosition(glm::vec2(0.0f));     // 开始时重置相机位置，以免切换场景时晃动
+        context_.getCamera().setPosition(glm::vec2(0.0f));     // 开始时重置相机位置，以免切换场景时晃动（找到玩家后直接移到玩家处）
 
         // 设置世界边界
         context_.getPhysicsEngine().setWorldBounds(engine::utils::Rect(glm::vec2(0.0f), world_size));
 
+        // 关底触发器和结束触发器不参与休眠判定
+        object_index_->forEachWithTag(NEXT_LEVEL_TAG, [](engine::object::GameObject* obj) { obj->setAlwaysActive(true); });
+        if (auto* win = findGameObjectByName(WIN); win) win->setAlwaysActive(true);
+
         spdlog::trace("关卡初始化完成。");
         return true;
     }
 
     bool GameScene::initPlayer()
     {
-        // 获取玩家对象
-        player_ = findGameObjectByName("player");
-        if (!player_) {
+        // 获取玩家对象，保存其句柄
+        auto* player = findGameObjectByName(PLAYER_NAME);
+        if (!player) {
             spdlog::error("未找到玩家对象");
             return false;
         }
+        player_ = player->getHandle();
 
         // 添加PlayerComponent到玩家对象
-        auto* player_component = player_->addComponent<game::component::PlayerComponent>();
+        auto* player_component = player->addComponent<game::component::PlayerComponent>();
         if (!player_component) {
             spdlog::error("无法添加 PlayerComponent 到玩家对象");
             return false;
         }
 
         // 从SessionData中更新玩家生命值
-        if (auto health_component = player_->getComponent<engine::component::HealthComponent>(); health_component) {
+        if (auto health_component = player->getComponent<engine::component::HealthComponent>(); health_component) {
             health_component->setMaxHealth(game_session_data_->getMaxHealth());
             health_component->setCurrentHealth(game_session_data_->getCurrentHealth());
         }
@@ -180,52 +261,68 @@ namespace game::scene {
         }
 
         // 相机跟随玩家
-        auto* player_transform = player_->getComponent<engine::component::TransformComponent>();
-        if (!player_transform) {
+        if (!player->hasComponent<engine::component::TransformComponent>()) {
             spdlog::error("玩家对象没有 TransformComponent 组件, 无法设置相机目标");
             return false;
         }
-        context_.getCamera().setTarget(player_transform);
+        context_.getCamera().setTarget(player_);
+        context_.getCamera().snapToTarget();    // 首帧的视口就在玩家周围（流式加载器首次同步载入的块、生成器生成的对象都以视口为准）
+
+        // 玩家始终活跃，且玩家周围也是活动区域
+        player->setAlwaysActive(true);
+        setActivityAnchor(player_);
         spdlog::trace("Player初始化完成。");
         return true;
     }
 
     bool GameScene::initEnemyAndItem()
     {
+        // 这里只处理立即创建的对象，按需生成的对象在 onGameObjectSpawned 中处理
         bool success = true;
         for (auto& game_object : game_objects_) {
-            if (game_object->getName() == "eagle") {
-                if (auto* ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component) {
-                    auto y_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().y;
-                    auto y_min = y_max - 80.0f;    // 让鹰的飞行范围 (当前位置与上方80像素 的区域)
-                    ai_component->setBehavior(std::make_unique<game::component::ai::UpDownBehavior>(y_min, y_max));
-                }
+            if (game_object && !setupEnemyOrItem(*game_object)) success = false;
+        }
+        return success;
+    }
+
+    void GameScene::onGameObjectSpawned(engine::object::GameObject& game_object)
+    {
+        setupEnemyOrItem(game_object);
+    }
+
+    bool GameScene::setupEnemyOrItem(engine::object::GameObject& game_object)
+    {
+        if (game_object.getNameId() == EAGLE) {
+            if (auto* ai_component = game_object.addComponent<game::component::AIComponent>(); ai_component) {
+                auto y_max = game_object.getComponent<engine::component::TransformComponent>()->getPosition().y;
+                auto y_min = y_max - 80.0f;    // 让鹰的飞行范围 (当前位置与上方80像素 的区域)
+                ai_component->setBehavior(std::make_unique<game::component::ai::UpDownBehavior>(y_min, y_max));
             }
-            if (game_object->getName() == "frog") {
-                if (auto* ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component) {
-                    auto x_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().x - 10.0f;
-                    auto x_min = x_max - 90.0f;    // 青蛙跳跃范围（右侧 - 10.0f 是为了增加稳定性）
-                    ai_component->setBehavior(std::make_unique<game::component::ai::JumpBehavior>(x_min, x_max));
-                }
+        }
+        if (game_object.getNameId() == FROG) {
+            if (auto* ai_component = game_object.addComponent<game::component::AIComponent>(); ai_component) {
+                auto x_max = game_object.getComponent<engine::component::TransformComponent>()->getPosition().x - 10.0f;
+                auto x_min = x_max - 90.0f;    // 青蛙跳跃范围（右侧 - 10.0f 是为了增加稳定性）
+                ai_component->setBehavior(std::make_unique<game::component::ai::JumpBehavior>(x_min, x_max));
             }
-            if (game_object->getName() == "opossum") {
-                if (auto* ai_component = game_object->addComponent<game::component::AIComponent>(); ai_component) {
-                    auto x_max = game_object->getComponent<engine::component::TransformComponent>()->getPosition().x;
-                    auto x_min = x_max - 200.0f;    // 负鼠巡逻范围
-                    ai_component->setBehavior(std::make_unique<game::component::ai::PatrolBehavior>(x_min, x_max));
-                }
+        }
+        if (game_object.getNameId() == OPOSSUM) {
+            if (auto* ai_component = game_object.addComponent<game::component::AIComponent>(); ai_component) {
+                auto x_max = game_object.getComponent<engine::component::TransformComponent>()->getPosition().x;
+                auto x_min = x_max - 200.0f;    // 负鼠巡逻范围
+                ai_component->setBehavior(std::make_unique<game::component::ai::PatrolBehavior>(x_min, x_max));
             }
-            if (game_object->getTag() == "item") {
-                if (auto* ac = game_object->getComponent<engine::component::AnimationComponent>(); ac) {
-                    ac->playAnimation("idle");
-                }
-                else {
-                    spdlog::error("Item对象缺少 AnimationComponent，无法播放动画。");
-                    success = false;
-                }
+        }
+        if (game_object.getTagId() == ITEM_TAG) {
+            if (auto* ac = game_object.getComponent<engine::component::AnimationComponent>(); ac) {
+                ac->playAnimation("idle");
+            }
+            else {
+                spdlog::error("Item对象缺少 AnimationComponent，无法播放动画。");
+                return false;
             }
         }
-        return success;
+        return true;
     }
 
     bool GameScene::initUI()
@@ -240,46 +337,48 @@ namespace game::scene {
     void GameScene::handleObjectCollisions()
     {
         // 从物理引擎中获取碰撞对
-        auto collision_pairs = context_.getPhysicsEngine().getCollisionPairs();
+        const auto& handle_table = context_.getHandleTable();
+        const auto& collision_pairs = context_.getPhysicsEngine().getCollisionPairs();
         for (const auto& pair : collision_pairs) {
-            auto* obj1 = pair.first;
-            auto* obj2 = pair.second;
+            auto* obj1 = handle_table.resolve(pair.first);
+            auto* obj2 = handle_table.resolve(pair.second);
+            if (!obj1 || !obj2) continue;   // 对象已在本帧被销毁/回收，句柄失效
 
             // 处理玩家与敌人的碰撞
-            if (obj1->getName() == "player" && obj2->getTag() == "enemy") {
+            if (obj1->getNameId() == PLAYER_NAME && obj2->getTagId() == ENEMY_TAG) {
                 playerVSEnemyCollision(obj1, obj2);
             }
-            else if (obj2->getName() == "player" && obj1->getTag() == "enemy") {
+            else if (obj2->getNameId() == PLAYER_NAME && obj1->getTagId() == ENEMY_TAG) {
                 playerVSEnemyCollision(obj2, obj1);
             }
             // 处理玩家与道具的碰撞
-            else if (obj1->getName() == "player" && obj2->getTag() == "item") {
+            else if (obj1->getNameId() == PLAYER_NAME && obj2->getTagId() == ITEM_TAG) {
                 playerVSItemCollision(obj1, obj2);
             }
-            else if (obj2->getName() == "player" && obj1->getTag() == "item") {
+            else if (obj2->getNameId() == PLAYER_NAME && obj1->getTagId() == ITEM_TAG) {
                 playerVSItemCollision(obj2, obj1);
             }
             // 处理玩家与"hazard"对象碰撞
-            else if (obj1->getName() == "player" && obj2->getTag() == "hazard") {
+            else if (obj1->getNameId() == PLAYER_NAME && obj2->getTagId() == HAZARD_TAG) {
                 handlePlayerDamage(1);
                 spdlog::debug("玩家 {} 受到了 HAZARD 对象伤害", obj1->getName());
             }
-            else if (obj2->getName() == "player" && obj1->getTag() == "hazard") {
+            else if (obj2->getNameId() == PLAYER_NAME && obj1->getTagId() == HAZARD_TAG) {
                 handlePlayerDamage(1);
                 spdlog::debug("玩家 {} 受到了 HAZARD 对象伤害", obj2->getName());
             }
             // 处理玩家与关底触发器碰撞
-            else if (obj1->getName() == "player" && obj2->getTag() == "next_level") {
+            else if (obj1->getNameId() == PLAYER_NAME && obj2->getTagId() == NEXT_LEVEL_TAG) {
                 toNextLevel(obj2);
             }
-            else if (obj2->getName() == "player" && obj1->getTag() == "next_level") {
+            else if (obj2->getNameId() == PLAYER_NAME && obj1->getTagId() == NEXT_LEVEL_TAG) {
                 toNextLevel(obj1);
             }
             // 处理玩家与结束触发器碰撞
-            else if (obj1->getName() == "player" && obj2->getName() == "win") {
+            else if (obj1->getNameId() == PLAYER_NAME && obj2->getNameId() == WIN) {
                 showEndScene(true);
             }
-            else if (obj2->getName() == "player" && obj1->getName() == "win") {
+            else if (obj2->getNameId() == PLAYER_NAME && obj1->getNameId() == WIN) {
                 showEndScene(true);
             }
         }
@@ -289,11 +388,12 @@ namespace game::scene {
     {
         const auto& tile_trigger_events = context_.getPhysicsEngine().getTileTriggerEvents();
         for (const auto& event : tile_trigger_events) {
-            auto* obj = event.first;        // 瓦片触发事件的对象
+            auto* obj = context_.getHandleTable().resolve(event.first);   // 瓦片触发事件的对象
+            if (!obj) continue;
             auto tile_type = event.second;  // 瓦片类型
             if (tile_type == engine::component::TileType::HAZARD) {
                 // 玩家碰到到危险瓦片，受伤
-                if (obj->getName() == "player") {
+                if (obj->getNameId() == PLAYER_NAME) {
                     handlePlayerDamage(1);
                     spdlog::debug("玩家 {} 受到了 HAZARD 瓦片伤害", obj->getName());
                 }
@@ -304,12 +404,14 @@ namespace game::scene {
 
     void GameScene::handlePlayerDamage(int damage)
     {
-        auto player_component = player_->getComponent<game::component::PlayerComponent>();
+        auto* player = getPlayer();
+        if (!player) return;
+        auto player_component = player->getComponent<game::component::PlayerComponent>();
         if (!player_component->takeDamage(damage)) { // 没有受伤，直接返回
             return;
         }
         if (player_component->isDead()) {
-            spdlog::info("玩家 {} 死亡", player_->getName());
+            spdlog::info("玩家 {} 死亡", player->getName());
             // TODO: 可能的死亡逻辑处理
         }
         // 更新生命值及HealthUI
@@ -355,10 +457,10 @@ namespace game::scene {
 
     void GameScene::playerVSItemCollision(engine::object::GameObject*, engine::object::GameObject* item)
     {
-        if (item->getName() == "fruit") {
+        if (item->getNameId() == FRUIT) {
             healWithUI(1);        // 加血
         }
-        else if (item->getName() == "gem") {
+        else if (item->getNameId() == GEM) {
             addScoreWithUI(5);    // 加5分
         }
         item->setNeedRemove(true);  // 标记道具为待删除状态
@@ -372,8 +474,9 @@ namespace game::scene {
         auto scene_name = trigger->getName();
         auto map_path = levelNameToPath(scene_name);
         game_session_data_->setNextLevel(map_path);     // 设置下一个关卡信息
-        auto next_scene = std::make_unique<game::scene::GameScene>(context_, scene_manager_, game_session_data_);
-        scene_manager_.requestReplaceScene(std::move(next_scene));
+        // 先切换到加载场景，下一关在后台加载完成后再替换为游戏场景
+        auto loading_scene = std::make_unique<game::scene::LoadingScene>(context_, scene_manager_, game_session_data_);
+        scene_manager_.requestReplaceScene(std::move(loading_scene));
     }
 
     void GameScene::showEndScene(bool is_win)
@@ -384,40 +487,52 @@ namespace game::scene {
         scene_manager_.requestPushScene(std::move(end_scene));
     }
 
-    void GameScene::createEffect(const glm::vec2& center_pos, const std::string& tag)
+    void GameScene::registerEffectPools()
     {
-        // --- 创建游戏对象和变换组件 ---
-        auto effect_obj = std::make_unique<engine::object::GameObject>("effect_" + tag);
-        effect_obj->addComponent<engine::component::TransformComponent>(center_pos);
-
-        // --- 根据标签创建不同的精灵组件和动画--- 
-        auto animation = std::make_unique<engine::render::Animation>("effect", false);
-        if (tag == "enemy") {
-            effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/enemy-deadth.png",
-                context_.getResourceManager(),
-                engine::utils::Alignment::CENTER);
-            for (auto i = 0; i < 5; ++i) {
-                animation->addFrame({ static_cast<float>(i * 40), 0.0f, 40.0f, 41.0f }, 0.1f);
-            }
-        }
-        else if (tag == "item") {
-            effect_obj->addComponent<engine::component::SpriteComponent>("assets/textures/FX/item-feedback.png",
-                context_.getResourceManager(),
-                engine::utils::Alignment::CENTER);
-            for (auto i = 0; i < 4; ++i) {
-                animation->addFrame({ static_cast<float>(i * 32), 0.0f, 32.0f, 32.0f }, 0.1f);
+        constexpr std::size_t prewarm_count = 4;        // 同屏同类特效一般不会超过这个数量，不够时对象池会自动新建
+
+        auto& animation_library = context_.getResourceManager().getAnimationLibrary();
+        for (const auto& desc : EFFECTS) {
+            // --- 特效动画只构建一次，注册到共享动画库（已注册则直接复用） ---
+            auto key = std::string("effect_") + desc.tag;
+            const auto* animation_set = animation_library.getSet(key);
+            if (!animation_set) {
+                auto animation = std::make_unique<engine::render::Animation>("effect", false);
+                for (auto i = 0; i < desc.frame_count; ++i) {
+                    animation->addFrame({ i * desc.frame_size.x, 0.0f, desc.frame_size.x, desc.frame_size.y }, 0.1f);
+                }
+                engine::render::AnimationSet set;
+                set["effect"] = std::move(animation);
+                animation_set = animation_library.addSet(key, std::move(set));
             }
+
+            getObjectPool().registerType(key, [this, desc, animation_set]() {
+                // --- 创建游戏对象和变换组件 ---
+                auto effect_obj = std::make_unique<engine::object::GameObject>(std::string("effect_") + desc.tag);
+                effect_obj->addComponent<engine::component::TransformComponent>();
+                effect_obj->addComponent<engine::component::SpriteComponent>(desc.texture_path,
+                    context_.getResourceManager(),
+                    engine::utils::Alignment::CENTER);
+                // --- 添加动画组件（引用共享动画集），并设置为单次播放 ---
+                auto* animation_component = effect_obj->addComponent<engine::component::AnimationComponent>(animation_set);
+                animation_component->setOneShotRemoval(true);   // 播放完毕后标记删除，场景会把它放回对象池
+                return effect_obj;
+            }, prewarm_count);
         }
-        else {
+    }
+
+    void GameScene::createEffect(const glm::vec2& center_pos, const std::string& tag)
+    {
+        // --- 从对象池取出特效对象（未注册的标签会返回空） ---
+        auto effect_obj = getObjectPool().acquire("effect_" + tag);
+        if (!effect_obj) {
             spdlog::warn("未知特效类型: {}", tag);
             return;
         }
 
-        // --- 根据创建的动画，添加动画组件，并设置为单次播放 ---
-        auto* animation_component = effect_obj->addComponent<engine::component::AnimationComponent>();
-        animation_component->addAnimation(std::move(animation));
-        animation_component->setOneShotRemoval(true);
-        animation_component->playAnimation("effect");
+        // --- 重设位置并从头播放动画 ---
+        effect_obj->getComponent<engine::component::TransformComponent>()->setPosition(center_pos);
+        effect_obj->getComponent<engine::component::AnimationComponent>()->playAnimation("effect");
         safeAddGameObject(std::move(effect_obj));  // 安全添加特效对象
         spdlog::debug("创建特效: {}", tag);
     }
@@ -473,12 +588,13 @@ namespace game::scene {
 
     void GameScene::updateHealthWithUI()
     {
-        if (!player_ || !health_panel_) {
+        auto* player = getPlayer();
+        if (!player || !health_panel_) {
             spdlog::error("玩家对象或 HealthPanel 不存在，无法更新生命值UI");
             return;
         }
         // 获取当前生命值并更新游戏数据
-        auto current_health = player_->getComponent<engine::component::HealthComponent>()->getCurrentHealth();
+        auto current_health = player->getComponent<engine::component::HealthComponent>()->getCurrentHealth();
         game_session_data_->setCurrentHealth(current_health);
         auto max_health = game_session_data_->getMaxHealth();
 
@@ -498,7 +614,9 @@ namespace game::scene {
 
     void GameScene::healWithUI(int amount)
     {
-        player_->getComponent<engine::component::HealthComponent>()->heal(amount);
+        auto* player = getPlayer();
+        if (!player) return;
+        player->getComponent<engine::component::HealthComponent>()->heal(amount);
         updateHealthWithUI();                              // 更新生命值与UI
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "../../engine/scene/scene.h"
+#include "../../engine/object/object_handle.h"
 #include <memory>
 #include <glm/vec2.hpp>
 
@@ -17,6 +18,10 @@ namespace engine::ui {
     class UIPanel;
 }
 
+namespace engine::scene {
+    class LevelLoader;
+}
+
 namespace game::scene {
 
     /**
@@ -24,15 +29,24 @@ namespace game::scene {
      */
     class GameScene final : public engine::scene::Scene {
         std::shared_ptr<game::data::SessionData> game_session_data_;    ///< @brief 场景间共享数据，因此用shared_ptr
-        engine::object::GameObject* player_ = nullptr;                  ///< @brief 保存玩家对象的指针，方便访问
+        engine::object::ObjectHandle player_;                           ///< @brief 保存玩家对象的句柄（通过 getPlayer() 解析）
+        std::shared_ptr<engine::scene::LevelLoader> prepared_level_loader_; ///< @brief 已在后台解析好的关卡加载器（由 LoadingScene 传入，可为空）
 
         engine::ui::UILabel* score_label_ = nullptr;        ///< @brief 得分标签 (生命周期由UIManager管理，因此使用裸指针)
         engine::ui::UIPanel* health_panel_ = nullptr;       ///< @brief 生命值图标面板
 
     public:
+        /**
+         * @brief 构造函数
+         * @param context 引擎上下文
+         * @param scene_manager 场景管理器
+         * @param data 场景间共享数据（为空则创建默认值）
+         * @param prepared_level_loader 已解析好关卡的加载器（LoadingScene 后台加载的结果），为空则在 init 中同步加载
+         */
         GameScene(engine::core::Context& context,
             engine::scene::SceneManager& scene_manager,
-            std::shared_ptr<game::data::SessionData> data = nullptr);
+            std::shared_ptr<game::data::SessionData> data = nullptr,
+            std::shared_ptr<engine::scene::LevelLoader> prepared_level_loader = nullptr);
 
         // 覆盖场景基类的核心方法
         void init() override;
@@ -40,11 +54,16 @@ namespace game::scene {
         void render() override;
         void handleInput() override;
         void clean() override;
+        void onGameObjectSpawned(engine::object::GameObject& game_object) override;   ///< @brief 为按需生成的敌人/道具补充游戏逻辑
+        void collectResources(engine::resource::ResourceManifest& manifest) const override;  ///< @brief 声明场景（及已解析关卡）用到的资源
 
     private:
+        engine::object::GameObject* getPlayer() const;  ///< @brief 解析玩家句柄（玩家已销毁时返回空指针）
+
         [[nodiscard]] bool initLevel();               ///< @brief 初始化关卡
         [[nodiscard]] bool initPlayer();              ///< @brief 初始化玩家
-        [[nodiscard]] bool initEnemyAndItem();        ///< @brief 初始化敌人和道具
+        [[nodiscard]] bool initEnemyAndItem();        ///< @brief 初始化敌人和道具（已创建的对象）
+        bool setupEnemyOrItem(engine::object::GameObject& game_object);    ///< @brief 为敌人添加AI、为道具播放动画（其他对象不处理）
         [[nodiscard]] bool initUI();                  ///< @brief 初始化UI
 
         void handleObjectCollisions();              ///< @brief 处理游戏对象间的碰撞逻辑（从PhysicsEngine获取信息）
@@ -59,8 +78,11 @@ namespace game::scene {
         /// @brief 根据关卡名称获取对应的地图文件路径
         std::string levelNameToPath(const std::string& level_name) const { return "assets/maps/" + level_name + ".tmj"; }
 
+        /// @brief 向场景对象池注册特效类型并预先创建实例
+        void registerEffectPools();
+
         /**
-         * @brief 创建一个特效对象（一次性）。
+         * @brief 从对象池取出一个特效对象并播放（播放完毕后自动放回对象池）。
          * @param center_pos 特效中心位置
          * @param tag 特效标签（决定特效类型,例如"enemy","item"）
          */
@@ -2,6 +2,7 @@
 #include "../../engine/core/context.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/scene/scene_manager.h"
+#include "../../engine/resource/resource_manifest.h"
 #include "../../engine/ui/ui_manager.h"
 #include "../../engine/ui/ui_image.h"
 #include <spdlog/spdlog.h>
@@ -32,6 +33,10 @@ namespace game::scene {
         spdlog::trace("HelpsScene 初始化完成.");
     }
 
+    void HelpsScene::collectResources(engine::resource::ResourceManifest& manifest) const {
+        manifest.addTexture("assets/textures/UI/instructions.png");
+    }
+
     void HelpsScene::handleInput() {
         if (!is_initialized_) return;
 
@@ -0,0 +1,98 @@
+#include "loading_scene.h"
+#include "game_scene.h"
+#include "../data/session_data.h"
+#include "../../engine/core/context.h"
+#include "../../engine/core/game_state.h"
+#include "../../engine/resource/resource_manager.h"
+#include "../../engine/resource/resource_manifest.h"
+#include "../../engine/scene/level_load_task.h"
+#include "../../engine/scene/level_loader.h"
+#include "../../engine/scene/scene_manager.h"
+#include "../../engine/ui/ui_manager.h"
+#include "../../engine/ui/ui_label.h"
+#include <spdlog/spdlog.h>
+#include <string>
+
+namespace game::scene {
+
+    namespace {
+        constexpr std::uint64_t UPLOAD_BUDGET_NS = 4'000'000;  ///< 每帧上传纹理的时间预算（4毫秒）
+    }
+
+    LoadingScene::LoadingScene(engine::core::Context& context,
+        engine::scene::SceneManager& scene_manager,
+        std::shared_ptr<game::data::SessionData> session_data)
+        : engine::scene::Scene("LoadingScene", context, scene_manager),
+        session_data_(std::move(session_data)) {
+        if (!session_data_) {
+            spdlog::error("错误：加载场景收到了空的游戏数据！");
+        }
+        spdlog::trace("LoadingScene 创建.");
+    }
+
+    LoadingScene::~LoadingScene() = default;
+
+    void LoadingScene::init() {
+        if (is_initialized_) {
+            return;
+        }
+
+        // 启动后台加载任务
+        if (session_data_) {
+            load_task_ = std::make_unique<engine::scene::LevelLoadTask>(session_data_->getMapPath(),
+                scene_manager_.getLevelStreamingSettings());
+        }
+
+        // 创建进度标签（屏幕中央）
+        auto window_size = context_.getGameState().getLogicalSize();
+        if (!ui_manager_->init(window_size)) {
+            spdlog::error("错误：加载场景的 UI 管理器初始化失败！");
+        }
+        else {
+            auto progress_label = std::make_unique<engine::ui::UILabel>(context_.getTextRenderer(),
+                "Loading... 0%",
+                "assets/fonts/VonwaonBitmap-16px.ttf",
+                16);
+            progress_label_ = progress_label.get();
+            progress_label_->setPosition((window_size - progress_label_->getSize()) / 2.0f);
+            ui_manager_->addElement(std::move(progress_label));
+        }
+
+        Scene::init();
+        spdlog::trace("LoadingScene 初始化完成.");
+    }
+
+    void LoadingScene::collectResources(engine::resource::ResourceManifest& manifest) const {
+        manifest.addFont("assets/fonts/VonwaonBitmap-16px.ttf", 16);
+    }
+
+    void LoadingScene::update(float delta_time) {
+        Scene::update(delta_time);
+        if (!load_task_) return;        // 已请求切换到游戏场景
+        updateProgressLabel();
+
+        // 等待后台解析和解码完成，然后每帧在时间预算内上传纹理
+        if (!load_task_->isLoaded()) return;
+        if (load_task_->isSuccessful() && !load_task_->upload(context_.getResourceManager(), UPLOAD_BUDGET_NS)) return;
+
+        // 解析失败时不传入加载器，由 GameScene 同步加载并报告错误
+        std::shared_ptr<engine::scene::LevelLoader> level_loader;
+        if (load_task_->isSuccessful()) {
+            level_loader = load_task_->takeLevelLoader();
+        }
+        else {
+            spdlog::error("关卡 '{}' 后台加载失败。", session_data_->getMapPath());
+        }
+        load_task_.reset();
+        scene_manager_.requestReplaceScene(std::make_unique<GameScene>(context_, scene_manager_, session_data_, std::move(level_loader)));
+    }
+
+    void LoadingScene::updateProgressLabel() {
+        if (!progress_label_) return;
+        auto percent = static_cast<int>(load_task_->getProgress() * 100.0f);
+        if (percent == displayed_percent_) return;
+        displayed_percent_ = percent;
+        progress_label_->setText("Loading... " + std::to_string(percent) + "%");
+    }
+
+} // namespace game::scene
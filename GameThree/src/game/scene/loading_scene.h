@@ -0,0 +1,64 @@
+#pragma once
+#include "../../engine/scene/scene.h"
+#include <memory>
+
+// 前置声明
+namespace engine::core {
+    class Context;
+}
+namespace engine::scene {
+    class SceneManager;
+    class LevelLoadTask;
+}
+namespace engine::ui {
+    class UILabel;
+}
+namespace game::data {
+    class SessionData;
+}
+
+namespace game::scene {
+
+    /**
+     * @class LoadingScene
+     * @brief 关卡切换时显示的加载场景。
+     *
+     * 初始化时启动后台关卡加载任务（解析关卡、解码图片和音效），期间显示加载进度；
+     * 后台完成后每帧在时间预算内上传纹理，全部完成后替换为已解析好关卡的 GameScene。
+     */
+    class LoadingScene final : public engine::scene::Scene {
+    private:
+        std::shared_ptr<game::data::SessionData> session_data_;         ///< @brief 场景间共享数据（提供要加载的地图路径）
+        std::unique_ptr<engine::scene::LevelLoadTask> load_task_;       ///< @brief 后台加载任务（切换到游戏场景后为空）
+        engine::ui::UILabel* progress_label_ = nullptr;                 ///< @brief 进度标签 (生命周期由UIManager管理)
+        int displayed_percent_ = -1;                                    ///< @brief 标签当前显示的百分比（变化时才更新文本）
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param context 引擎上下文
+         * @param scene_manager 场景管理器
+         * @param session_data 指向游戏数据状态的共享指针
+         */
+        LoadingScene(engine::core::Context& context,
+            engine::scene::SceneManager& scene_manager,
+            std::shared_ptr<game::data::SessionData> session_data);
+
+        ~LoadingScene() override;   ///< @brief 定义在cpp中（LevelLoadTask 在那里是完整类型）
+
+        // --- 核心循环方法 ---
+        void init() override;
+        void collectResources(engine::resource::ResourceManifest& manifest) const override;  ///< @brief 声明场景用到的资源
+        void update(float delta_time) override;
+
+        // 禁止拷贝和移动
+        LoadingScene(const LoadingScene&) = delete;
+        LoadingScene& operator=(const LoadingScene&) = delete;
+        LoadingScene(LoadingScene&&) = delete;
+        LoadingScene& operator=(LoadingScene&&) = delete;
+
+    private:
+        void updateProgressLabel();     ///< @brief 根据加载进度更新标签文本
+    };
+
+} // namespace game::scene
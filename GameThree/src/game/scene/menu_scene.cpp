@@ -4,6 +4,7 @@
 #include "../../engine/core/game_state.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/scene/scene_manager.h"
+#include "../../engine/resource/resource_manifest.h"
 #include "../../engine/ui/ui_manager.h"
 #include "../../engine/ui/ui_panel.h"
 #include "../../engine/ui/ui_label.h"
@@ -36,6 +37,14 @@ namespace game::scene {
         spdlog::trace("menuScene 初始化完成");
     }
 
+    void MenuScene::collectResources(engine::resource::ResourceManifest& manifest) const {
+        manifest.addFont("assets/fonts/VonwaonBitmap-16px.ttf", 32);
+        for (const std::string name : { "Resume", "Save", "Back", "Quit" }) {
+            const auto prefix = "assets/textures/UI/buttons/" + name;
+            engine::ui::UIButton::collectResources(manifest, prefix + "1.png", prefix + "2.png", prefix + "3.png");
+        }
+    }
+
     void MenuScene::createUI() {
 
         auto window_size = context_.getGameState().getLogicalSize();
@@ -38,6 +38,7 @@ namespace game::scene {
 
         // --- 核心循环方法 ---
         void init() override;
+        void collectResources(engine::resource::ResourceManifest& manifest) const override;  ///< @brief 声明场景用到的资源
         void handleInput() override;
 
     private:
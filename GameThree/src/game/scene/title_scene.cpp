@@ -2,6 +2,7 @@
 #include "../../engine/core/context.h"
 #include "../../engine/core/game_state.h"
 #include "../../engine/resource/resource_manager.h"
+#include "../../engine/resource/resource_manifest.h"
 #include "../../engine/render/camera.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/ui/ui_manager.h"
@@ -14,7 +15,7 @@
 #include "../../engine/scene/scene_manager.h"
 #include "../../engine/utils/math.h"
 #include "../data/session_data.h"
-#include "game_scene.h"
+#include "loading_scene.h"
 #include "helps_scene.h"
 #include <spdlog/spdlog.h>
 
@@ -58,6 +59,17 @@ namespace game::scene {
         spdlog::trace("TitleScene 初始化完成.");
     }
 
+    // 声明场景资源（背景关卡的资源由 LevelLoader 在 init 中预加载）
+    void TitleScene::collectResources(engine::resource::ResourceManifest& manifest) const {
+        manifest.addMusic("assets/audio/platformer_level03_loop.ogg");
+        manifest.addTexture("assets/textures/UI/title-screen.png");
+        manifest.addFont("assets/fonts/VonwaonBitmap-16px.ttf", 16);
+        for (const std::string name : { "Start", "Load", "Helps", "Quit" }) {
+            const auto prefix = "assets/textures/UI/buttons/" + name;
+            engine::ui::UIButton::collectResources(manifest, prefix + "1.png", prefix + "2.png", prefix + "3.png");
+        }
+    }
+
     // 创建 UI 界面元素
     void TitleScene::createUI() {
         spdlog::trace("创建 TitleScene UI...");
@@ -183,7 +195,7 @@ namespace game::scene {
         if (session_data_) {
             session_data_->reset();
         }
-        scene_manager_.requestReplaceScene(std::make_unique<GameScene>(context_, scene_manager_, session_data_));
+        scene_manager_.requestReplaceScene(std::make_unique<LoadingScene>(context_, scene_manager_, session_data_));
     }
 
     void TitleScene::onLoadGameClick() {
@@ -195,7 +207,7 @@ namespace game::scene {
 
         if (session_data_->loadFromFile("assets/save.json")) {
             spdlog::debug("保存文件加载成功。开始游戏...");
-            scene_manager_.requestReplaceScene(std::make_unique<GameScene>(context_, scene_manager_, session_data_));
+            scene_manager_.requestReplaceScene(std::make_unique<LoadingScene>(context_, scene_manager_, session_data_));
         }
         else {
             spdlog::warn("加载保存文件失败。");
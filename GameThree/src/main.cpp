@@ -1,8 +1,21 @@
 #include "engine/core/game_app.h"
+#include "engine/scene/level_loader.h"
 #include <spdlog/spdlog.h>
+#include <string_view>
 
-int main(int /* argc */, char* /* argv */[]) {
+int main(int argc, char* argv[]) {
     spdlog::set_level(spdlog::level::debug);
+
+    // 烘焙模式：GameThree --cook <地图.tmj> ... 将地图烘焙为旁边的 .g3lvl 文件后退出，不启动游戏
+    if (argc > 1 && std::string_view(argv[1]) == "--cook") {
+        bool success = argc > 2;
+        for (int i = 2; i < argc; ++i) {
+            engine::scene::LevelLoader level_loader;
+            success = level_loader.cookLevel(argv[i]) && success;
+        }
+        return success ? 0 : 1;
+    }
+
     engine::core::GameApp app;
     app.run();
     return 0;